@@ -223,6 +223,68 @@ typedef int16_t logger_id_t;
 /** Logger rate limit type. */
 typedef uint16_t logger_rate_limit_t;
 
+/** Logger call site limit kinds */
+typedef enum logger_site_kind_e {
+  LOGGER_SITE_NONE     = 0,    /**< Print every message. */
+  LOGGER_SITE_EVERY_N  = 1,    /**< Print every n-th message. */
+  LOGGER_SITE_EVERY_MS = 2,    /**< Print one message per interval in milliseconds. */
+  LOGGER_SITE_SAMPLE   = 3     /**< Print random sample of messages. */
+} logger_site_kind_t;
+
+/** Logger structured field types */
+typedef enum logger_kv_type_e {
+  LOGGER_KV_TYPE_U64  = 0,     /**< Unsigned integer. */
+  LOGGER_KV_TYPE_I64  = 1,     /**< Signed integer. */
+  LOGGER_KV_TYPE_F64  = 2,     /**< Floating point number. */
+  LOGGER_KV_TYPE_BOOL = 3,     /**< Boolean. */
+  LOGGER_KV_TYPE_STR  = 4      /**< String. */
+} logger_kv_type_t;
+
+/** Logger structured field, use the LOGGER_KV_... macros to create fields */
+typedef struct logger_kv_s {
+  const char       *key;       /**< Name of field. */
+  logger_kv_type_t type;       /**< Type of value. */
+  union {
+    uint64_t       u64;        /**< Value of \c LOGGER_KV_TYPE_U64 field. */
+    int64_t        i64;        /**< Value of \c LOGGER_KV_TYPE_I64 field. */
+    double         f64;        /**< Value of \c LOGGER_KV_TYPE_F64 field. */
+    logger_bool_t  b;          /**< Value of \c LOGGER_KV_TYPE_BOOL field. */
+    const char     *str;       /**< Value of \c LOGGER_KV_TYPE_STR field. */
+  } value;                     /**< Value of field. */
+} logger_kv_t;
+
+/** Logger rendering of structured messages */
+typedef enum logger_kv_format_e {
+  LOGGER_KV_FORMAT_TEXT   = 0, /**< message key=value */
+  LOGGER_KV_FORMAT_LOGFMT = 1, /**< msg=message key=value */
+  LOGGER_KV_FORMAT_JSON   = 2, /**< {"msg":"message","key":value} */
+  LOGGER_KV_FORMAT_MAX         /**< Last entry, always! */
+} logger_kv_format_t;
+
+/** Logger output formats */
+typedef enum logger_output_format_e {
+  LOGGER_OUTPUT_FORMAT_TEXT   = 0, /**< Prefix and message, default. */
+  LOGGER_OUTPUT_FORMAT_JSON   = 1, /**< One JSON object per line. */
+  LOGGER_OUTPUT_FORMAT_BINARY = 2, /**< Flight recorder records, streams only. */
+  LOGGER_OUTPUT_FORMAT_RECORD = 3, /**< No line, record only, drivers only. */
+  LOGGER_OUTPUT_FORMAT_MAX         /**< Last entry, always! */
+} logger_output_format_t;
+
+/** Unsigned integer field of logger_kv() */
+#define LOGGER_KV_U64(__key, __value)  { (__key), LOGGER_KV_TYPE_U64,  { .u64 = (uint64_t)(__value) } }
+
+/** Signed integer field of logger_kv() */
+#define LOGGER_KV_I64(__key, __value)  { (__key), LOGGER_KV_TYPE_I64,  { .i64 = (int64_t)(__value) } }
+
+/** Floating point field of logger_kv() */
+#define LOGGER_KV_F64(__key, __value)  { (__key), LOGGER_KV_TYPE_F64,  { .f64 = (double)(__value) } }
+
+/** Boolean field of logger_kv() */
+#define LOGGER_KV_BOOL(__key, __value) { (__key), LOGGER_KV_TYPE_BOOL, { .b = (__value) ? logger_true : logger_false } }
+
+/** String field of logger_kv() */
+#define LOGGER_KV_STR(__key, __value)  { (__key), LOGGER_KV_TYPE_STR,  { .str = (__value) } }
+
 
 /** Logger function return codes */
 typedef enum logger_return_e {
@@ -245,7 +307,12 @@ typedef enum logger_return_e {
   LOGGER_ERR_FILE_INVALID      = -16,   /**< File string is invalid. */
   LOGGER_ERR_STRING_TOO_LONG   = -17,   /**< Given string is too long. */
   LOGGER_ERR_STRING_INVALID    = -18,   /**< Given string is invalid. */
-  LOGGER_ERR_RATE_LIMIT        = -19    /**< Rate limit reached, message not printed. */
+  LOGGER_ERR_RATE_LIMIT        = -19,   /**< Rate limit reached, message not printed. */
+  LOGGER_ERR_DATA_INVALID      = -20,   /**< Given data is invalid or corrupted. */
+  LOGGER_ERR_SIZE_INVALID      = -21,   /**< Given size is invalid. */
+  LOGGER_ERR_REENTRANT         = -22,   /**< Called by an output while it prints a message. */
+  LOGGER_ERR_NOT_STARTED       = -23,   /**< No message begun by this thread. */
+  LOGGER_ERR_NOT_SUPPORTED     = -24    /**< Feature is not part of this build. */
 } logger_return_t;
 
 
@@ -302,9 +369,74 @@ typedef enum logger_text_fg_e {
 } logger_text_fg_t;
 
 
+/** Logger message counters */
+typedef struct logger_stats_s {
+  uint64_t accepted;          /**< Messages passing the ID and level check. */
+  uint64_t filtered;          /**< Messages dropped by the ID and level check. */
+  uint64_t emitted;           /**< Messages passed to the outputs. */
+  uint64_t rate_limited;      /**< Messages dropped by a rate or call site limit. */
+  uint64_t repeat_suppressed; /**< Messages dropped as repeat of a previous message. */
+  uint64_t truncated;         /**< Messages shortened to fit the message storage. */
+} logger_stats_t;
+
+/** Logger output counters */
+typedef struct logger_output_stats_s {
+  uint64_t lines;             /**< Lines written. */
+  uint64_t bytes;             /**< Bytes written. */
+  uint64_t errors;            /**< Lines not written completely. */
+} logger_output_stats_t;
+
+/** Logger counters of background rotation and compression of managed files */
+typedef struct logger_file_queue_stats_s {
+  uint64_t queued;            /**< Jobs waiting for the background thread. */
+  uint64_t peak;              /**< Most jobs waiting at the same time. */
+  uint64_t dropped;           /**< Jobs not queued because the queue was full. */
+} logger_file_queue_stats_t;
+
+/** Logger latency summary, all times in nanoseconds */
+typedef struct logger_latency_s {
+  uint64_t count;             /**< Measured calls. */
+  uint64_t min;               /**< Shortest call. */
+  uint64_t mean;              /**< Average call. */
+  uint64_t p50;               /**< Median. */
+  uint64_t p90;               /**< 90th percentile. */
+  uint64_t p99;               /**< 99th percentile. */
+  uint64_t p999;              /**< 99.9th percentile. */
+  uint64_t max;               /**< Longest call. */
+} logger_latency_t;
+
 /** Logger output function type */
 typedef void (*logger_output_function_t)(const char *);
 
+/** Logger message passed to output drivers */
+typedef struct logger_record_s {
+  logger_id_t    id;             /**< ID outputting this message. */
+  logger_level_t level;          /**< Level of this message. */
+  int64_t        time;           /**< Time of this message in seconds since the epoch. */
+  const char     *file;          /**< File of call, NULL for messages of the logger itself. */
+  const char     *function;      /**< Function of call, NULL for messages of the logger itself. */
+  uint32_t       line;           /**< Line of call, 0 for messages of the logger itself. */
+  const char     *message;       /**< Formatted message without prefix and '\n', not terminated. */
+  size_t         message_length; /**< Length of message. */
+} logger_record_t;
+
+/** Logger output record function type */
+typedef void (*logger_output_record_function_t)(const logger_record_t *);
+
+/** Part of a text line passed to output drivers */
+typedef struct logger_iovec_s {
+  const char *base;              /**< Start of part, not terminated. */
+  size_t     length;             /**< Length of part. */
+} logger_iovec_t;
+
+/** Logger output driver */
+typedef struct logger_output_driver_s {
+  void (*write)(void *context, const logger_record_t *record, const char *line, size_t length);         /**< Write a whole line, mandatory. */
+  void (*writev)(void *context, const logger_record_t *record, const logger_iovec_t *parts, size_t count); /**< Write a text line in parts without joining them first, optional. */
+  void (*flush)(void *context);                                                                        /**< Flush written lines, optional. */
+  void (*close)(void *context);                                                                        /**< Output is deregistered for the last time, optional. */
+} logger_output_driver_t;
+
 
 #ifdef LOGGER_ENABLE
 logger_version_t logger_version(void);
@@ -313,10 +445,23 @@ logger_bool_t logger_is_initialized(void);
 logger_return_t logger_enable(void);
 logger_return_t logger_disable(void);
 logger_bool_t logger_is_enabled(void);
+logger_return_t logger_config_begin(void);
+logger_return_t logger_config_commit(void);
 logger_return_t logger_prefix_set(const logger_prefix_t prefix);
 logger_prefix_t logger_prefix_get(void);
 logger_return_t logger_rate_limit_set(const logger_rate_limit_t limit);
 logger_rate_limit_t logger_rate_limit_get(void);
+logger_return_t logger_repeat_window_set(const uint32_t window);
+uint32_t logger_repeat_window_get(void);
+logger_return_t logger_repeat_flush_interval_set(const uint32_t interval);
+uint32_t logger_repeat_flush_interval_get(void);
+logger_return_t logger_repeat_flush(void);
+logger_return_t logger_rate_limit_exempt_set(const logger_level_t level);
+logger_level_t logger_rate_limit_exempt_get(void);
+logger_return_t logger_level_rate_limit_set(const logger_level_t      level,
+                                            const logger_rate_limit_t rate,
+                                            const logger_rate_limit_t burst);
+logger_rate_limit_t logger_level_rate_limit_get(const logger_level_t level);
 logger_return_t logger_output_register(FILE *stream);
 logger_return_t logger_output_deregister(FILE *stream);
 logger_bool_t logger_output_is_registered(FILE *stream);
@@ -329,7 +474,15 @@ logger_level_t logger_output_level_mask_get(FILE *stream);
 logger_return_t logger_output_color_enable(FILE *stream);
 logger_return_t logger_output_color_disable(FILE *stream);
 logger_bool_t logger_output_color_is_enabled(FILE *stream);
+logger_return_t logger_output_kv_format_set(FILE                     *stream,
+                                            const logger_kv_format_t format);
+logger_kv_format_t logger_output_kv_format_get(FILE *stream);
+logger_return_t logger_output_format_set(FILE                         *stream,
+                                         const logger_output_format_t format);
+logger_output_format_t logger_output_format_get(FILE *stream);
 logger_return_t logger_output_flush(void);
+logger_return_t logger_output_stats_get(FILE                  *stream,
+                                        logger_output_stats_t *stats);
 logger_return_t logger_output_function_register(logger_output_function_t function);
 logger_return_t logger_output_function_deregister(logger_output_function_t function);
 logger_bool_t logger_output_function_is_registered(logger_output_function_t function);
@@ -342,6 +495,80 @@ logger_level_t logger_output_function_level_mask_get(logger_output_function_t fu
 logger_return_t logger_output_function_color_enable(logger_output_function_t function);
 logger_return_t logger_output_function_color_disable(logger_output_function_t function);
 logger_bool_t logger_output_function_color_is_enabled(logger_output_function_t function);
+logger_return_t logger_output_function_kv_format_set(logger_output_function_t function,
+                                                     const logger_kv_format_t format);
+logger_kv_format_t logger_output_function_kv_format_get(logger_output_function_t function);
+logger_return_t logger_output_function_stats_get(logger_output_function_t function,
+                                                 logger_output_stats_t    *stats);
+logger_return_t logger_output_function_format_set(logger_output_function_t     function,
+                                                  const logger_output_format_t format);
+logger_output_format_t logger_output_function_format_get(logger_output_function_t function);
+logger_return_t logger_output_driver_register(const logger_output_driver_t *driver,
+                                              void                         *context);
+logger_return_t logger_output_driver_deregister(const logger_output_driver_t *driver,
+                                                void                         *context);
+logger_bool_t logger_output_driver_is_registered(const logger_output_driver_t *driver,
+                                                 void                         *context);
+logger_return_t logger_output_driver_level_set(const logger_output_driver_t *driver,
+                                               void                         *context,
+                                               const logger_level_t         level);
+logger_return_t logger_output_driver_format_set(const logger_output_driver_t *driver,
+                                                void                         *context,
+                                                const logger_output_format_t format);
+logger_return_t logger_output_driver_stats_get(const logger_output_driver_t *driver,
+                                               void                         *context,
+                                               logger_output_stats_t        *stats);
+logger_return_t logger_output_record_register(logger_output_record_function_t function);
+logger_return_t logger_output_record_deregister(logger_output_record_function_t function);
+logger_bool_t logger_output_record_is_registered(logger_output_record_function_t function);
+logger_return_t logger_output_record_level_set(logger_output_record_function_t function,
+                                               const logger_level_t            level);
+FILE *logger_output_file_open(const char     *path,
+                              const size_t   rotate_bytes,
+                              const uint32_t rotate_interval,
+                              const uint16_t keep);
+logger_return_t logger_output_file_close(FILE *stream);
+logger_bool_t logger_output_file_is_open(FILE *stream);
+logger_return_t logger_output_file_rotate(FILE *stream);
+logger_return_t logger_output_file_compression_enable(FILE *stream);
+logger_return_t logger_output_file_compression_disable(FILE *stream);
+logger_bool_t logger_output_file_compression_is_enabled(FILE *stream);
+logger_return_t logger_output_file_queue_stats_get(logger_file_queue_stats_t *stats);
+logger_return_t logger_decompress(FILE *source, FILE *destination);
+logger_return_t logger_output_recorder_register(void);
+logger_return_t logger_output_recorder_deregister(void);
+logger_bool_t logger_output_recorder_is_registered(void);
+logger_return_t logger_output_recorder_level_set(const logger_level_t level);
+logger_level_t logger_output_recorder_level_get(void);
+logger_return_t logger_output_recorder_level_mask_set(const logger_level_t level);
+logger_level_t logger_output_recorder_level_mask_get(void);
+logger_return_t logger_output_recorder_dump(FILE *stream);
+logger_return_t logger_output_recorder_crash_dump_enable(const char *path);
+logger_return_t logger_output_recorder_crash_dump_disable(void);
+logger_return_t logger_output_recorder_file_open(const char *path);
+logger_return_t logger_output_recorder_file_close(void);
+logger_return_t logger_output_recorder_recover(const char *path, FILE *stream);
+logger_return_t logger_stats_get(const logger_id_t    id,
+                                 const logger_level_t level,
+                                 logger_stats_t       *stats);
+logger_return_t logger_stats_reset(void);
+logger_return_t logger_latency_get(logger_latency_t *latency);
+logger_return_t logger_output_latency_get(FILE             *stream,
+                                          logger_latency_t *latency);
+logger_return_t logger_output_function_latency_get(logger_output_function_t function,
+                                                   logger_latency_t         *latency);
+logger_return_t logger_output_driver_latency_get(const logger_output_driver_t *driver,
+                                                 void                         *context,
+                                                 logger_latency_t             *latency);
+logger_return_t logger_latency_dump(const logger_level_t level);
+logger_return_t logger_latency_reset(void);
+logger_return_t logger_profile_enable(void);
+logger_return_t logger_profile_disable(void);
+logger_bool_t logger_profile_is_enabled(void);
+logger_return_t logger_profile_dump(const logger_level_t level,
+                                    const uint16_t       count);
+logger_return_t logger_profile_dump_at_exit(const logger_level_t level);
+logger_return_t logger_profile_reset(void);
 logger_id_t logger_id_request(const char *name);
 logger_return_t logger_id_release(const logger_id_t id);
 logger_return_t logger_id_enable(const logger_id_t id);
@@ -355,6 +582,23 @@ logger_level_t logger_id_level_get(const logger_id_t id);
 logger_return_t logger_id_level_mask_set(const logger_id_t    id,
                                          const logger_level_t level);
 logger_level_t logger_id_level_mask_get(const logger_id_t id);
+logger_return_t logger_id_level_inherit(const logger_id_t id);
+logger_return_t logger_id_level_spec_set(const char *spec);
+logger_return_t logger_thread_level_override(const logger_id_t    id,
+                                             const logger_level_t level);
+logger_return_t logger_thread_level_override_clear(void);
+logger_return_t logger_id_lazy_enable(const logger_id_t    id,
+                                      const uint16_t       count,
+                                      const logger_level_t trigger);
+logger_return_t logger_id_lazy_disable(const logger_id_t id);
+logger_bool_t logger_id_lazy_is_enabled(const logger_id_t id);
+logger_return_t logger_id_line_buffer_enable(const logger_id_t id);
+logger_return_t logger_id_line_buffer_disable(const logger_id_t id);
+logger_bool_t logger_id_line_buffer_is_enabled(const logger_id_t id);
+logger_return_t logger_id_rate_limit_set(const logger_id_t         id,
+                                         const logger_rate_limit_t rate,
+                                         const logger_rate_limit_t burst);
+logger_rate_limit_t logger_id_rate_limit_get(const logger_id_t id);
 logger_return_t logger_id_prefix_set(const logger_id_t     id,
                                      const logger_prefix_t prefix);
 logger_prefix_t logger_id_prefix_get(const logger_id_t id);
@@ -440,6 +684,31 @@ logger_return_t logger_implementation_va(logger_id_t    id,
                                          uint32_t       line,
                                          const char     *format,
                                          va_list        argp);
+logger_return_t logger_implementation_site(logger_id_t        id,
+                                           logger_level_t     level,
+                                           const char         *file,
+                                           const char         *function,
+                                           uint32_t           line,
+                                           logger_site_kind_t kind,
+                                           uint32_t           value,
+                                           const char         *format,
+                                           ...) LOGGER_FORMAT_PRINTF(8, 9);
+logger_return_t logger_msg_begin_implementation(logger_id_t    id,
+                                                logger_level_t level,
+                                                const char     *file,
+                                                const char     *function,
+                                                uint32_t       line);
+logger_return_t logger_msg_appendf(const char *format,
+                                   ...) LOGGER_FORMAT_PRINTF(1, 2);
+logger_return_t logger_msg_commit(void);
+logger_return_t logger_kv_implementation(logger_id_t       id,
+                                         logger_level_t    level,
+                                         const char        *file,
+                                         const char        *function,
+                                         uint32_t          line,
+                                         const char        *message,
+                                         const logger_kv_t *fields,
+                                         size_t            count);
 
 /** Macro to call the real logger function logger() with the information about the current position in code (file, function and line) */
 #define logger(__id, __level, ...)                    logger_implementation(__id, __level, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
@@ -447,6 +716,45 @@ logger_return_t logger_implementation_va(logger_id_t    id,
 /** Macro to call the real logger function logger_va() with the information about the current position in code (file, function and line) */
 #define logger_va(__id, __level, __format, __argp)    logger_implementation_va(__id, __level, __FILE__, __FUNCTION__, __LINE__, __format, __argp)
 
+/** Macro to print only every n-th message of this call site */
+#define logger_every_n(__n, __id, __level, ...)       logger_implementation_site(__id, __level, __FILE__, __FUNCTION__, __LINE__, LOGGER_SITE_EVERY_N, __n, __VA_ARGS__)
+
+/** Macro to print at most one message of this call site every given milliseconds */
+#define logger_every_ms(__ms, __id, __level, ...)     logger_implementation_site(__id, __level, __FILE__, __FUNCTION__, __LINE__, LOGGER_SITE_EVERY_MS, __ms, __VA_ARGS__)
+
+/** Scale a sample probability to \c UINT32_MAX, values outside of 0.0 to 1.0 are clamped */
+LOGGER_INLINE uint32_t logger_sample_threshold(const double p)
+{
+  if (p >= 1.0) {
+    return(UINT32_MAX);
+  }
+
+  /* also catches NaN */
+  if (!(p > 0.0)) {
+    return(0);
+  }
+
+  return((uint32_t)(p * 4294967295.0));
+}
+
+/** Macro to print messages of this call site with probability __p (0.0 to 1.0) */
+#define logger_sample(__p, __id, __level, ...)        logger_implementation_site(__id, __level, __FILE__, __FUNCTION__, __LINE__, LOGGER_SITE_SAMPLE, logger_sample_threshold(__p), __VA_ARGS__)
+
+/** Macro to begin a message built by logger_msg_appendf() with the information about the current position in code */
+#define logger_msg_begin(__id, __level)               logger_msg_begin_implementation(__id, __level, __FILE__, __FUNCTION__, __LINE__)
+
+/** Macro to print a message with up to 31 structured fields created by the LOGGER_KV_... macros, fields may be left out */
+#define logger_kv(__id, __level, ...)                 LOGGER_KV_SELECT(__VA_ARGS__, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_FIELDS, LOGGER_KV_PLAIN, LOGGER_KV_UNUSED)(__id, __level, __VA_ARGS__)
+
+/** Select the macro for a message with or without fields, C99 doesn't allow empty variable arguments */
+#define LOGGER_KV_SELECT(__1, __2, __3, __4, __5, __6, __7, __8, __9, __10, __11, __12, __13, __14, __15, __16, __17, __18, __19, __20, __21, __22, __23, __24, __25, __26, __27, __28, __29, __30, __31, __32, __name, ...) __name
+
+/** Print a message without fields */
+#define LOGGER_KV_PLAIN(__id, __level, __message)      logger_kv_implementation(__id, __level, __FILE__, __FUNCTION__, __LINE__, __message, NULL, 0)
+
+/** Print a message with fields */
+#define LOGGER_KV_FIELDS(__id, __level, __message, ...) logger_kv_implementation(__id, __level, __FILE__, __FUNCTION__, __LINE__, __message, (const logger_kv_t[]){ __VA_ARGS__ }, sizeof((const logger_kv_t[]){ __VA_ARGS__ }) / sizeof(logger_kv_t))
+
 
 /* helper functions */
 size_t logger_level_to_index(const logger_level_t level);
@@ -532,16 +840,33 @@ LOGGER_INLINE uint16_t logger_disabled_zero(void)
 }
 
 
+LOGGER_INLINE FILE *logger_disabled_stream(void)
+{
+  return(NULL);
+}
+
+
 #define logger_version()                                                     logger_disabled_version()
 #define logger_init()                                                        logger_disabled_ok()
 #define logger_is_initialized()                                              logger_disabled_false()
 #define logger_enable()                                                      logger_disabled_ok()
 #define logger_disable()                                                     logger_disabled_ok()
 #define logger_is_enabled(__id)                                              logger_disabled_false()
+#define logger_config_begin()                                                logger_disabled_ok()
+#define logger_config_commit()                                               logger_disabled_ok()
 #define logger_prefix_set(__prefix)                                          logger_disabled_ok()
 #define logger_prefix_get()                                                  logger_disabled_unset()
 #define logger_rate_limit_set(__limit)                                       logger_disabled_ok()
 #define logger_rate_limit_get()                                              logger_disabled_zero()
+#define logger_repeat_window_set(__window)                                   logger_disabled_ok()
+#define logger_repeat_window_get()                                           logger_disabled_zero()
+#define logger_repeat_flush_interval_set(__interval)                         logger_disabled_ok()
+#define logger_repeat_flush_interval_get()                                   logger_disabled_zero()
+#define logger_repeat_flush()                                                logger_disabled_ok()
+#define logger_rate_limit_exempt_set(__level)                                logger_disabled_ok()
+#define logger_rate_limit_exempt_get()                                       logger_disabled_unknown()
+#define logger_level_rate_limit_set(__level, __rate, __burst)                logger_disabled_ok()
+#define logger_level_rate_limit_get(__level)                                 logger_disabled_zero()
 #define logger_output_register(__stream)                                     logger_disabled_ok()
 #define logger_output_deregister(__stream)                                   logger_disabled_ok()
 #define logger_output_is_registered(__stream)                                logger_disabled_false()
@@ -552,7 +877,12 @@ LOGGER_INLINE uint16_t logger_disabled_zero(void)
 #define logger_output_color_enable(__stream)                                 logger_disabled_ok()
 #define logger_output_color_disable(__stream)                                logger_disabled_ok()
 #define logger_output_color_is_enabled(__stream)                             logger_disabled_false()
+#define logger_output_kv_format_set(__stream, __format)                      logger_disabled_ok()
+#define logger_output_kv_format_get(__stream)                                logger_disabled_zero()
+#define logger_output_format_set(__stream, __format)                         logger_disabled_ok()
+#define logger_output_format_get(__stream)                                   logger_disabled_zero()
 #define logger_output_flush()                                                logger_disabled_ok()
+#define logger_output_stats_get(__stream, __stats)                           logger_disabled_ok()
 #define logger_output_function_register(__function)                          logger_disabled_ok()
 #define logger_output_function_deregister(__function)                        logger_disabled_ok()
 #define logger_output_function_is_registered(__function)                     logger_disabled_false()
@@ -563,6 +893,57 @@ LOGGER_INLINE uint16_t logger_disabled_zero(void)
 #define logger_output_function_color_enable(__function)                      logger_disabled_ok()
 #define logger_output_function_color_disable(__function)                     logger_disabled_ok()
 #define logger_output_function_color_is_enabled(__function)                  logger_disabled_false()
+#define logger_output_function_kv_format_set(__function, __format)           logger_disabled_ok()
+#define logger_output_function_kv_format_get(__function)                     logger_disabled_zero()
+#define logger_output_function_stats_get(__function, __stats)                logger_disabled_ok()
+#define logger_output_function_format_set(__function, __format)              logger_disabled_ok()
+#define logger_output_function_format_get(__function)                        logger_disabled_zero()
+#define logger_output_driver_register(__driver, __context)                   logger_disabled_ok()
+#define logger_output_driver_deregister(__driver, __context)                 logger_disabled_ok()
+#define logger_output_driver_is_registered(__driver, __context)              logger_disabled_false()
+#define logger_output_driver_level_set(__driver, __context, __level)         logger_disabled_ok()
+#define logger_output_driver_format_set(__driver, __context, __format)       logger_disabled_ok()
+#define logger_output_driver_stats_get(__driver, __context, __stats)         logger_disabled_ok()
+#define logger_output_record_register(__function)                            logger_disabled_ok()
+#define logger_output_record_deregister(__function)                          logger_disabled_ok()
+#define logger_output_record_is_registered(__function)                       logger_disabled_false()
+#define logger_output_record_level_set(__function, __level)                  logger_disabled_ok()
+#define logger_output_file_open(__path, __bytes, __interval, __keep)         logger_disabled_stream()
+#define logger_output_file_close(__stream)                                   logger_disabled_ok()
+#define logger_output_file_is_open(__stream)                                 logger_disabled_false()
+#define logger_output_file_rotate(__stream)                                  logger_disabled_ok()
+#define logger_output_file_compression_enable(__stream)                      logger_disabled_ok()
+#define logger_output_file_compression_disable(__stream)                     logger_disabled_ok()
+#define logger_output_file_compression_is_enabled(__stream)                  logger_disabled_false()
+#define logger_output_file_queue_stats_get(__stats)                          logger_disabled_ok()
+#define logger_decompress(__source, __destination)                           logger_disabled_ok()
+#define logger_output_recorder_register()                                    logger_disabled_ok()
+#define logger_output_recorder_deregister()                                  logger_disabled_ok()
+#define logger_output_recorder_is_registered()                               logger_disabled_false()
+#define logger_output_recorder_level_set(__level)                            logger_disabled_ok()
+#define logger_output_recorder_level_get()                                   logger_disabled_unknown()
+#define logger_output_recorder_level_mask_set(__level)                       logger_disabled_ok()
+#define logger_output_recorder_level_mask_get()                              logger_disabled_unknown()
+#define logger_output_recorder_dump(__stream)                                logger_disabled_ok()
+#define logger_output_recorder_crash_dump_enable(__path)                     logger_disabled_ok()
+#define logger_output_recorder_crash_dump_disable()                          logger_disabled_ok()
+#define logger_output_recorder_file_open(__path)                             logger_disabled_ok()
+#define logger_output_recorder_file_close()                                  logger_disabled_ok()
+#define logger_output_recorder_recover(__path, __stream)                     logger_disabled_ok()
+#define logger_stats_get(__id, __level, __stats)                             logger_disabled_ok()
+#define logger_stats_reset()                                                 logger_disabled_ok()
+#define logger_latency_get(__latency)                                        logger_disabled_ok()
+#define logger_output_latency_get(__stream, __latency)                       logger_disabled_ok()
+#define logger_output_function_latency_get(__function, __latency)            logger_disabled_ok()
+#define logger_output_driver_latency_get(__driver, __context, __latency)     logger_disabled_ok()
+#define logger_latency_dump(__level)                                         logger_disabled_ok()
+#define logger_latency_reset()                                               logger_disabled_ok()
+#define logger_profile_enable()                                              logger_disabled_ok()
+#define logger_profile_disable()                                             logger_disabled_ok()
+#define logger_profile_is_enabled()                                          logger_disabled_false()
+#define logger_profile_dump(__level, __count)                                logger_disabled_ok()
+#define logger_profile_dump_at_exit(__level)                                 logger_disabled_ok()
+#define logger_profile_reset()                                               logger_disabled_ok()
 #define logger_id_request(__name)                                            logger_disabled_id()
 #define logger_id_release(__id)                                              logger_disabled_ok()
 #define logger_id_enable(__id)                                               logger_disabled_ok()
@@ -573,6 +954,18 @@ LOGGER_INLINE uint16_t logger_disabled_zero(void)
 #define logger_id_level_get(__id)                                            logger_disabled_unknown()
 #define logger_id_level_mask_set(__id, __level)                              logger_disabled_ok()
 #define logger_id_level_mask_get(__id)                                       logger_disabled_unknown()
+#define logger_id_level_inherit(__id)                                        logger_disabled_ok()
+#define logger_id_level_spec_set(__spec)                                     logger_disabled_ok()
+#define logger_thread_level_override(__id, __level)                          logger_disabled_ok()
+#define logger_thread_level_override_clear()                                 logger_disabled_ok()
+#define logger_id_lazy_enable(__id, __count, __trigger)                      logger_disabled_ok()
+#define logger_id_lazy_disable(__id)                                         logger_disabled_ok()
+#define logger_id_lazy_is_enabled(__id)                                      logger_disabled_false()
+#define logger_id_line_buffer_enable(__id)                                   logger_disabled_ok()
+#define logger_id_line_buffer_disable(__id)                                  logger_disabled_ok()
+#define logger_id_line_buffer_is_enabled(__id)                               logger_disabled_false()
+#define logger_id_rate_limit_set(__id, __rate, __burst)                      logger_disabled_ok()
+#define logger_id_rate_limit_get(__id)                                       logger_disabled_zero()
 #define logger_id_prefix_set(__id, __prefix)                                 logger_disabled_ok()
 #define logger_id_prefix_get(__id)                                           logger_disabled_unset()
 #define logger_id_name_get(__id)                                             logger_disabled_string()
@@ -611,6 +1004,13 @@ LOGGER_INLINE uint16_t logger_disabled_zero(void)
 #define logger_level_name_get(__level)                                       logger_disabled_string()
 #define logger(__id, __level, ...)                                           logger_disabled_ok()
 #define logger_va(__id, __level, ...)                                        logger_disabled_ok()
+#define logger_every_n(__n, __id, __level, ...)                              logger_disabled_ok()
+#define logger_every_ms(__ms, __id, __level, ...)                            logger_disabled_ok()
+#define logger_sample(__p, __id, __level, ...)                               logger_disabled_ok()
+#define logger_msg_begin(__id, __level)                                      logger_disabled_ok()
+#define logger_msg_appendf(...)                                              logger_disabled_ok()
+#define logger_msg_commit()                                                  logger_disabled_ok()
+#define logger_kv(__id, __level, ...)                                        logger_disabled_ok()
 
 /* helper functions */
 #define logger_level_to_index(__level)                                       logger_disabled_zero()
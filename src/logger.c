@@ -11,16 +11,75 @@
  * \brief  Logging facility for C.
  * \author Markus Braun
  ******************************************************************************/
+/* request POSIX interfaces like fileno() and directory access */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif /* _POSIX_C_SOURCE */
+
 #include "logger.h"
 
 #ifdef LOGGER_ENABLE
 #include <string.h>
 #include <stdlib.h>
+#include <ctype.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <stddef.h>
 #include <time.h>
 #include <inttypes.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef LOGGER_HAVE_ZLIB
+#include <zlib.h>
+#endif /* LOGGER_HAVE_ZLIB */
+#ifdef LOGGER_USDT
+#include <sys/sdt.h>
+#endif /* LOGGER_USDT */
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define LOGGER_HAVE_SSE2
+#endif /* defined(__SSE2__) && defined(__GNUC__) */
+
+/* atomic access to configuration snapshots */
+#if defined(__GNUC__)
+#define LOGGER_ATOMIC_LOAD(__pointer)           __atomic_load_n((__pointer), __ATOMIC_ACQUIRE)
+#define LOGGER_ATOMIC_STORE(__pointer, __value) __atomic_store_n((__pointer), (__value), __ATOMIC_SEQ_CST)
+#define LOGGER_ATOMIC_ADD(__pointer, __value)   (void)__atomic_fetch_add((__pointer), (__value), __ATOMIC_SEQ_CST)
+#define LOGGER_ATOMIC_SWAP(__pointer, __expected, __value) __atomic_compare_exchange_n((__pointer), (__expected), (__value), 0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)
+#define LOGGER_ATOMIC_RELEASE(__pointer, __value) __atomic_store_n((__pointer), (__value), __ATOMIC_RELEASE)
+#define LOGGER_ATOMIC_FENCE()                   __atomic_thread_fence(__ATOMIC_SEQ_CST)
+/* counters are updated by all threads, they only need to be exact, not ordered */
+#define LOGGER_COUNTER_ADD(__pointer, __value)  (void)__atomic_fetch_add((__pointer), (__value), __ATOMIC_RELAXED)
+#define LOGGER_COUNTER_GET(__pointer)           __atomic_load_n((__pointer), __ATOMIC_RELAXED)
+#define LOGGER_COUNTER_SET(__pointer, __value)  __atomic_store_n((__pointer), (__value), __ATOMIC_RELAXED)
+#define LOGGER_COUNTER_SWAP(__pointer, __expected, __value) __atomic_compare_exchange_n((__pointer), (__expected), (__value), 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define LOGGER_COUNTER_NEXT(__pointer)          __atomic_add_fetch((__pointer), 1, __ATOMIC_RELAXED)
+#else /* defined(__GNUC__) */
+/* without atomics only a single thread may log while configuration changes */
+#define LOGGER_ATOMIC_LOAD(__pointer)           (*(__pointer))
+#define LOGGER_ATOMIC_STORE(__pointer, __value) (*(__pointer) = (__value))
+#define LOGGER_ATOMIC_ADD(__pointer, __value)   (*(__pointer) += (__value))
+#define LOGGER_ATOMIC_SWAP(__pointer, __expected, __value) ((*(__pointer) = (__value)), 1)
+#define LOGGER_ATOMIC_RELEASE(__pointer, __value) (*(__pointer) = (__value))
+#define LOGGER_ATOMIC_FENCE()                   ((void)0)
+#define LOGGER_COUNTER_ADD(__pointer, __value)  (*(__pointer) += (__value))
+#define LOGGER_COUNTER_GET(__pointer)           (*(__pointer))
+#define LOGGER_COUNTER_SET(__pointer, __value)  (*(__pointer) = (__value))
+#define LOGGER_COUNTER_SWAP(__pointer, __expected, __value) ((*(__pointer) = (__value)), 1)
+#define LOGGER_COUNTER_NEXT(__pointer)          (++*(__pointer))
+#endif /* defined(__GNUC__) */
+
+/* storage of each thread, without it only a single thread may log */
+#if defined(__GNUC__)
+#define LOGGER_THREAD_LOCAL                     __thread
+#else /* defined(__GNUC__) */
+#define LOGGER_THREAD_LOCAL
+#endif /* defined(__GNUC__) */
 
 /** Number of possible simultaneous outputs. */
 #ifndef LOGGER_OUTPUTS_MAX
@@ -37,6 +96,123 @@
 #define LOGGER_IDS_MAX                 (128)
 #endif /* LOGGER_IDS_MAX */
 
+/** Number of possible managed output files. */
+#ifndef LOGGER_FILES_MAX
+#define LOGGER_FILES_MAX               (4)
+#endif /* LOGGER_FILES_MAX */
+
+/** Length of managed output file path including '\0' */
+#ifndef LOGGER_PATH_MAX
+#define LOGGER_PATH_MAX                (256)
+#endif /* LOGGER_PATH_MAX */
+
+/** Number of rotated files waiting for compression. */
+#ifndef LOGGER_COMPRESS_JOBS_MAX
+#define LOGGER_COMPRESS_JOBS_MAX       (8)
+#endif /* LOGGER_COMPRESS_JOBS_MAX */
+
+/** Size of independently compressed blocks. */
+#ifndef LOGGER_COMPRESS_BLOCK_SIZE
+#define LOGGER_COMPRESS_BLOCK_SIZE     (65536)
+#endif /* LOGGER_COMPRESS_BLOCK_SIZE */
+#if (LOGGER_COMPRESS_BLOCK_SIZE < 1) || (LOGGER_COMPRESS_BLOCK_SIZE > 65536)
+#error "LOGGER_COMPRESS_BLOCK_SIZE must be in range 1 to 65536"
+#endif /* (LOGGER_COMPRESS_BLOCK_SIZE < 1) || (LOGGER_COMPRESS_BLOCK_SIZE > 65536) */
+
+/** Maximum length of the suffix appended to rotated and compressed file names. */
+#define LOGGER_FILE_SUFFIX_MAX         (24)
+#if (LOGGER_PATH_MAX <= LOGGER_FILE_SUFFIX_MAX)
+#error "LOGGER_PATH_MAX must be larger than LOGGER_FILE_SUFFIX_MAX"
+#endif /* (LOGGER_PATH_MAX <= LOGGER_FILE_SUFFIX_MAX) */
+
+/** Size of flight recorder ring buffer in bytes. */
+#ifndef LOGGER_RECORDER_SIZE
+#define LOGGER_RECORDER_SIZE           (64 * 1024)
+#endif /* LOGGER_RECORDER_SIZE */
+#if (LOGGER_RECORDER_SIZE < 1024) || ((LOGGER_RECORDER_SIZE % 8) != 0)
+#error "LOGGER_RECORDER_SIZE must be a multiple of 8 and at least 1024"
+#endif /* (LOGGER_RECORDER_SIZE < 1024) || ((LOGGER_RECORDER_SIZE % 8) != 0) */
+
+/** Number of messages kept for all IDs with lazy output. */
+#ifndef LOGGER_LAZY_MESSAGES_MAX
+#define LOGGER_LAZY_MESSAGES_MAX       (32)
+#endif /* LOGGER_LAZY_MESSAGES_MAX */
+#if (LOGGER_LAZY_MESSAGES_MAX < 1) || (LOGGER_LAZY_MESSAGES_MAX > 65535)
+#error "LOGGER_LAZY_MESSAGES_MAX must be in range 1 to 65535"
+#endif /* (LOGGER_LAZY_MESSAGES_MAX < 1) || (LOGGER_LAZY_MESSAGES_MAX > 65535) */
+
+/** Number of recently printed messages remembered for repeat detection. */
+#ifndef LOGGER_REPEAT_FINGERPRINTS_MAX
+#define LOGGER_REPEAT_FINGERPRINTS_MAX (64)
+#endif /* LOGGER_REPEAT_FINGERPRINTS_MAX */
+#if (LOGGER_REPEAT_FINGERPRINTS_MAX < 1)
+#error "LOGGER_REPEAT_FINGERPRINTS_MAX must be at least 1"
+#endif /* (LOGGER_REPEAT_FINGERPRINTS_MAX < 1) */
+
+/** Number of partial lines collected at the same time by each thread. */
+#ifndef LOGGER_CONTINUATIONS_MAX
+#define LOGGER_CONTINUATIONS_MAX       (8)
+#endif /* LOGGER_CONTINUATIONS_MAX */
+#if (LOGGER_CONTINUATIONS_MAX < 1)
+#error "LOGGER_CONTINUATIONS_MAX must be at least 1"
+#endif /* (LOGGER_CONTINUATIONS_MAX < 1) */
+
+/** Number of messages built by logger_msg_begin() at the same time by all threads. */
+#ifndef LOGGER_BUILDERS_MAX
+#define LOGGER_BUILDERS_MAX            (8)
+#endif /* LOGGER_BUILDERS_MAX */
+#if (LOGGER_BUILDERS_MAX < 1)
+#error "LOGGER_BUILDERS_MAX must be at least 1"
+#endif /* (LOGGER_BUILDERS_MAX < 1) */
+
+/** Number of call sites using logger_every_n(), logger_every_ms() or logger_sample(). */
+#ifndef LOGGER_SITES_MAX
+#define LOGGER_SITES_MAX               (64)
+#endif /* LOGGER_SITES_MAX */
+#if (LOGGER_SITES_MAX < 1)
+#error "LOGGER_SITES_MAX must be at least 1"
+#endif /* (LOGGER_SITES_MAX < 1) */
+
+/** Number of rules of a level specification. */
+#ifndef LOGGER_LEVEL_RULES_MAX
+#define LOGGER_LEVEL_RULES_MAX         (32)
+#endif /* LOGGER_LEVEL_RULES_MAX */
+#if (LOGGER_LEVEL_RULES_MAX < 1)
+#error "LOGGER_LEVEL_RULES_MAX must be at least 1"
+#endif /* (LOGGER_LEVEL_RULES_MAX < 1) */
+
+/** Number of call sites counted by the call site profile. */
+#ifndef LOGGER_PROFILE_SITES_MAX
+#define LOGGER_PROFILE_SITES_MAX       (256)
+#endif /* LOGGER_PROFILE_SITES_MAX */
+#if (LOGGER_PROFILE_SITES_MAX < 1)
+#error "LOGGER_PROFILE_SITES_MAX must be at least 1"
+#endif /* (LOGGER_PROFILE_SITES_MAX < 1) */
+
+/** Number of copies of the message counters of each ID, threads count in different copies. */
+#ifndef LOGGER_STATS_SHARDS
+#define LOGGER_STATS_SHARDS            (4)
+#endif /* LOGGER_STATS_SHARDS */
+#if (LOGGER_STATS_SHARDS < 1)
+#error "LOGGER_STATS_SHARDS must be at least 1"
+#endif /* (LOGGER_STATS_SHARDS < 1) */
+
+/** Number of threads reading output plans without a lock, more threads share a lock. */
+#ifndef LOGGER_PLAN_READERS_MAX
+#define LOGGER_PLAN_READERS_MAX        (64)
+#endif /* LOGGER_PLAN_READERS_MAX */
+#if (LOGGER_PLAN_READERS_MAX < 1)
+#error "LOGGER_PLAN_READERS_MAX must be at least 1"
+#endif /* (LOGGER_PLAN_READERS_MAX < 1) */
+
+/** Number of outputs whose write latency is measured when built with LOGGER_LATENCY. */
+#ifndef LOGGER_LATENCY_OUTPUTS_MAX
+#define LOGGER_LATENCY_OUTPUTS_MAX     (16)
+#endif /* LOGGER_LATENCY_OUTPUTS_MAX */
+#if (LOGGER_LATENCY_OUTPUTS_MAX < 1)
+#error "LOGGER_LATENCY_OUTPUTS_MAX must be at least 1"
+#endif /* (LOGGER_LATENCY_OUTPUTS_MAX < 1) */
+
 /** Length of logger ID name including '\0' */
 #ifndef LOGGER_NAME_MAX
 #define LOGGER_NAME_MAX                (256)
@@ -93,6 +269,33 @@
 /** Number of unified outputs */
 #define LOGGER_UNIFIED_OUTPUTS_MAX   (LOGGER_OUTPUTS_MAX + LOGGER_ID_OUTPUTS_MAX)
 
+/** Size of a cache line, data written by different threads is kept on different lines */
+#define LOGGER_CACHE_LINE            (64)
+
+/** Number of parts of a text line: prefix and message each with color begin and end plus '\n' */
+#define LOGGER_TEXT_PARTS_MAX        (7)
+
+/** Number of encodings of a message: JSON, binary, none and text with and without color per rendering of structured messages */
+#define LOGGER_OUTPUT_ENCODINGS      (3 + 2 * LOGGER_KV_FORMAT_MAX)
+
+/** Number of bits of linear sub buckets in each power of two of latency histograms */
+#define LOGGER_HISTOGRAM_SUB_BITS    (4)
+
+/** Number of linear sub buckets in each power of two of latency histograms */
+#define LOGGER_HISTOGRAM_SUB_COUNT   (1 << LOGGER_HISTOGRAM_SUB_BITS)
+
+/** Number of buckets of latency histograms, longer times up to 2^36 ns (about 68 s) share the last one */
+#define LOGGER_HISTOGRAM_BUCKETS     ((36 - LOGGER_HISTOGRAM_SUB_BITS + 1) * LOGGER_HISTOGRAM_SUB_COUNT)
+
+/** USDT probe of provider "logger" for perf and bpftrace, compiled away without LOGGER_USDT */
+#ifdef LOGGER_USDT
+#define LOGGER_PROBE3(__name, __arg1, __arg2, __arg3)                  DTRACE_PROBE3(logger, __name, __arg1, __arg2, __arg3)
+#define LOGGER_PROBE5(__name, __arg1, __arg2, __arg3, __arg4, __arg5)  DTRACE_PROBE5(logger, __name, __arg1, __arg2, __arg3, __arg4, __arg5)
+#else  /* LOGGER_USDT */
+#define LOGGER_PROBE3(__name, __arg1, __arg2, __arg3)
+#define LOGGER_PROBE5(__name, __arg1, __arg2, __arg3, __arg4, __arg5)
+#endif /* LOGGER_USDT */
+
 /** Format string for strftime */
 #define LOGGER_FORMAT_STRFTIME         "%Y-%m-%d %H:%M:%S"
 
@@ -153,26 +356,317 @@
 /** Helper to convert a number to its absolute value */
 #define LOGGER_NUMERIC_ABS(a) ((a) < 0 ? (-a) : (a))
 
+/** Room left in JSON lines for a member with a number or shortened string */
+#define LOGGER_JSON_MEMBER_MIN (40)
+
+/** Helper for functions reading whole aligned blocks beyond the end of a string */
+#if defined(__SANITIZE_ADDRESS__)
+#define LOGGER_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define LOGGER_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif /* __has_feature(address_sanitizer) */
+#endif /* defined(__SANITIZE_ADDRESS__) */
+#ifndef LOGGER_NO_SANITIZE_ADDRESS
+#define LOGGER_NO_SANITIZE_ADDRESS
+#endif /* LOGGER_NO_SANITIZE_ADDRESS */
+
+/** Suffix of compressed files */
+#define LOGGER_COMPRESS_SUFFIX ".lz"
+
+/** Size of compressed block header: magic, method, 3 reserved, size, compressed size */
+#define LOGGER_COMPRESS_HEADER_SIZE (16)
+
+/** Maximum size of a compressed block including header */
+#define LOGGER_COMPRESS_BLOCK_BOUND (LOGGER_COMPRESS_HEADER_SIZE + LOGGER_COMPRESS_BLOCK_SIZE + LOGGER_COMPRESS_BLOCK_SIZE / 255 + 16)
+
+/** Minimum match length of the built in LZ compressor */
+#define LOGGER_LZ_MATCH_MIN (4)
+
+/** Number of bits of the LZ compressor hash table index */
+#define LOGGER_LZ_HASH_BITS (12)
+
+/** Number of slots searched for a message fingerprint */
+#define LOGGER_REPEAT_PROBES (4)
+
+/** Logger compression method of a block */
+typedef enum logger_compress_method_e {
+  LOGGER_COMPRESS_METHOD_STORED = 0, /**< Block is stored uncompressed. */
+  LOGGER_COMPRESS_METHOD_LZ     = 1, /**< Block is compressed with the built in LZ compressor. */
+  LOGGER_COMPRESS_METHOD_ZLIB   = 2  /**< Block is compressed with zlib. */
+} logger_compress_method_t;
+
+/** Number of strings in a flight recorder record: ID name, file, function and message */
+#define LOGGER_RECORDER_STRINGS (4)
+
+/** Alignment of flight recorder records */
+#define LOGGER_RECORDER_ALIGNMENT (8)
+
+/** Number of signals dumping the flight recorder */
+#define LOGGER_RECORDER_SIGNALS (5)
+
+/** Magic number starting every flight recorder record */
+#define LOGGER_RECORDER_MAGIC (0x4C475252U)
+
+/** Magic bytes starting a flight recorder file */
+#define LOGGER_RECORDER_FILE_MAGIC "LOGGERFR"
+
+/** Version of the flight recorder file format */
+#define LOGGER_RECORDER_FILE_VERSION (1)
+
+/** First line of flight recorder dump on crash */
+#define LOGGER_RECORDER_CRASH_MESSAGE "LOGGER SYSTEM MESSAGE: flight recorder dump on signal "
+
 /** Logger output type */
 typedef enum logger_output_type_e {
   LOGGER_OUTPUT_TYPE_UNKNOWN    = 0, /**< Output type is unknown */
   LOGGER_OUTPUT_TYPE_FILESTREAM = 1, /**< Output is a file stream of type (FILE *). */
   LOGGER_OUTPUT_TYPE_FUNCTION   = 2, /**< Output is a user provided function. */
+  LOGGER_OUTPUT_TYPE_DRIVER     = 3, /**< Output is a user provided driver. */
+  LOGGER_OUTPUT_TYPE_RECORD     = 4, /**< Output is a user provided record function. */
   LOGGER_OUTPUT_TYPE_MAX             /**< Last entry, always! */
 } logger_output_type_t;
 
 
+/** Logger managed output file structure */
+typedef struct logger_file_s {
+  logger_bool_t used;                  /**< This managed file is used. */
+  logger_bool_t rotating;              /**< Rotation is queued for the background thread. */
+  logger_bool_t line_open;             /**< Last write didn't end with a newline, don't rotate. */
+  int           next_fd;               /**< Descriptor of the new file waiting for the end of a line, -1 if none. */
+  FILE          *stream;               /**< File stream, stays the same across rotations. */
+  char          path[LOGGER_PATH_MAX]; /**< Path of the currently written file. */
+  size_t        rotate_bytes;          /**< Rotate when file would exceed this size, 0 disables. */
+  uint32_t      rotate_interval;       /**< Rotate when file is older than this (seconds), 0 disables. */
+  uint16_t      keep;                  /**< Number of rotated files to keep, 0 keeps all. */
+  size_t        bytes;                 /**< Bytes written to the current file. */
+  time_t        opened;                /**< Time the current file was opened. */
+  uint32_t      generation;            /**< Generation number of the next rotated file. */
+  logger_bool_t compress;              /**< Compress rotated files in background. */
+} logger_file_t;
+
+
+/** Logger background job structure */
+typedef struct logger_compress_job_s {
+  logger_file_t *rotate;               /**< Managed file to rotate, \c NULL to compress \c path. */
+  char          path[LOGGER_PATH_MAX]; /**< Rotated file to compress. */
+} logger_compress_job_t;
+
+
+/** Logger background compression and rotation structure */
+typedef struct logger_compress_s {
+  pthread_mutex_t       mutex;         /**< Protects all members. */
+  pthread_cond_t        wakeup;        /**< Signals new jobs to the worker. */
+  pthread_cond_t        idle;          /**< Signals finished jobs. */
+  logger_bool_t         running;       /**< Worker thread is started. */
+  logger_bool_t         busy;          /**< Worker is processing \c current. */
+  logger_bool_t         cancel;        /**< Remove result of \c current, it has been pruned. */
+  size_t                head;          /**< Index of oldest job. */
+  size_t                count;         /**< Number of queued jobs. */
+  size_t                peak;          /**< Most jobs queued at the same time. */
+  uint64_t              dropped;       /**< Jobs not queued because the queue was full. */
+  logger_compress_job_t current;                            /**< Job being processed. */
+  logger_compress_job_t jobs[LOGGER_COMPRESS_JOBS_MAX];     /**< Queued jobs. */
+} logger_compress_t;
+
+
+/** Logger flight recorder record header, followed by the strings */
+typedef struct logger_recorder_record_s {
+  uint32_t       magic;                             /**< Always \c LOGGER_RECORDER_MAGIC. */
+  uint32_t       checksum;                          /**< FNV-1a checksum of record with this member set to 0 and strings. */
+  uint32_t       size;                              /**< Size of record including strings and padding, 0 marks wrap. */
+  uint32_t       sequence;                          /**< Sequence number of message. */
+  int64_t        time;                              /**< Time of message. */
+  uint32_t       line;                              /**< Line of message. */
+  logger_level_t level;                             /**< Level of message. */
+  uint16_t       lengths[LOGGER_RECORDER_STRINGS];  /**< Length of each string including '\0'. */
+  uint16_t       reserved;                          /**< Padding. */
+} logger_recorder_record_t;
+
+
+/** Logger flight recorder file header, followed by the ring buffer */
+typedef struct logger_recorder_file_s {
+  char     magic[8];                   /**< Always \c LOGGER_RECORDER_FILE_MAGIC. */
+  uint32_t version;                    /**< Always \c LOGGER_RECORDER_FILE_VERSION. */
+  uint32_t header_size;                /**< Size of this header. */
+  uint64_t size;                       /**< Size of the ring buffer. */
+} logger_recorder_file_t;
+
+
+/** Logger flight recorder structure */
+typedef struct logger_recorder_s {
+  int16_t          count;                                   /**< Number of registrations for this output. */
+  logger_level_t   level;                                   /**< Level for this output. */
+  uint8_t          *buffer;                                 /**< Ring buffer. */
+  size_t           size;                                    /**< Size of ring buffer. */
+  void             *map;                                    /**< Mapped recorder file, NULL if ring is in memory. */
+  size_t           map_size;                                /**< Size of mapped recorder file. */
+  uint64_t         cursor;                                  /**< Position of next record in upper, sequence number of last record in lower 32 bits. */
+  uint32_t         first;                                   /**< Sequence number of last record not dumped. */
+  logger_bool_t    crash_dump;                              /**< Signal handlers are installed. */
+  char             crash_path[LOGGER_PATH_MAX];             /**< Dump file on crash, empty for stderr. */
+  struct sigaction crash_actions[LOGGER_RECORDER_SIGNALS];  /**< Signal handlers replaced for crash dump. */
+} logger_recorder_t;
+
+
+/** Logger flight recorder dump buffer */
+typedef struct logger_recorder_dump_s {
+  int    fd;                           /**< File descriptor to write to. */
+  size_t used;                         /**< Used bytes of data. */
+  char   data[256];                    /**< Buffered output. */
+} logger_recorder_dump_t;
+
+
+/** Logger token bucket structure */
+typedef struct logger_bucket_s {
+  logger_rate_limit_t rate;    /**< Tokens added per second, 0 if unlimited. */
+  logger_rate_limit_t burst;   /**< Maximum number of tokens. */
+  uint64_t            tokens;  /**< Available tokens in thousandths. */
+  uint64_t            updated; /**< Time of last refill in milliseconds. */
+  logger_rate_limit_t skipped; /**< Number of skipped messages. */
+} logger_bucket_t;
+
+
+/** Logger call site structure */
+typedef struct logger_site_s {
+  const char          *file;    /**< File of call site, NULL if slot is free. */
+  uint32_t            line;     /**< Line of call site. */
+  uint32_t            count;    /**< Number of messages seen. */
+  logger_bool_t       printed;  /**< A message has been printed. */
+  uint64_t            last;     /**< Time of last printed message in milliseconds. */
+  logger_rate_limit_t skipped;  /**< Number of skipped messages. */
+} logger_site_t;
+
+
+/** Logger call site profile structure */
+typedef struct logger_profile_site_s {
+  const char *file;                    /**< File of call site, NULL if slot is free. */
+  const char *function;                /**< Function of call site. */
+  uint32_t   line;                     /**< Line of call site. */
+  uint64_t   calls;                    /**< Number of calls. */
+  uint64_t   lines;                    /**< Number of lines printed. */
+  uint64_t   bytes;                    /**< Number of bytes written to all outputs. */
+} logger_profile_site_t;
+
+
+/** Logger level specification rule */
+typedef struct logger_level_rule_s {
+  logger_level_t level;                   /**< Minimum level of matching IDs. */
+  char           pattern[LOGGER_NAME_MAX]; /**< Pattern of ID names, may contain '*' and '?'. */
+} logger_level_rule_t;
+
+
+/** Logger partial line structure */
+typedef struct logger_continuation_s {
+  logger_bool_t  used;                               /**< Slot holds a partial line. */
+  uint32_t       generation;                         /**< Line generation of the ID, the line is dropped if it changed. */
+  logger_id_t    id;                                 /**< ID of the line. */
+  logger_level_t level;                              /**< Level of the first part. */
+  char           prefix[LOGGER_PREFIX_STRING_MAX];   /**< Prefix of the first part. */
+  char           message[LOGGER_MESSAGE_STRING_MAX]; /**< Parts collected so far. */
+} logger_continuation_t;
+
+
+/** Logger message builder structure */
+typedef struct logger_builder_s {
+  logger_bool_t  used;                               /**< Slot holds a message. */
+  logger_bool_t  active;                             /**< Message may be printed or recorded. */
+  logger_bool_t  truncated;                          /**< Message didn't fit. */
+  logger_id_t    id;                                 /**< ID of the message. */
+  logger_level_t level;                              /**< Level of the message. */
+  const char     *file;                              /**< File where the message was begun. */
+  const char     *function;                          /**< Function where the message was begun. */
+  uint32_t       line;                               /**< Line where the message was begun. */
+  size_t         length;                             /**< Length of message. */
+  char           message[LOGGER_MESSAGE_STRING_MAX]; /**< Message built so far. */
+} logger_builder_t;
+
+
+/** Logger origin of a message needed by outputs not using the prefix */
+typedef struct logger_origin_s {
+  const char *date;                                  /**< Formatted time of message. */
+  int64_t    time;                                   /**< Time of message. */
+  const char *file;                                  /**< File of message. */
+  const char *function;                              /**< Function of message. */
+  uint32_t   line;                                   /**< Line of message. */
+} logger_origin_t;
+
+
+/** Logger lazy message structure */
+typedef struct logger_lazy_s {
+  logger_bool_t  used;                               /**< Slot holds a message. */
+  logger_id_t    id;                                 /**< ID of kept message. */
+  logger_level_t level;                              /**< Level of kept message. */
+  uint32_t       sequence;                           /**< Age of kept message. */
+  const char     *file;                              /**< File of kept message. */
+  const char     *function;                          /**< Function of kept message. */
+  uint32_t       line;                               /**< Line of kept message. */
+  int64_t        time;                               /**< Time of kept message. */
+  char           date[LOGGER_DATE_STRING_MAX];       /**< Formatted time of kept message. */
+  char           prefix[LOGGER_PREFIX_STRING_MAX];   /**< Prefix formatted when message was logged. */
+  char           message[LOGGER_MESSAGE_STRING_MAX]; /**< Formatted message. */
+} logger_lazy_t;
+
+
+/** Logger latency histogram, log-linear like HDR histograms */
+typedef struct logger_histogram_s {
+  uint64_t count;                             /**< Number of measurements. */
+  uint64_t total;                             /**< Sum of measured times in nanoseconds. */
+  uint64_t min;                               /**< Shortest measured time in nanoseconds. */
+  uint64_t max;                               /**< Longest measured time in nanoseconds. */
+  uint64_t buckets[LOGGER_HISTOGRAM_BUCKETS]; /**< Number of measurements in each bucket. */
+} logger_histogram_t;
+
+
 /** Logger output structure */
 typedef struct logger_output_s {
   int16_t                  count;       /**< Number of registrations for this output. */
   logger_level_t           level;       /**< Level for this output. */
   logger_bool_t            use_color;   /**< Use color strings for this output. */
+  logger_kv_format_t       kv_format;   /**< Rendering of structured messages. */
+  logger_output_format_t   format;      /**< Format of lines. */
   logger_output_type_t     type;        /**< Selector for this output. */
   FILE                     *stream;     /**< File pointer given during registration. */
   logger_output_function_t function;    /**< User function given during registration. */
+  logger_file_t            *file;       /**< Managed file behind the file pointer, NULL if unmanaged. */
+  logger_output_record_function_t record_function; /**< User record function given during registration. */
+  const logger_output_driver_t *driver; /**< Driver writing the lines. */
+  void                     *context;    /**< Context of driver, the registered output for streams and functions. */
+  logger_output_stats_t    stats;       /**< Counters of this registered output. */
+  logger_output_stats_t    *counters;   /**< Counters of the registered output, kept by unified copies. */
+  logger_histogram_t       *latency;    /**< Write latency of the output, NULL if not measured. */
 } logger_output_t;
 
 
+/** Logger output write latency */
+typedef struct logger_output_latency_s {
+  logger_output_type_t            type;            /**< Type of measured output, LOGGER_OUTPUT_TYPE_UNKNOWN if slot is free. */
+  FILE                            *stream;         /**< File pointer of measured output. */
+  logger_output_function_t        function;        /**< User function of measured output. */
+  logger_output_record_function_t record_function; /**< User record function of measured output. */
+  const logger_output_driver_t    *driver;         /**< Driver of measured output. */
+  void                            *context;        /**< Context of measured driver. */
+  logger_histogram_t              histogram;       /**< Write latency. */
+} logger_output_latency_t;
+
+
+/** Logger structured message */
+typedef struct logger_kv_list_s {
+  const char        *message;                                              /**< Message without fields. */
+  const logger_kv_t *fields;                                               /**< Fields of message. */
+  size_t            count;                                                 /**< Number of fields. */
+  logger_bool_t     rendered[LOGGER_KV_FORMAT_MAX];                        /**< Message is rendered in this format. */
+  char              strings[LOGGER_KV_FORMAT_MAX][LOGGER_MESSAGE_STRING_MAX]; /**< Message rendered in each format. */
+} logger_kv_list_t;
+
+
+/** Logger line rendered in one encoding */
+typedef struct logger_encoding_s {
+  size_t length;                        /**< Length of line. */
+  char   line[LOGGER_LINE_STRING_MAX];  /**< Whole output line. */
+} logger_encoding_t;
+
+
 /** Logger color definition */
 typedef struct logger_color_string_s {
   char begin[LOGGER_COLOR_STRING_MAX]; /**< Color begin marker string. */
@@ -180,20 +674,55 @@ typedef struct logger_color_string_s {
 } logger_color_string_t;
 
 
+/** Logger output plan, an immutable snapshot of the configuration of an ID */
+typedef struct logger_plan_s {
+  logger_bool_t               enabled;                             /**< Logger and ID are enabled. */
+  logger_level_t              level;                               /**< Effective level of the ID. */
+  logger_prefix_t             prefix;                              /**< Prefix of the ID. */
+  logger_prefix_t             prefix_standard;                     /**< Global prefix used if the ID has none. */
+  logger_bool_t               color_prefix;                        /**< Prefix color is enabled. */
+  logger_bool_t               color_message;                       /**< Message color is enabled. */
+  logger_color_string_t       color_string;                        /**< Color string of the ID. */
+  const logger_color_string_t *level_colors;                       /**< Color strings of the levels. */
+  logger_level_t              line_level;                          /**< Levels formatted as line by any output. */
+  logger_level_t              text_level;                          /**< Levels printed with prefix by any output. */
+  logger_output_t             outputs[LOGGER_UNIFIED_OUTPUTS_MAX]; /**< Unified global and ID specific outputs. */
+} logger_plan_t;
+
+
+/** Logger reader of output plans, each thread writes its own cache line */
+typedef struct logger_plan_reader_s {
+  uint32_t epoch;                                       /**< Epoch the thread started reading plans, 0 if not reading. */
+  uint32_t used;                                        /**< Slot belongs to a thread. */
+  uint8_t  padding[LOGGER_CACHE_LINE - 2 * sizeof(uint32_t)]; /**< Keeps slots of other threads off the cache line. */
+} logger_plan_reader_t;
+
+
 /** Logger control structure */
 typedef struct logger_control_s {
   logger_bool_t         used;                                        /**< This ID is used. */
   int16_t               count;                                       /**< Number of registrations for this ID. */
   logger_bool_t         enabled;                                     /**< This ID is enabled. */
-  logger_level_t        level;                                       /**< Level for this ID. */
+  logger_level_t        level;                                       /**< Effective level for this ID. */
+  logger_bool_t         own_level_set;                               /**< Level was set for this ID, otherwise it is inherited. */
+  logger_level_t        own_level;                                   /**< Level set for this ID. */
   logger_prefix_t       prefix;                                      /**< Prefix for this ID. */
   logger_bool_t         color;                                       /**< Changed colors for this ID. */
   logger_color_string_t color_string;                                /**< Color string for this ID. */
   logger_bool_t         color_string_changed;                        /**< Color string had been changed for this ID. */
   logger_bool_t         append;                                      /**< Previous message didn't contain a newline just append next message */
+  uint16_t              lazy_count;                                  /**< Number of kept messages not printed, 0 if disabled. */
+  logger_level_t        lazy_trigger;                                /**< Lowest level printing kept messages. */
+  logger_bucket_t       bucket;                                      /**< Rate limit for this ID. */
+  logger_bool_t         line_buffer;                                 /**< Partial lines are collected per thread. */
+  logger_stats_t        stats[LOGGER_STATS_SHARDS][LOGGER_MAX];      /**< Message counters for each level, one copy per shard of threads. */
   char                  name[LOGGER_NAME_MAX];                       /**< Name of this logger ID. */
   logger_output_t       outputs[LOGGER_ID_OUTPUTS_MAX];              /**< Storage for possible ID outputs. */
-  logger_output_t       unified_outputs[LOGGER_UNIFIED_OUTPUTS_MAX]; /**< Storage for unified global and ID specific outputs. */
+  logger_plan_t         *plan;                                       /**< Published output plan, read by logging threads, members from here on are kept on release. */
+  logger_plan_t         plans[2];                                    /**< Storage for published and next output plan. */
+  uint32_t              plan_retired;                                /**< Epoch the spare plan was replaced, 0 if never published. */
+  logger_bool_t         plan_dirty;                                  /**< Configuration changed since the plan was published. */
+  uint32_t              line_generation;                             /**< Changed when partial lines of this ID are dropped. */
 } logger_control_t;
 
 
@@ -204,9 +733,27 @@ typedef struct logger_repeat_s {
   logger_level_t level;                              /**< Level of repeated message */
   uint16_t       prefix_length;                      /**< Length of prefix string of repeated message */
   char           message[LOGGER_MESSAGE_STRING_MAX]; /**< Storage for repeated message string */
+  uint32_t       generation;                         /**< Number of printed repeat messages */
+  uint32_t       pending_generation;                 /**< Generation when pending repeats were noticed */
+  uint64_t       pending;                            /**< Time pending repeats were noticed, 0 if none */
+  uint32_t       flush_interval;                     /**< Time in milliseconds repeats stay pending */
 } logger_repeat_t;
 
 
+/** Logger message fingerprint structure */
+typedef struct logger_fingerprint_s {
+  const char     *file;         /**< File of message, NULL if slot is free. */
+  uint32_t       line;          /**< Line of message. */
+  logger_id_t    id;            /**< ID of message. */
+  logger_level_t level;         /**< Level of message. */
+  uint32_t       hash;          /**< Hash of formatted message. */
+  uint16_t       prefix_length; /**< Length of prefix string of message. */
+  uint32_t       count;         /**< Number of suppressed repeats. */
+  uint64_t       printed;       /**< Time message was printed in milliseconds. */
+  uint64_t       reported;      /**< Time repeats were printed last in milliseconds. */
+} logger_fingerprint_t;
+
+
 /** logger rate limit structure */
 typedef struct logger_limit_s {
   logger_rate_limit_t limit;           /**< Message rate limit (messages per second) */
@@ -214,6 +761,7 @@ typedef struct logger_limit_s {
   logger_bool_t       exceeded;        /**< Flag: Number of messages per second is exceeded */
   logger_bool_t       message_request; /**< Flag: Output of message is requested */
   logger_rate_limit_t skipped;         /**< Number of skipped messages */
+  logger_level_t      exempt;          /**< Levels never skipped */
 } logger_limit_t;
 
 
@@ -224,14 +772,77 @@ static logger_bool_t     logger_color_prefix_enabled  = logger_false;
 static logger_bool_t     logger_color_message_enabled = logger_false;           /**< Logger message color is enabled. */
 static logger_control_t  logger_control[LOGGER_IDS_MAX + 1];                    /**< Control storage for possible IDs plus system ID. */
 static logger_output_t   logger_outputs[LOGGER_OUTPUTS_MAX];                    /**< Storage for possible outputs. */
+static logger_file_t     logger_files[LOGGER_FILES_MAX];                        /**< Storage for managed output files. */
+static logger_compress_t logger_compress = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER }; /**< Background compression. */
+static logger_recorder_t logger_recorder;                                       /**< Flight recorder. */
+static logger_lazy_t     logger_lazy[LOGGER_LAZY_MESSAGES_MAX];                 /**< Messages kept for lazy output. */
+static LOGGER_THREAD_LOCAL logger_continuation_t logger_continuations[LOGGER_CONTINUATIONS_MAX]; /**< Partial lines of the thread. */
+static logger_builder_t  logger_builders[LOGGER_BUILDERS_MAX];                 /**< Messages built by threads. */
+static pthread_key_t     logger_builder_key;                                    /**< Message built by the thread. */
+static pthread_mutex_t   logger_builder_mutex = PTHREAD_MUTEX_INITIALIZER;     /**< Serializes taking and returning slots of builders. */
+static pthread_key_t     logger_thread_key;                                     /**< Drops state of exiting threads. */
+static LOGGER_THREAD_LOCAL logger_level_t logger_thread_levels[LOGGER_IDS_MAX + 1]; /**< Levels printed by the thread in addition to the level of each ID. */
+static LOGGER_THREAD_LOCAL logger_level_t logger_thread_level;                 /**< Levels printed by the thread in addition to the level of all IDs. */
+static pthread_once_t    logger_thread_once = PTHREAD_ONCE_INIT;                /**< Creates logger_thread_key. */
+static LOGGER_THREAD_LOCAL logger_bool_t logger_printing;                      /**< The thread prints a message. */
+static pthread_mutex_t   logger_lazy_mutex   = PTHREAD_MUTEX_INITIALIZER;      /**< Serializes kept messages. */
+static pthread_mutex_t   logger_repeat_mutex = PTHREAD_MUTEX_INITIALIZER;      /**< Serializes repeat detection, taken after logger_lazy_mutex. */
+static pthread_mutex_t   logger_limit_mutex  = PTHREAD_MUTEX_INITIALIZER;      /**< Serializes rate limits and call site limits, taken last. */
+static uint32_t          logger_lazy_sequence;                                  /**< Age of latest kept message. */
 static logger_repeat_t   logger_repeat;                                         /**< Storage for repeated message information. */
+static uint32_t          logger_repeat_window;                                  /**< Time in milliseconds repeats of recent messages are suppressed. */
+static logger_fingerprint_t logger_fingerprints[LOGGER_REPEAT_FINGERPRINTS_MAX]; /**< Recently printed messages. */
 static logger_limit_t    logger_limit;                                          /**< Storage for rate limit information. */
-static char              logger_date[LOGGER_DATE_STRING_MAX];                   /**< Storage for date string */
-static char              logger_prefix[LOGGER_PREFIX_STRING_MAX];               /**< Storage for prefix string */
-static char              logger_message[LOGGER_MESSAGE_STRING_MAX];             /**< Storage for message string */
-static char              logger_line[LOGGER_LINE_STRING_MAX];                   /**< Storage for whole output line */
+static logger_bucket_t   logger_level_buckets[LOGGER_MAX];                      /**< Rate limits for levels. */
+static logger_site_t     logger_sites[LOGGER_SITES_MAX];                        /**< Call sites with limits. */
+static uint32_t          logger_site_random;                                    /**< State of call site sampling. */
+static const char        logger_site_claiming[] = "";                           /**< File of call site slots being claimed. */
+static logger_bool_t     logger_profile_enabled;                                /**< Call site profile is enabled. */
+static logger_profile_site_t logger_profile_sites[LOGGER_PROFILE_SITES_MAX];    /**< Call sites of profile. */
+static LOGGER_THREAD_LOCAL logger_profile_site_t *logger_profile_current;       /**< Call site of message being printed by the thread, NULL if not profiled. */
+static uint64_t          logger_profile_untracked;                              /**< Calls of call sites not fitting into profile. */
+static logger_level_t    logger_profile_exit_level;                             /**< Level of profile printed at exit, LOGGER_UNKNOWN if none. */
+static logger_bool_t     logger_profile_exit_registered;                        /**< Exit handler is registered. */
+static uint16_t          logger_config_depth;                                   /**< Nesting of logger_config_begin(), 0 if not batching. */
+static logger_bool_t     logger_config_unify;                                   /**< Outputs changed while batching. */
+static logger_bool_t     logger_config_resolve;                                 /**< Levels changed while batching. */
+static pthread_mutex_t   logger_plan_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< Serializes writers of output plans. */
+static uint32_t          logger_plan_epoch = 1;                                 /**< Epoch of published output plans, never 0. */
+static logger_bool_t     logger_plan_all;                                       /**< Plans of all IDs and the level colors changed. */
+static uint32_t          logger_plan_colors_retired;                            /**< Epoch the spare level colors were replaced, 0 if never published. */
+static logger_plan_reader_t logger_plan_readers[LOGGER_PLAN_READERS_MAX];       /**< Epochs of threads reading plans. */
+static logger_plan_reader_t logger_plan_overflow;                               /**< Reader of threads without a slot. */
+static logger_bool_t     logger_plan_overflow_used;                             /**< Some threads read plans without a slot. */
+static pthread_rwlock_t  logger_plan_overflow_lock = PTHREAD_RWLOCK_INITIALIZER; /**< Read by threads without a slot. */
+static LOGGER_THREAD_LOCAL logger_plan_reader_t *logger_plan_reader;           /**< Reader slot of the thread, NULL if not claimed. */
+static LOGGER_THREAD_LOCAL uint32_t logger_plan_depth;                         /**< Nesting of plan reads of the thread. */
+static logger_level_rule_t logger_level_rules[LOGGER_LEVEL_RULES_MAX];          /**< Rules of level specification. */
+static size_t            logger_level_rule_count;                               /**< Number of rules of level specification. */
+static LOGGER_THREAD_LOCAL char logger_date[LOGGER_DATE_STRING_MAX];           /**< Storage for date string of the thread */
+static LOGGER_THREAD_LOCAL char logger_prefix[LOGGER_PREFIX_STRING_MAX];       /**< Storage for prefix string of the thread */
+static LOGGER_THREAD_LOCAL char logger_message[LOGGER_MESSAGE_STRING_MAX];     /**< Storage for message string of the thread */
+static LOGGER_THREAD_LOCAL logger_encoding_t logger_encodings[LOGGER_OUTPUT_ENCODINGS]; /**< Storage for whole output line in each encoding of the thread */
+static uint32_t          logger_binary_sequence;                                /**< Sequence number of last binary record. */
+static uint32_t          logger_stats_threads;                                  /**< Number of threads which got a shard of message counters. */
+#ifdef LOGGER_LATENCY
+static logger_histogram_t      logger_latency_calls;                                 /**< Latency of logger() calls. */
+static logger_output_latency_t logger_latency_outputs[LOGGER_LATENCY_OUTPUTS_MAX];   /**< Write latency of outputs. */
+#endif /* LOGGER_LATENCY */
 static const logger_id_t logger_system_id = 0;                                  /**< System logging ID */
 
+static uint8_t           logger_compress_input[LOGGER_COMPRESS_BLOCK_SIZE];     /**< Uncompressed block of compression worker */
+static uint8_t           logger_compress_output[LOGGER_COMPRESS_BLOCK_BOUND];   /**< Compressed block of compression worker */
+static uint32_t          logger_lz_hash[1 << LOGGER_LZ_HASH_BITS];              /**< Match positions of compression worker */
+static uint8_t           logger_decompress_input[LOGGER_COMPRESS_BLOCK_BOUND];  /**< Compressed block of logger_decompress() */
+static uint8_t           logger_decompress_output[LOGGER_COMPRESS_BLOCK_SIZE];  /**< Uncompressed block of logger_decompress() */
+static uint64_t          logger_recorder_storage[LOGGER_RECORDER_SIZE / sizeof(uint64_t)]; /**< Ring buffer of flight recorder */
+
+/** Signals dumping the flight recorder */
+static const int logger_recorder_signals[LOGGER_RECORDER_SIGNALS] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+
+/** Magic bytes starting every compressed block */
+static const uint8_t logger_compress_magic[4] = { 'L', 'G', 'Z', '1' };
+
 /** level to name translation */
 static const char *logger_level_names[LOGGER_MAX] =
 {
@@ -250,6 +861,12 @@ static const char *logger_level_names[LOGGER_MAX] =
 /** level to color translation */
 static logger_color_string_t logger_level_colors[LOGGER_MAX];
 
+/** level to color translation read by published and next output plans */
+static logger_color_string_t logger_level_color_plans[2][LOGGER_MAX];
+
+/** level to color translation read by published output plans */
+static const logger_color_string_t *logger_level_color_plan = NULL;
+
 
 /** level to color translation for console */
 static logger_color_string_t logger_level_colors_console[LOGGER_MAX] =
@@ -267,11 +884,109 @@ static logger_color_string_t logger_level_colors_console[LOGGER_MAX] =
 
 static char logger_int_to_char[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9' };
 
+/** two digit numbers for converting integers of structured messages */
+static const char logger_int_to_chars[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
 /* declarations */
 LOGGER_INLINE void logger_repeat_message(void);
+LOGGER_INLINE void logger_fingerprint_message(logger_fingerprint_t *fingerprint);
+LOGGER_INLINE void logger_fingerprint_drop(logger_id_t id);
 LOGGER_INLINE void logger_rate_limit_message(logger_bool_t force);
+LOGGER_INLINE void logger_config_change(void);
+LOGGER_INLINE void logger_plan_output_set(logger_output_t *unified, const logger_output_t *output);
+LOGGER_INLINE void logger_plan_build(logger_plan_t *plan, size_t id_index, const logger_color_string_t *level_colors);
+LOGGER_INLINE void logger_plan_publish(void);
+LOGGER_INLINE void logger_plan_release(logger_id_t id);
+LOGGER_INLINE void logger_plan_mark(logger_id_t id);
+LOGGER_INLINE logger_id_t logger_plan_owner(const logger_output_t *outputs);
+LOGGER_INLINE uint32_t logger_plan_epoch_next(void);
+logger_return_t logger_output_common_unify(logger_id_t id);
+LOGGER_INLINE uint64_t logger_time_ms(void);
+LOGGER_INLINE void logger_bucket_set(logger_bucket_t *bucket, const logger_rate_limit_t rate, const logger_rate_limit_t burst);
 LOGGER_INLINE size_t logger_string_copy(char *dest, const char *src, size_t n);
 LOGGER_INLINE size_t logger_prefix_concatenate(char *dest, const char *dest_end, const char *src, size_t width);
+LOGGER_INLINE char *logger_json_put_string(char *write_ptr, const char *end_ptr, const char *string);
+LOGGER_INLINE char *logger_json_put_members(char *write_ptr, const char *end_ptr, const logger_kv_list_t *kv);
+LOGGER_INLINE logger_file_t *logger_file_find(FILE *stream);
+LOGGER_INLINE void logger_file_scan(logger_file_t *file);
+LOGGER_INLINE void logger_file_rotate(logger_file_t *file);
+LOGGER_INLINE void logger_file_swap(logger_file_t *file, int fd);
+LOGGER_INLINE logger_return_t logger_file_rotate_request(logger_file_t *file);
+LOGGER_INLINE size_t logger_file_write(logger_file_t *file, const char *line, const size_t length, const logger_bool_t complete);
+LOGGER_INLINE logger_return_t logger_compress_start(void);
+LOGGER_INLINE logger_bool_t logger_compress_job_enqueue(logger_file_t *rotate, const char *path);
+LOGGER_INLINE void logger_compress_enqueue(const char *path);
+LOGGER_INLINE void logger_compress_rotate_wait(const logger_file_t *file);
+LOGGER_INLINE void logger_compress_cancel(const char *path);
+LOGGER_INLINE void logger_compress_drain(void);
+LOGGER_INLINE uint32_t logger_compress_get32(const uint8_t *buffer);
+LOGGER_INLINE long logger_lz_decompress(const uint8_t *input, const size_t size, uint8_t *output, const size_t capacity);
+LOGGER_INLINE void logger_recorder_put(logger_id_t id, logger_level_t level, const char *file, const char *function, uint32_t line, const char *message);
+LOGGER_INLINE void logger_recorder_message(logger_id_t id, logger_level_t level, const char *file, const char *function, uint32_t line, logger_kv_list_t *kv, const char *format, va_list argp);
+LOGGER_INLINE void logger_recorder_dump(int fd);
+LOGGER_INLINE uint32_t logger_recorder_checksum(const logger_recorder_record_t *record, const uint8_t *strings);
+LOGGER_INLINE logger_bool_t logger_recorder_valid(const uint8_t *buffer, const size_t size, const size_t position);
+LOGGER_INLINE size_t logger_recorder_scan(const uint8_t *buffer, const size_t size, size_t position);
+LOGGER_INLINE void logger_recorder_dump_record(logger_recorder_dump_t *dump, const logger_recorder_record_t *record);
+LOGGER_INLINE void logger_recorder_dump_newer(logger_recorder_dump_t *dump, const logger_recorder_record_t *record, uint32_t *sequence);
+LOGGER_INLINE void logger_recorder_dump_flush(logger_recorder_dump_t *dump);
+LOGGER_INLINE logger_return_t logger_format_message_quiet(char *message, size_t message_size, const char *format, va_list argp);
+LOGGER_INLINE void logger_format_quiet(char *message, size_t message_size, logger_kv_list_t *kv, const char *format, va_list argp);
+LOGGER_INLINE void logger_lazy_put(logger_id_t id, const logger_plan_t *plan, logger_level_t level, const char *file, const char *function, uint32_t line, const char *message);
+LOGGER_INLINE void logger_lazy_flush(logger_id_t id, const logger_plan_t *plan);
+LOGGER_INLINE void logger_lazy_drop(logger_id_t id);
+LOGGER_INLINE void logger_continuation_drop(logger_id_t id);
+LOGGER_INLINE logger_bool_t logger_print_lock(pthread_mutex_t *mutex);
+LOGGER_INLINE void logger_print_unlock(pthread_mutex_t *mutex);
+LOGGER_INLINE logger_bool_t logger_print_active(void);
+LOGGER_INLINE size_t logger_stats_shard(void);
+LOGGER_INLINE const char *logger_strip_path(const char *file);
+LOGGER_INLINE uint64_t logger_latency_now(void);
+LOGGER_INLINE void logger_latency_record(logger_histogram_t *histogram, uint64_t start);
+LOGGER_INLINE void logger_latency_call(uint64_t start);
+LOGGER_INLINE logger_histogram_t *logger_latency_output(const logger_output_t *output);
+LOGGER_INLINE logger_bool_t logger_site_claim(const char **slot_file, const char **slot_function, uint32_t *slot_line, const char *file, const char *function, uint32_t line);
+LOGGER_INLINE logger_profile_site_t *logger_profile_find(const char *file, const char *function, uint32_t line);
+LOGGER_INLINE logger_plan_reader_t *logger_plan_reader_claim(void);
+LOGGER_INLINE void logger_plan_read_lock(void);
+LOGGER_INLINE void logger_plan_read_unlock(void);
+LOGGER_INLINE logger_bool_t logger_plan_quiescent(uint32_t epoch);
+LOGGER_INLINE void logger_plan_wait(uint32_t epoch);
+LOGGER_INLINE void logger_plan_synchronize(void);
+LOGGER_INLINE logger_return_t logger_output_id(logger_id_t id, logger_level_t level, const logger_origin_t *origin, const char *prefix, const char *message, logger_kv_list_t *kv);
+LOGGER_INLINE size_t logger_id_find(const char *name);
+LOGGER_INLINE void logger_id_level_resolve(void);
+LOGGER_INLINE logger_bool_t logger_pattern_match(const char *pattern, const char *name);
+LOGGER_INLINE logger_level_t logger_level_parse(const char *name, size_t length);
+LOGGER_INLINE void logger_level_rule_apply(logger_id_t id);
+static void logger_recorder_crash_handler(int signal);
+static void logger_profile_exit(void);
+static void logger_builder_exit(void *value);
+static void logger_thread_key_create(void);
+static int logger_profile_compare(const void *first, const void *second);
+static void logger_output_stream_write(void *context, const logger_record_t *record, const char *line, size_t length);
+static void logger_output_stream_flush(void *context);
+static void logger_output_function_write(void *context, const logger_record_t *record, const char *line, size_t length);
+static void logger_output_record_write(void *context, const logger_record_t *record, const char *line, size_t length);
+
+/** Driver of file stream outputs */
+static const logger_output_driver_t logger_output_stream_driver = { logger_output_stream_write, NULL, logger_output_stream_flush, NULL };
+
+/** Driver of user function outputs */
+static const logger_output_driver_t logger_output_function_driver = { logger_output_function_write, NULL, NULL, NULL };
+
+/** Driver of user record function outputs */
+static const logger_output_driver_t logger_output_record_driver = { logger_output_record_write, NULL, NULL, NULL };
 
 
 /***************************************************************************//**
@@ -414,6 +1129,8 @@ logger_version_t logger_version(void)
  ******************************************************************************/
 logger_return_t logger_init(void)
 {
+  size_t index;
+
   if (logger_initialized == logger_false) {
     logger_initialized           = logger_true;
     logger_enabled               = logger_true;
@@ -421,16 +1138,72 @@ logger_return_t logger_init(void)
     logger_color_message_enabled = logger_false;
     (void)memcpy(logger_level_colors, logger_level_colors_console, sizeof(logger_level_colors));
     (void)memset(logger_control, 0, sizeof(logger_control));
+    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
+      logger_control[index].plan = &logger_control[index].plans[0];
+    }
     (void)memset(logger_outputs, 0, sizeof(logger_outputs));
+    (void)memset(logger_files,   0, sizeof(logger_files));
+    (void)memset(logger_lazy,    0, sizeof(logger_lazy));
+    (void)memset(logger_continuations, 0, sizeof(logger_continuations));
+    (void)memset(logger_builders, 0, sizeof(logger_builders));
+    (void)memset(logger_thread_levels, 0, sizeof(logger_thread_levels));
+    logger_thread_level = LOGGER_UNKNOWN;
     (void)memset(logger_message, 0, sizeof(logger_message));
     (void)memset(logger_prefix,  0, sizeof(logger_prefix));
 
+    /* initialize flight recorder */
+    logger_recorder.count    = 0;
+    logger_recorder.level    = LOGGER_UNKNOWN;
+    logger_recorder.buffer   = (uint8_t *)logger_recorder_storage;
+    logger_recorder.size     = sizeof(logger_recorder_storage);
+    logger_recorder.cursor   = 0;
+    logger_recorder.first    = 0;
+    logger_recorder.map      = NULL;
+    logger_recorder.map_size = 0;
+
     /* initialize limit variables */
     logger_limit.limit           = 0;
     logger_limit.counter         = 0;
     logger_limit.exceeded        = logger_false;
     logger_limit.message_request = logger_false;
     logger_limit.skipped         = 0;
+    logger_limit.exempt          = LOGGER_UNKNOWN;
+
+    /* initialize repeat detection */
+    logger_repeat_window         = 0;
+    logger_repeat.generation     = 0;
+    logger_repeat.pending        = 0;
+    logger_repeat.flush_interval = 0;
+    (void)memset(logger_fingerprints, 0, sizeof(logger_fingerprints));
+    (void)memset(logger_level_buckets, 0, sizeof(logger_level_buckets));
+
+    /* initialize call site limits */
+    (void)memset(logger_sites, 0, sizeof(logger_sites));
+
+    /* initialize call site profile */
+    logger_profile_enabled   = logger_false;
+    logger_profile_current   = NULL;
+    logger_profile_untracked = 0;
+    (void)memset(logger_profile_sites, 0, sizeof(logger_profile_sites));
+
+    /* initialize batch configuration */
+    logger_config_depth   = 0;
+    logger_config_unify   = logger_false;
+    logger_config_resolve = logger_false;
+
+    /* initialize level specification */
+    logger_level_rule_count = 0;
+    (void)memset(logger_level_rules, 0, sizeof(logger_level_rules));
+
+#ifdef LOGGER_LATENCY
+    /* initialize latency histograms */
+    (void)memset(&logger_latency_calls, 0, sizeof(logger_latency_calls));
+    (void)memset(logger_latency_outputs, 0, sizeof(logger_latency_outputs));
+#endif /* LOGGER_LATENCY */
+    logger_site_random = (uint32_t)logger_time_ms() ^ ((uint32_t)getpid() << 16) ^ 0x9E3779B9U;
+    if (logger_site_random == 0) {
+      logger_site_random = 1;
+    }
 
     /* initialize logger system ID */
     logger_control[logger_system_id].used    = logger_true;
@@ -440,6 +1213,13 @@ logger_return_t logger_init(void)
     logger_control[logger_system_id].prefix  = LOGGER_PREFIX_STANDARD;
     logger_control[logger_system_id].color   = logger_false;
     (void)strncpy(logger_control[logger_system_id].name, "LOGGER_SYSTEM", LOGGER_ELEMENTS(logger_control[logger_system_id].name));
+
+    /* publish the configuration of each ID */
+    logger_plan_mark(logger_id_unknown);
+    logger_plan_publish();
+
+    /* an invalid level specification from the environment is ignored */
+    (void)logger_id_level_spec_set(getenv("LOGGER_LEVELS"));
   }
 
   return(LOGGER_OK);
@@ -468,8 +1248,16 @@ logger_bool_t logger_is_initialized(void)
  ******************************************************************************/
 logger_return_t logger_enable(void)
 {
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
   logger_enabled = logger_true;
 
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
   return(LOGGER_OK);
 }
 
@@ -483,14 +1271,19 @@ logger_return_t logger_enable(void)
  ******************************************************************************/
 logger_return_t logger_disable(void)
 {
-  /* outputs will change, print repeat message */
-  logger_repeat_message();
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
 
-  /* outputs will change, print rate limit message */
-  logger_rate_limit_message(logger_true);
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
 
   logger_enabled = logger_false;
 
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
   return(LOGGER_OK);
 }
 
@@ -508,6 +1301,75 @@ logger_bool_t logger_is_enabled()
 }
 
 
+/***************************************************************************//**
+ * \brief  Begin a batch of configuration changes.
+ *
+ * Until the matching \c logger_config_commit() changes of outputs, IDs,
+ * levels, prefixes and colors are only recorded. Levels inherited from parent
+ * IDs are resolved and the configuration is published once by the commit
+ * instead of once per call. Queries return levels set for an ID immediately.
+ * Batches may be nested, only the outermost commit applies the changes.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_config_begin(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check nesting depth */
+  if (logger_config_depth == UINT16_MAX) {
+    return(LOGGER_ERR_SIZE_INVALID);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  logger_config_depth++;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Apply a batch of configuration changes.
+ *
+ * Ends the batch started by \c logger_config_begin(). The outermost commit
+ * resolves inherited levels and unifies outputs once if anything changed.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_config_commit(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for batch */
+  if (logger_config_depth == 0) {
+    return(LOGGER_ERR_NOT_STARTED);
+  }
+
+  logger_config_depth--;
+
+  if (logger_config_depth == 0) {
+    if (logger_config_resolve == logger_true) {
+      logger_config_resolve = logger_false;
+      logger_id_level_resolve();
+    }
+
+    if (logger_config_unify == logger_true) {
+      logger_plan_publish();
+    }
+  }
+
+  return(LOGGER_OK);
+}
+
+
 /***************************************************************************//**
  * \brief  Set global logging prefix.
  *
@@ -520,6 +1382,11 @@ logger_bool_t logger_is_enabled()
  ******************************************************************************/
 logger_return_t logger_prefix_set(const logger_prefix_t prefix)
 {
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
   /* GUARD: check for valid prefix */
   if ((prefix < LOGGER_PFX_EMPTY) ||
       (prefix > LOGGER_PFX_UNSET)) {
@@ -534,6 +1401,9 @@ logger_return_t logger_prefix_set(const logger_prefix_t prefix)
     logger_prefix_standard = prefix;
   }
 
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
   return(LOGGER_OK);
 }
 
@@ -564,7 +1434,14 @@ logger_prefix_t logger_prefix_get(void)
  ******************************************************************************/
 logger_return_t logger_rate_limit_set(const logger_rate_limit_t limit)
 {
-  logger_limit.limit = limit;
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_limit_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  LOGGER_ATOMIC_STORE(&logger_limit.limit, limit);
+
+  logger_print_unlock(&logger_limit_mutex);
 
   return(LOGGER_OK);
 }
@@ -584,2890 +1461,10867 @@ logger_rate_limit_t logger_rate_limit_get(void)
 
 
 /***************************************************************************//**
- * \brief  Unify outputs for IDs
+ * \brief  Set window for repeat detection
  *
- * Merge all possible outputs of all IDs into one list. During merge make every
- * output unique.
+ * Besides consecutive repeats, a message that repeats a message printed within
+ * the last \p window milliseconds is suppressed, even if other messages were
+ * printed in between. Messages are compared by ID, level, call site and a hash
+ * of the formatted message. The number of suppressed repeats is printed when
+ * the message appears again after the window. A value of `0` disables it.
+ *
+ * \param[in]     window  Window in milliseconds.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_output_common_unify(void)
+logger_return_t logger_repeat_window_set(const uint32_t window)
 {
-  size_t id_index;
-  size_t unified_index;
-  size_t global_index;
-  size_t specific_index;
-
-  /* loop over all IDs */
-  for (id_index = 0 ; id_index < LOGGER_ELEMENTS(logger_control) ; id_index++) {
-    if (logger_control[id_index].used == logger_true) {
-      /* reset list of unified outputs */
-      memset(logger_control[id_index].unified_outputs, 0, sizeof(logger_control[id_index].unified_outputs));
-
-      /* loop over all global outputs */
-      for (global_index = 0 ; global_index < LOGGER_ELEMENTS(logger_outputs) ; global_index++)
-      {
-        /* if global output is valid */
-        if (logger_outputs[global_index].count > 0) {
-          /* search this global output in unified outputs */
-          for (unified_index = 0 ; unified_index < LOGGER_ELEMENTS(logger_control[id_index].unified_outputs) ; unified_index++) {
-            /* if this unified entry is used */
-            if (logger_control[id_index].unified_outputs[unified_index].count != 0) {
-              /* if it is the same then current global output has been added already*/
-              if (((logger_outputs[global_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-                   (logger_control[id_index].unified_outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-                   (logger_control[id_index].unified_outputs[unified_index].stream == logger_outputs[global_index].stream)) ||
-                  ((logger_outputs[global_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-                   (logger_control[id_index].unified_outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-                   (logger_control[id_index].unified_outputs[unified_index].function == logger_outputs[global_index].function))) {
-                logger_control[id_index].unified_outputs[unified_index].use_color |= logger_outputs[global_index].use_color;
-                logger_control[id_index].unified_outputs[unified_index].level     |= logger_outputs[global_index].level;
-                break;
-              }
-            }
-            else {
-              /* if this unified entry is not used the global output has not been added to unified list */
-              logger_control[id_index].unified_outputs[unified_index]       = logger_outputs[global_index];
-              logger_control[id_index].unified_outputs[unified_index].count = 1;
-              break;
-            }
-          }
-        }
-      }
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_repeat_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
 
-      /* loop over all ID specific outputs */
-      for (specific_index = 0 ; specific_index < LOGGER_ELEMENTS(logger_control[id_index].outputs) ; specific_index++)
-      {
-        /* if ID specific output is valid */
-        if (logger_control[id_index].outputs[specific_index].count > 0) {
-          /* search this ID specific output in unified outputs */
-          for (unified_index = 0 ; unified_index < LOGGER_ELEMENTS(logger_control[id_index].unified_outputs) ; unified_index++) {
-            /* if this unified entry is used */
-            if (logger_control[id_index].unified_outputs[unified_index].count != 0) {
-              /* if it is the same then current ID specific output has been added already*/
-              if (((logger_control[id_index].outputs[specific_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-                   (logger_control[id_index].unified_outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-                   (logger_control[id_index].unified_outputs[unified_index].stream == logger_control[id_index].outputs[specific_index].stream)) ||
-                  ((logger_control[id_index].outputs[specific_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-                   (logger_control[id_index].unified_outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-                   (logger_control[id_index].unified_outputs[unified_index].function == logger_control[id_index].outputs[specific_index].function))) {
-                logger_control[id_index].unified_outputs[unified_index].use_color |= logger_control[id_index].outputs[specific_index].use_color;
-                logger_control[id_index].unified_outputs[unified_index].level     |= logger_control[id_index].outputs[specific_index].level;
-                break;
-              }
-            }
-            else {
-              /* if this unified entry is not used the ID specific output has not been added to unified list */
-              logger_control[id_index].unified_outputs[unified_index]       = logger_control[id_index].outputs[specific_index];
-              logger_control[id_index].unified_outputs[unified_index].count = 1;
-              break;
-            }
-          }
-        }
-      }
-    }
+  /* print suppressed repeats of the previous window */
+  if (window == 0) {
+    logger_fingerprint_drop(logger_id_unknown);
   }
 
+  LOGGER_ATOMIC_STORE(&logger_repeat_window, window);
+
+  logger_print_unlock(&logger_repeat_mutex);
+
   return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Register an output to a list of outputs.
+ * \brief  Query window for repeat detection
  *
- * The given file stream may be on of \c stdout, \c stderr or a file stream
- * opened by the user. The user provided function must take a single string
- * argument. The default logging level is set to \c LOGGER_UNKNOWN thus no
- * messages will appear on this stream.
+ * \return        Window in milliseconds, 0 if disabled.
+ ******************************************************************************/
+uint32_t logger_repeat_window_get(void)
+{
+  return(logger_repeat_window);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set interval for printing pending repeats
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
+ * See logger_repeat_flush().
+ *
+ * \param[in]     interval  Interval in milliseconds.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_output_common_register(logger_output_t          *outputs,
-                                                            const size_t             size,
-                                                            logger_output_type_t     type,
-                                                            FILE                     *stream,
-                                                            logger_output_function_t function)
+logger_return_t logger_repeat_flush_interval_set(const uint32_t interval)
 {
-  logger_return_t ret = LOGGER_OK;
-  size_t          index;
-  logger_bool_t   found;
-
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_ERR_TYPE_INVALID);
-  }
-
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_ERR_STREAM_INVALID);
-  }
-
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_ERR_FUNCTION_INVALID);
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_repeat_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
   }
 
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
-    return(LOGGER_ERR_OUTPUT_INVALID);
-  }
+  logger_repeat.flush_interval = interval;
 
-  /* check if this output stream is already registered */
-  found = logger_false;
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-        (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))){
-      found = logger_true;
-      break;
-    }
-  }
+  logger_print_unlock(&logger_repeat_mutex);
 
-  /* output is already registered */
-  if (found == logger_true) {
-    outputs[index].count++;
-    ret = LOGGER_ERR_OUTPUT_REGISTERED;
-  }
-  /* output is not registered */
-  else {
-    /* search for an empty slot */
-    found = logger_false;
-    for (index = 0 ; index < size ; index++) {
-      if (outputs[index].count == 0) {
-        found = logger_true;
-        break;
-      }
-    }
+  return(LOGGER_OK);
+}
 
-    /* found an empty slot */
-    if (found == logger_true) {
-      /* outputs will change, print repeat message */
-      logger_repeat_message();
 
-      /* outputs will change, print rate limit message */
-      logger_rate_limit_message(logger_true);
+/***************************************************************************//**
+ * \brief  Query interval for printing pending repeats
+ *
+ * \return        Interval in milliseconds.
+ ******************************************************************************/
+uint32_t logger_repeat_flush_interval_get(void)
+{
+  return(logger_repeat.flush_interval);
+}
 
-      outputs[index].count++;
-      outputs[index].level     = LOGGER_UNKNOWN;
-      outputs[index].use_color = logger_false;
-      outputs[index].type      = type;
 
-      switch (type) {
-        case LOGGER_OUTPUT_TYPE_UNKNOWN:
-          /* nothing */
-          break;
+/***************************************************************************//**
+ * \brief  Print repeats pending for the flush interval
+ *
+ * The number of repeats of a message is only printed when another message
+ * arrives. If a program goes quiet after repeating a message the number is
+ * never printed. Call this function from a timer or main loop to print
+ * repeats pending for at least the interval set by
+ * logger_repeat_flush_interval_set(). Logging itself doesn't look at the
+ * time for this. A consecutive repeat is noticed by the first call and printed
+ * by the first call after the interval, so it is printed within twice the
+ * interval if the function is called at least once per interval.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_repeat_flush(void)
+{
+  uint64_t now;
+  size_t   index;
 
-        case LOGGER_OUTPUT_TYPE_FILESTREAM:
-          outputs[index].stream = stream;
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_repeat_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
 
-          /* only stdout and stderr use color by default */
-          if ((stream == stdout) ||
-              (stream == stderr)) {
-            outputs[index].use_color = logger_true;
-          }
-          break;
+  now = logger_time_ms();
 
-        case LOGGER_OUTPUT_TYPE_FUNCTION:
-          outputs[index].function = function;
-          break;
+  /* consecutive repeats */
+  if (logger_repeat.count == 0) {
+    logger_repeat.pending = 0;
+  }
+  else {
+    if ((logger_repeat.pending == 0) ||
+        (logger_repeat.pending_generation != logger_repeat.generation)) {
+      logger_repeat.pending            = now;
+      logger_repeat.pending_generation = logger_repeat.generation;
+    }
 
-        case LOGGER_OUTPUT_TYPE_MAX:
-          /* nothing */
-          break;
-      }
+    if ((now - logger_repeat.pending) >= logger_repeat.flush_interval) {
+      logger_repeat_message();
+      logger_repeat.pending = 0;
     }
-    else {
-      ret = LOGGER_ERR_OUTPUTS_FULL;
+  }
+
+  /* interleaved repeats, the message stays suppressed during its window */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_fingerprints) ; index++) {
+    if ((logger_fingerprints[index].file != NULL) &&
+        (logger_fingerprints[index].count > 0) &&
+        ((now - logger_fingerprints[index].reported) >= logger_repeat.flush_interval)) {
+      logger_fingerprint_message(&logger_fingerprints[index]);
+      logger_fingerprints[index].reported = now;
     }
   }
 
-  return(ret);
+  logger_print_unlock(&logger_repeat_mutex);
+
+  return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Deregister an output from a list of outputs.
+ * \brief  Set level exempt from rate limits
  *
- * Remove given output from list of outputs.
+ * Messages with the given level or higher are never skipped because of a rate
+ * limit. \c LOGGER_UNKNOWN makes all messages subject to rate limits.
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
+ * \param[in]     level   Lowest level never skipped.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_output_common_deregister(logger_output_t          *outputs,
-                                                              const size_t             size,
-                                                              logger_output_type_t     type,
-                                                              FILE                     *stream,
-                                                              logger_output_function_t function)
+logger_return_t logger_rate_limit_exempt_set(const logger_level_t level)
 {
-  logger_return_t ret = LOGGER_OK;
-  size_t          index;
-  logger_bool_t   found;
-
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_ERR_TYPE_INVALID);
-  }
-
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_ERR_STREAM_INVALID);
+  /* GUARD: check for valid level */
+  if (((level & ~LOGGER_ALL) != 0) ||
+      ((level & (level - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
   }
 
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_ERR_FUNCTION_INVALID);
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_limit_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
   }
 
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
-    return(LOGGER_ERR_OUTPUT_INVALID);
+  if (level == LOGGER_UNKNOWN) {
+    LOGGER_ATOMIC_STORE(&logger_limit.exempt, LOGGER_UNKNOWN);
   }
-
-  /* check if this output is registered */
-  found = logger_false;
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-        (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))){
-      found = logger_true;
-      break;
-    }
+  else {
+    LOGGER_ATOMIC_STORE(&logger_limit.exempt, LOGGER_ALL ^ (level - 1));
   }
 
-  /* found given output in a slot */
-  if (found == logger_true) {
-    outputs[index].count--;
-
-    /* remove this output if this was the last reference */
-    if (outputs[index].count <= 0) {
-      /* outputs will change, print repeat message */
-      logger_repeat_message();
+  logger_print_unlock(&logger_limit_mutex);
 
-      /* outputs will change, print rate limit message */
-      logger_rate_limit_message(logger_true);
+  return(LOGGER_OK);
+}
 
-      /* flush everything in this stream */
-      if (type == LOGGER_OUTPUT_TYPE_FILESTREAM) {
-        fflush(outputs[index].stream);
-      }
 
-      /* reset output to default values */
-      outputs[index].count     = 0;
-      outputs[index].level     = LOGGER_UNKNOWN;
-      outputs[index].use_color = logger_false;
-      outputs[index].type      = LOGGER_OUTPUT_TYPE_UNKNOWN;
-      outputs[index].stream    = (FILE *)NULL;
-      outputs[index].function  = (logger_output_function_t)NULL;
-    }
-  }
-  else {
-    ret = LOGGER_ERR_OUTPUT_NOT_FOUND;
+/***************************************************************************//**
+ * \brief  Query level exempt from rate limits
+ *
+ * \return        Lowest level never skipped, \c LOGGER_UNKNOWN if none.
+ ******************************************************************************/
+logger_level_t logger_rate_limit_exempt_get(void)
+{
+  if (logger_limit.exempt == LOGGER_UNKNOWN) {
+    return(LOGGER_UNKNOWN);
   }
 
-  return(ret);
+  return(LOGGER_ALL ^ (logger_limit.exempt - 1));
 }
 
 
 /***************************************************************************//**
- * \brief  Search an output in a list of outputs.
+ * \brief  Set rate limit for level
  *
- * The given output is searched in the given list of outputs.
+ * Limit the messages of the given level of all IDs with a token bucket. The
+ * bucket holds up to \p burst messages and is refilled with \p rate messages
+ * per second. Only printed messages take a token, suppressed repeats don't. A
+ * rate of `0` disables the limit.
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
+ * \param[in]     level   Level to limit.
+ * \param[in]     rate    Messages per second.
+ * \param[in]     burst   Messages printed at once.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_bool_t logger_output_common_is_registered(logger_output_t          *outputs,
-                                                               const size_t             size,
-                                                               logger_output_type_t     type,
-                                                               FILE                     *stream,
-                                                               logger_output_function_t function)
+logger_return_t logger_level_rate_limit_set(const logger_level_t      level,
+                                            const logger_rate_limit_t rate,
+                                            const logger_rate_limit_t burst)
 {
-  logger_bool_t ret = logger_false;
-  size_t        index;
-
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_ERR_TYPE_INVALID);
+  /* GUARD: check for valid level, a single level is needed */
+  if ((level == 0) ||
+      ((level & ~LOGGER_ALL) != 0) ||
+      ((level & (level - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
   }
 
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_ERR_STREAM_INVALID);
+  /* GUARD: check for valid burst */
+  if ((rate > 0) &&
+      (burst == 0)) {
+    return(LOGGER_ERR_SIZE_INVALID);
   }
 
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_ERR_FUNCTION_INVALID);
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_limit_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
   }
 
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
-    return(logger_false);
-  }
+  logger_bucket_set(&logger_level_buckets[logger_level_to_index(level)], rate, burst);
 
-  /* check if this output stream is registered */
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-        (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))){
-      ret = logger_true;
-      break;
-    }
-  }
+  logger_print_unlock(&logger_limit_mutex);
 
-  return(ret);
+  return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level for output in a list of outputs.
+ * \brief  Query rate limit for level
  *
- * Set the minimum logging level for given output. Only log messages
- * equal or above the given level will be printed to the given output.
+ * \param[in]     level   Level to query.
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
- * \param[in]     level     Level to set.
+ * \return        Messages per second, 0 if unlimited.
+ ******************************************************************************/
+logger_rate_limit_t logger_level_rate_limit_get(const logger_level_t level)
+{
+  return(LOGGER_ATOMIC_LOAD(&logger_level_buckets[logger_level_to_index(level)].rate));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query message counters.
+ *
+ * Sum up the counters of the given ID for all levels set in the given level
+ * mask. Counters are kept next to the other data of an ID and are reset when
+ * the ID is requested for the first time. Threads count in one of
+ * \c LOGGER_STATS_SHARDS copies, so they don't share cache lines, the copies
+ * are added up here.
+ *
+ * \param[in]     id      Logger ID, \c logger_id_unknown for all IDs.
+ * \param[in]     level   Level mask to query.
+ * \param[out]    stats   Counters.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_output_common_level_set(logger_output_t          *outputs,
-                                                             const size_t             size,
-                                                             logger_output_type_t     type,
-                                                             FILE                     *stream,
-                                                             logger_output_function_t function,
-                                                             const logger_level_t     level)
+logger_return_t logger_stats_get(const logger_id_t    id,
+                                 const logger_level_t level,
+                                 logger_stats_t       *stats)
 {
-  logger_return_t ret = LOGGER_OK;
-  size_t          index;
-  logger_bool_t   found;
-
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_ERR_TYPE_INVALID);
-  }
+  const logger_stats_t *counters;
+  size_t               id_index;
+  size_t               shard;
+  size_t               index;
 
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_ERR_STREAM_INVALID);
+  /* GUARD: check for valid ID */
+  if ((id != logger_id_unknown) &&
+      ((id < 0) ||
+       (id == logger_system_id) ||
+       (id >= LOGGER_ELEMENTS(logger_control)) ||
+       (logger_control[id].used == logger_false))) {
+    return(LOGGER_ERR_ID_UNKNOWN);
   }
 
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_ERR_FUNCTION_INVALID);
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
   }
 
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
+  /* GUARD: check for valid stats */
+  if (stats == NULL) {
     return(LOGGER_ERR_OUTPUT_INVALID);
   }
 
-  /* check if this output is registered */
-  found = logger_false;
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-        (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))){
-      found = logger_true;
-      break;
+  (void)memset(stats, 0, sizeof(*stats));
+
+  for (id_index = 0 ; id_index < LOGGER_ELEMENTS(logger_control) ; id_index++) {
+    if ((logger_control[id_index].used == logger_true) &&
+        ((id == logger_id_unknown) || (id_index == (size_t)id))) {
+      for (shard = 0 ; shard < LOGGER_ELEMENTS(logger_control[id_index].stats) ; shard++) {
+        for (index = 0 ; index < LOGGER_ELEMENTS(logger_control[id_index].stats[shard]) ; index++) {
+          if ((logger_index_to_level(index) & level) != 0) {
+            counters = &logger_control[id_index].stats[shard][index];
+
+            stats->accepted          += LOGGER_COUNTER_GET(&counters->accepted);
+            stats->filtered          += LOGGER_COUNTER_GET(&counters->filtered);
+            stats->emitted           += LOGGER_COUNTER_GET(&counters->emitted);
+            stats->rate_limited      += LOGGER_COUNTER_GET(&counters->rate_limited);
+            stats->repeat_suppressed += LOGGER_COUNTER_GET(&counters->repeat_suppressed);
+            stats->truncated         += LOGGER_COUNTER_GET(&counters->truncated);
+          }
+        }
+      }
     }
   }
 
-  /* found given output in a slot */
-  if (found == logger_true) {
-    /* outputs will change, print repeat message */
-    logger_repeat_message();
-
-    /* outputs will change, print rate limit message */
-    logger_rate_limit_message(logger_true);
-
-    /* set log level */
-    outputs[index].level = level;
-  }
-  else {
-    ret = LOGGER_ERR_OUTPUT_NOT_FOUND;
-  }
+  return(LOGGER_OK);
+}
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
 
-  return(ret);
+/***************************************************************************//**
+ * \brief  Clear counters of an output.
+ *
+ * \param[out]    stats   Counters.
+ ******************************************************************************/
+LOGGER_INLINE void logger_output_stats_clear(logger_output_stats_t *stats)
+{
+  LOGGER_COUNTER_SET(&stats->lines, 0);
+  LOGGER_COUNTER_SET(&stats->bytes, 0);
+  LOGGER_COUNTER_SET(&stats->errors, 0);
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level for output stream in a list of outputs.
- *
- * Query the currently set minimum level for the given logging output stream.
+ * \brief  Reset message counters.
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
+ * Reset the counters of all IDs, all outputs and of the queue of background
+ * rotation and compression.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_level_t logger_output_common_level_get(logger_output_t          *outputs,
-                                                            const size_t             size,
-                                                            logger_output_type_t     type,
-                                                            FILE                     *stream,
-                                                            logger_output_function_t function)
+logger_return_t logger_stats_reset(void)
 {
-  logger_level_t ret = LOGGER_UNKNOWN;
+  logger_stats_t *stats;
+  size_t         id;
+  size_t         shard;
   size_t         index;
 
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_UNKNOWN);
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_outputs) ; index++) {
+    logger_output_stats_clear(&logger_outputs[index].stats);
   }
 
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_UNKNOWN);
-  }
+  for (id = 0 ; id < LOGGER_ELEMENTS(logger_control) ; id++) {
+    for (shard = 0 ; shard < LOGGER_ELEMENTS(logger_control[id].stats) ; shard++) {
+      for (index = 0 ; index < LOGGER_ELEMENTS(logger_control[id].stats[shard]) ; index++) {
+        stats = &logger_control[id].stats[shard][index];
+
+        LOGGER_COUNTER_SET(&stats->accepted, 0);
+        LOGGER_COUNTER_SET(&stats->filtered, 0);
+        LOGGER_COUNTER_SET(&stats->emitted, 0);
+        LOGGER_COUNTER_SET(&stats->rate_limited, 0);
+        LOGGER_COUNTER_SET(&stats->repeat_suppressed, 0);
+        LOGGER_COUNTER_SET(&stats->truncated, 0);
+      }
+    }
 
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_UNKNOWN);
+    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control[id].outputs) ; index++) {
+      logger_output_stats_clear(&logger_control[id].outputs[index].stats);
+    }
   }
 
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
-    return(LOGGER_UNKNOWN);
-  }
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+  logger_compress.peak    = logger_compress.count;
+  logger_compress.dropped = 0;
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
 
-  /* check if this output is registered */
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-         (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))) {
-      ret = outputs[index].level;
-      break;
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Claim a reader slot for the calling thread.
+ *
+ * The slot is given back when the thread exits. Threads finding no free slot
+ * share \c logger_plan_overflow_lock instead.
+ *
+ * \return        Slot of the thread or \c logger_plan_overflow.
+ ******************************************************************************/
+LOGGER_INLINE logger_plan_reader_t *logger_plan_reader_claim(void)
+{
+  uint32_t expected;
+  size_t   index;
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_plan_readers) ; index++) {
+    expected = 0;
+    if ((LOGGER_ATOMIC_LOAD(&logger_plan_readers[index].used) == 0) &&
+        (LOGGER_ATOMIC_SWAP(&logger_plan_readers[index].used, &expected, 1))) {
+      logger_plan_reader = &logger_plan_readers[index];
+
+      /* give the slot back when the thread exits */
+      (void)pthread_once(&logger_thread_once, logger_thread_key_create);
+      (void)pthread_setspecific(logger_thread_key, logger_plan_reader);
+
+      return(logger_plan_reader);
     }
   }
 
-  return(ret);
+  LOGGER_ATOMIC_STORE(&logger_plan_overflow_used, logger_true);
+  logger_plan_reader = &logger_plan_overflow;
+
+  return(logger_plan_reader);
 }
 
 
 /***************************************************************************//**
- * \brief  Modify the output color setting.
+ * \brief  Start reading output plans.
  *
- * Set the color setting for a given output to the given state.
+ * Plans loaded until \c logger_plan_read_unlock() stay valid even if a new
+ * plan is published meanwhile. Calls may be nested.
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
- * \param[in]     flag      State of color setting.
- *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * The thread only announces the epoch in its own slot, the fence orders this
+ * store before loading any plan. A writer checking the slot after its own
+ * fence either sees the epoch or this thread loads the new plans.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_output_common_color(logger_output_t          *outputs,
-                                                         const size_t             size,
-                                                         logger_output_type_t     type,
-                                                         FILE                     *stream,
-                                                         logger_output_function_t function,
-                                                         logger_bool_t            flag)
+LOGGER_INLINE void logger_plan_read_lock(void)
 {
-  logger_return_t ret = LOGGER_OK;
-  size_t          index;
+  logger_plan_reader_t *reader;
 
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_ERR_TYPE_INVALID);
+  /* GUARD: plans of the outer read stay valid */
+  if (logger_plan_depth++ > 0) {
+    return;
   }
 
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_ERR_STREAM_INVALID);
+  reader = logger_plan_reader;
+  if (reader == NULL) {
+    reader = logger_plan_reader_claim();
   }
 
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_ERR_FUNCTION_INVALID);
+  if (reader == &logger_plan_overflow) {
+    (void)pthread_rwlock_rdlock(&logger_plan_overflow_lock);
   }
-
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
-    return(LOGGER_ERR_OUTPUT_INVALID);
+  else {
+    LOGGER_COUNTER_SET(&reader->epoch, LOGGER_ATOMIC_LOAD(&logger_plan_epoch));
+    LOGGER_ATOMIC_FENCE();
   }
+}
 
-  /* check if this output is registered */
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-        (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))){
-      /* set color flag */
-      outputs[index].use_color = flag;
-      break;
-    }
-  }
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+/***************************************************************************//**
+ * \brief  Stop reading output plans.
+ ******************************************************************************/
+LOGGER_INLINE void logger_plan_read_unlock(void)
+{
+  /* GUARD: plans of the outer read are still used */
+  if (--logger_plan_depth > 0) {
+    return;
+  }
 
-  return(ret);
+  if (logger_plan_reader == &logger_plan_overflow) {
+    (void)pthread_rwlock_unlock(&logger_plan_overflow_lock);
+  }
+  else {
+    LOGGER_ATOMIC_RELEASE(&logger_plan_reader->epoch, 0);
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Query the output color setting.
+ * \brief  Check if plans replaced in an epoch are unused.
  *
- * Query the color setting for a given output.
+ * Plans replaced when \c logger_plan_epoch was set to \p epoch are unused if
+ * every thread reading plans started in this epoch or later. Epochs are
+ * compared by their difference, so they may wrap.
  *
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in,out] outputs   List of logger outputs.
- * \param[in]     size      Number of elements in list.
- * \param[in]     type      Type of output.
- * \param[in]     stream    Opened file stream.
- * \param[in]     function  User provided output function.
+ * \param[in]     epoch   Epoch the plans were replaced, 0 if never published.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \return        \c logger_true if no thread reads the plans anymore.
  ******************************************************************************/
-LOGGER_INLINE logger_bool_t logger_output_common_color_is_enabled(logger_output_t          *outputs,
-                                                                  const size_t             size,
-                                                                  logger_output_type_t     type,
-                                                                  FILE                     *stream,
-                                                                  logger_output_function_t function)
+LOGGER_INLINE logger_bool_t logger_plan_quiescent(uint32_t epoch)
 {
-  logger_bool_t ret = logger_false;
-  size_t        index;
-
-  /* GUARD: check for valid type */
-  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
-      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
-    return(LOGGER_ERR_TYPE_INVALID);
-  }
+  uint32_t reader_epoch;
+  size_t   index;
 
-  /* GUARD: check for valid stream */
-  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-      (stream == NULL)) {
-    return(LOGGER_ERR_STREAM_INVALID);
+  /* GUARD: plans never published */
+  if (epoch == 0) {
+    return(logger_true);
   }
 
-  /* GUARD: check for valid function */
-  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-      (function == NULL)) {
-    return(LOGGER_ERR_FUNCTION_INVALID);
-  }
+  /* pairs with the fence of logger_plan_read_lock() */
+  LOGGER_ATOMIC_FENCE();
 
-  /* GUARD: check for valid output */
-  if (outputs == NULL) {
-    return(logger_false);
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_plan_readers) ; index++) {
+    reader_epoch = LOGGER_ATOMIC_LOAD(&logger_plan_readers[index].epoch);
+    if ((reader_epoch != 0) && ((int32_t)(reader_epoch - epoch) < 0)) {
+      return(logger_false);
+    }
   }
 
-  /* check if this output is registered */
-  for (index = 0 ; index < size ; index++) {
-    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
-        (outputs[index].stream == stream)) ||
-        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
-         (outputs[index].function == function))){
-      ret = outputs[index].use_color;
-      break;
+  /* threads without a slot hold the lock while reading */
+  if (LOGGER_ATOMIC_LOAD(&logger_plan_overflow_used) == logger_true) {
+    if (pthread_rwlock_trywrlock(&logger_plan_overflow_lock) != 0) {
+      return(logger_false);
     }
+    (void)pthread_rwlock_unlock(&logger_plan_overflow_lock);
   }
 
-  return(ret);
+  return(logger_true);
 }
 
 
 /***************************************************************************//**
- * \brief  Register a global output stream.
- *
- * The given file stream may be on of \c stdout, \c stderr or a file stream
- * opened by the user. The default logging level is set to \c LOGGER_UNKNOWN thus
- * no messages will appear on this stream.
+ * \brief  Wait until plans replaced in an epoch are unused.
  *
- * \param[in]     stream  Opened file stream.
+ * Usually the plans have been unused long before, so this returns at once.
+ * Must never be called while reading plans.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     epoch   Epoch the plans were replaced, 0 if never published.
  ******************************************************************************/
-logger_return_t logger_output_register(FILE *stream)
+LOGGER_INLINE void logger_plan_wait(uint32_t epoch)
 {
-  logger_return_t ret = LOGGER_OK;
-
-  /* add stream to global outputs */
-  ret = logger_output_common_register(logger_outputs,
-                                      LOGGER_ELEMENTS(logger_outputs),
-                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                      stream,
-                                      (logger_output_function_t)NULL);
-
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
-
-  return(ret);
+  while (logger_plan_quiescent(epoch) == logger_false) {
+    (void)sched_yield();
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Deregister a global output stream.
- *
- * Remove given file stream from list of outputs.
- *
- * \param[in]     stream  Previous registered file stream.
+ * \brief  Wait until previous output plans are unused.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * Waits until all threads which started reading plans before the latest
+ * publish have finished. Used before outputs are closed or IDs are reused,
+ * never while reading plans.
  ******************************************************************************/
-logger_return_t logger_output_deregister(FILE *stream)
+LOGGER_INLINE void logger_plan_synchronize(void)
 {
-  logger_return_t ret = LOGGER_OK;
-
-  /* delete stream from global outputs */
-  ret = logger_output_common_deregister(logger_outputs,
-                                        LOGGER_ELEMENTS(logger_outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL);
-
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
-
-  return(ret);
+  logger_plan_wait(LOGGER_ATOMIC_LOAD(&logger_plan_epoch));
 }
 
 
 /***************************************************************************//**
- * \brief  Search an output stream in list of global outputs.
+ * \brief  Add output to output plan
  *
- * The given file stream is searched in the list of global outputs.
- *
- * \param[in]     stream  File stream.
+ * Copy the registered output without its counters, they are updated by
+ * printing threads meanwhile. The copy counts into them by \c counters.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \param[out]    unified  Unified output of plan.
+ * \param[in]     output   Registered output.
  ******************************************************************************/
-logger_bool_t logger_output_is_registered(FILE *stream)
+LOGGER_INLINE void logger_plan_output_set(logger_output_t       *unified,
+                                          const logger_output_t *output)
 {
-  /* search stream in global outputs */
-  return(logger_output_common_is_registered(logger_outputs,
-                                            LOGGER_ELEMENTS(logger_outputs),
-                                            LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                            stream,
-                                            (logger_output_function_t)NULL));
+  (void)memcpy(unified, output, offsetof(logger_output_t, stats));
+  unified->counters = output->counters;
+  unified->latency  = output->latency;
+  unified->count    = 1;
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level for global output stream.
+ * \brief  Build output plan of an ID
  *
- * Set the minimum logging level for given output stream. Only log messages
- * equal or above the given level will be printed to the given stream.
- *
- * \param[in]     stream  Previous registered file stream.
- * \param[in]     level   Level to set.
+ * Take a snapshot of the enable state, levels, prefixes and colors of the ID.
+ * Merge all possible outputs of the ID into one list. During merge make every
+ * output unique. Released IDs get a plan printing nothing.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[out]    plan          Plan not read by any thread.
+ * \param[in]     id_index      Index of ID.
+ * \param[in]     level_colors  Color strings of the levels read by the plan.
  ******************************************************************************/
-logger_return_t logger_output_level_set(FILE                 *stream,
-                                        const logger_level_t level)
+LOGGER_INLINE void logger_plan_build(logger_plan_t               *plan,
+                                     size_t                      id_index,
+                                     const logger_color_string_t *level_colors)
 {
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0 &&
-      (level & (level - 1)) == 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  size_t unified_index;
+  size_t global_index;
+  size_t specific_index;
+
+  /* reset list of unified outputs */
+  memset(plan, 0, sizeof(*plan));
+  plan->level_colors = level_colors;
+
+  /* GUARD: released IDs print nothing */
+  if (logger_control[id_index].used == logger_false) {
+    return;
+  }
+
+  /* configuration of the ID */
+  plan->enabled         = ((logger_enabled == logger_true) && (logger_control[id_index].enabled == logger_true)) ? logger_true : logger_false;
+  plan->level           = logger_control[id_index].level;
+  plan->prefix          = logger_control[id_index].prefix;
+  plan->prefix_standard = logger_prefix_standard;
+  plan->color_prefix    = logger_color_prefix_enabled;
+  plan->color_message   = logger_color_message_enabled;
+  plan->color_string    = logger_control[id_index].color_string;
+
+  /* loop over all global outputs */
+  for (global_index = 0 ; global_index < LOGGER_ELEMENTS(logger_outputs) ; global_index++)
+  {
+    /* if global output is valid */
+    if (logger_outputs[global_index].count > 0) {
+      /* search this global output in unified outputs */
+      for (unified_index = 0 ; unified_index < LOGGER_ELEMENTS(plan->outputs) ; unified_index++) {
+        /* if this unified entry is used */
+        if (plan->outputs[unified_index].count != 0) {
+          /* if it is the same then current global output has been added already*/
+          if (((logger_outputs[global_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+               (plan->outputs[unified_index].stream == logger_outputs[global_index].stream)) ||
+              ((logger_outputs[global_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+               (plan->outputs[unified_index].function == logger_outputs[global_index].function)) ||
+              ((logger_outputs[global_index].type == LOGGER_OUTPUT_TYPE_DRIVER) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_DRIVER) &&
+               (plan->outputs[unified_index].driver == logger_outputs[global_index].driver) &&
+               (plan->outputs[unified_index].context == logger_outputs[global_index].context)) ||
+              ((logger_outputs[global_index].type == LOGGER_OUTPUT_TYPE_RECORD) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_RECORD) &&
+               (plan->outputs[unified_index].record_function == logger_outputs[global_index].record_function))) {
+            plan->outputs[unified_index].use_color |= logger_outputs[global_index].use_color;
+            plan->outputs[unified_index].level     |= logger_outputs[global_index].level;
+            break;
+          }
+        }
+        else {
+          /* if this unified entry is not used the global output has not been added to unified list */
+          logger_plan_output_set(&plan->outputs[unified_index], &logger_outputs[global_index]);
+          break;
+        }
+      }
+    }
   }
 
-  /* set stream output level to global outputs */
-  return(logger_output_common_level_set(logger_outputs,
-                                        LOGGER_ELEMENTS(logger_outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL,
-                                        LOGGER_ALL ^ (level - 1)));
+  /* loop over all ID specific outputs */
+  for (specific_index = 0 ; specific_index < LOGGER_ELEMENTS(logger_control[id_index].outputs) ; specific_index++)
+  {
+    /* if ID specific output is valid */
+    if (logger_control[id_index].outputs[specific_index].count > 0) {
+      /* search this ID specific output in unified outputs */
+      for (unified_index = 0 ; unified_index < LOGGER_ELEMENTS(plan->outputs) ; unified_index++) {
+        /* if this unified entry is used */
+        if (plan->outputs[unified_index].count != 0) {
+          /* if it is the same then current ID specific output has been added already*/
+          if (((logger_control[id_index].outputs[specific_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+               (plan->outputs[unified_index].stream == logger_control[id_index].outputs[specific_index].stream)) ||
+              ((logger_control[id_index].outputs[specific_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+               (plan->outputs[unified_index].function == logger_control[id_index].outputs[specific_index].function)) ||
+              ((logger_control[id_index].outputs[specific_index].type == LOGGER_OUTPUT_TYPE_DRIVER) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_DRIVER) &&
+               (plan->outputs[unified_index].driver == logger_control[id_index].outputs[specific_index].driver) &&
+               (plan->outputs[unified_index].context == logger_control[id_index].outputs[specific_index].context)) ||
+              ((logger_control[id_index].outputs[specific_index].type == LOGGER_OUTPUT_TYPE_RECORD) &&
+               (plan->outputs[unified_index].type == LOGGER_OUTPUT_TYPE_RECORD) &&
+               (plan->outputs[unified_index].record_function == logger_control[id_index].outputs[specific_index].record_function))) {
+            plan->outputs[unified_index].use_color |= logger_control[id_index].outputs[specific_index].use_color;
+            plan->outputs[unified_index].level     |= logger_control[id_index].outputs[specific_index].level;
+            break;
+          }
+        }
+        else {
+          /* if this unified entry is not used the ID specific output has not been added to unified list */
+          logger_plan_output_set(&plan->outputs[unified_index], &logger_control[id_index].outputs[specific_index]);
+          break;
+        }
+      }
+    }
+  }
+
+  /* levels which need a line or a prefix at all */
+  plan->line_level = LOGGER_UNKNOWN;
+  plan->text_level = LOGGER_UNKNOWN;
+
+  for (unified_index = 0 ; unified_index < LOGGER_ELEMENTS(plan->outputs) ; unified_index++) {
+    if (plan->outputs[unified_index].count > 0) {
+      if (plan->outputs[unified_index].format != LOGGER_OUTPUT_FORMAT_RECORD) {
+        plan->line_level |= plan->outputs[unified_index].level;
+      }
+
+      if (plan->outputs[unified_index].format == LOGGER_OUTPUT_FORMAT_TEXT) {
+        plan->text_level |= plan->outputs[unified_index].level;
+      }
+    }
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level for global output stream.
- *
- * Query the currently set minimum level for the given logging output stream.
+ * \brief  Start a new epoch of output plans
  *
- * \param[in]     stream  Previous registered file stream.
+ * Must be called with \c logger_plan_mutex locked after new plans have been
+ * stored. Threads starting to read plans later load the new ones.
  *
- * \return        Currently set logging level.
+ * \return        New epoch, never 0.
  ******************************************************************************/
-logger_level_t logger_output_level_get(FILE *stream)
+LOGGER_INLINE uint32_t logger_plan_epoch_next(void)
 {
-  logger_level_t level;
+  uint32_t epoch;
 
-  /* get stream output level to global outputs */
-  level = logger_output_common_level_get(logger_outputs,
-                                         LOGGER_ELEMENTS(logger_outputs),
-                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                         stream,
-                                         (logger_output_function_t)NULL);
+  epoch = LOGGER_ATOMIC_LOAD(&logger_plan_epoch) + 1;
+  if (epoch == 0) {
+    epoch = 1;
+  }
+  LOGGER_ATOMIC_STORE(&logger_plan_epoch, epoch);
 
-  /* return only lowest set bit */
-  return(LOGGER_ALL ^ (level - 1));
+  return(epoch);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level mask for global output stream.
- *
- * Set a logging level mask for given output stream. Only log messages with
- * a level set in the given level mask will be printed to the given stream.
+ * \brief  Publish configuration for IDs
  *
- * \param[in]     stream  Previous registered file stream.
- * \param[in]     level   Level mask to set.
+ * Build a new plan of every ID whose configuration changed, see
+ * \c logger_plan_build() and \c logger_plan_mark(). This is done even while
+ * configuration is batched.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * The new plans are built while logging threads keep reading the published
+ * ones. Each new plan is published by a single atomic store. The replaced plan
+ * becomes the spare of the ID, it is only waited for when the ID changes again
+ * before all threads reading it have finished. Logging never waits for a
+ * change of configuration.
  ******************************************************************************/
-logger_return_t logger_output_level_mask_set(FILE                 *stream,
-                                             const logger_level_t level)
+LOGGER_INLINE void logger_plan_publish(void)
 {
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  const logger_color_string_t *level_colors;
+  logger_color_string_t       *spare_colors;
+  logger_plan_t               *plan;
+  logger_bool_t               changed = logger_false;
+  uint32_t                    epoch;
+  size_t                      id_index;
+
+  (void)pthread_mutex_lock(&logger_plan_mutex);
+
+  level_colors = logger_level_color_plan;
+
+  /* level colors are only copied when all plans are rebuilt */
+  if (logger_plan_all == logger_true) {
+    spare_colors = (logger_level_color_plan == logger_level_color_plans[0]) ? logger_level_color_plans[1] : logger_level_color_plans[0];
+    logger_plan_wait(logger_plan_colors_retired);
+    (void)memcpy(spare_colors, logger_level_colors, sizeof(logger_level_colors));
+    level_colors = spare_colors;
   }
 
-  /* set stream output level to global outputs */
-  return(logger_output_common_level_set(logger_outputs,
-                                        LOGGER_ELEMENTS(logger_outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL,
-                                        level));
+  /* loop over all changed IDs */
+  for (id_index = 0 ; id_index < LOGGER_ELEMENTS(logger_control) ; id_index++) {
+    if (logger_plan_all == logger_true) {
+      logger_control[id_index].plan_dirty = logger_true;
+    }
+
+    if (logger_control[id_index].plan_dirty == logger_true) {
+      /* build the spare plan once no thread reads it anymore */
+      plan = (logger_control[id_index].plan == &logger_control[id_index].plans[0]) ? &logger_control[id_index].plans[1] : &logger_control[id_index].plans[0];
+      logger_plan_wait(logger_control[id_index].plan_retired);
+      logger_plan_build(plan, id_index, level_colors);
+
+      /* publish the plan, messages started later use it */
+      LOGGER_ATOMIC_STORE(&logger_control[id_index].plan, plan);
+      changed = logger_true;
+    }
+  }
+
+  if (changed == logger_true) {
+    epoch = logger_plan_epoch_next();
+
+    /* the replaced plans are spares from now on */
+    for (id_index = 0 ; id_index < LOGGER_ELEMENTS(logger_control) ; id_index++) {
+      if (logger_control[id_index].plan_dirty == logger_true) {
+        logger_control[id_index].plan_retired = epoch;
+        logger_control[id_index].plan_dirty   = logger_false;
+      }
+    }
+
+    if (logger_plan_all == logger_true) {
+      logger_plan_colors_retired = epoch;
+      logger_level_color_plan    = level_colors;
+    }
+  }
+
+  logger_plan_all     = logger_false;
+  logger_config_unify = logger_false;
+
+  (void)pthread_mutex_unlock(&logger_plan_mutex);
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level mask for global output stream.
- *
- * Query the currently set level mask for the given logging output stream.
+ * \brief  Publish configuration for a released ID
  *
- * \param[in]     stream  Previous registered file stream.
+ * Publish a plan printing nothing for the released ID and wait until no
+ * thread uses its previous plan anymore, so the ID can be reused. This is done
+ * even while configuration is batched.
  *
- * \return        Currently set logging level mask.
+ * \param[in]     id      Released logger ID.
  ******************************************************************************/
-logger_level_t logger_output_level_mask_get(FILE *stream)
+LOGGER_INLINE void logger_plan_release(logger_id_t id)
+{
+  logger_plan_t *plan;
+  uint32_t      epoch;
+
+  (void)pthread_mutex_lock(&logger_plan_mutex);
+
+  plan = (logger_control[id].plan == &logger_control[id].plans[0]) ? &logger_control[id].plans[1] : &logger_control[id].plans[0];
+  logger_plan_wait(logger_control[id].plan_retired);
+  logger_plan_build(plan, (size_t)id, logger_level_color_plan);
+  LOGGER_ATOMIC_STORE(&logger_control[id].plan, plan);
+
+  epoch = logger_plan_epoch_next();
+  logger_control[id].plan_retired = epoch;
+  logger_control[id].plan_dirty   = logger_false;
+
+  /* wait until no thread uses the previous plan anymore */
+  logger_plan_wait(epoch);
+
+  (void)pthread_mutex_unlock(&logger_plan_mutex);
+}
+
+
+/***************************************************************************//**
+ * \brief  Mark the output plan of an ID as changed
+ *
+ * The next \c logger_plan_publish() rebuilds the plans of all marked IDs.
+ *
+ * \param[in]     id      Logger ID, \c logger_id_unknown for all IDs and the
+ *                        level colors.
+ ******************************************************************************/
+LOGGER_INLINE void logger_plan_mark(logger_id_t id)
+{
+  (void)pthread_mutex_lock(&logger_plan_mutex);
+
+  if ((id < 0) || (id >= (logger_id_t)LOGGER_ELEMENTS(logger_control))) {
+    logger_plan_all = logger_true;
+  }
+  else {
+    logger_control[id].plan_dirty = logger_true;
+  }
+
+  (void)pthread_mutex_unlock(&logger_plan_mutex);
+}
+
+
+/***************************************************************************//**
+ * \brief  Find the ID owning a list of outputs
+ *
+ * \param[in]     outputs  List of outputs.
+ *
+ * \return        ID owning the list, \c logger_id_unknown for global outputs.
+ ******************************************************************************/
+LOGGER_INLINE logger_id_t logger_plan_owner(const logger_output_t *outputs)
+{
+  size_t id_index;
+
+  for (id_index = 0 ; id_index < LOGGER_ELEMENTS(logger_control) ; id_index++) {
+    if (outputs == logger_control[id_index].outputs) {
+      return((logger_id_t)id_index);
+    }
+  }
+
+  return(logger_id_unknown);
+}
+
+
+/***************************************************************************//**
+ * \brief  Unify outputs for IDs
+ *
+ * Publish the configuration of the changed ID with its outputs merged into one
+ * list, see \c logger_plan_build(). While configuration is batched by
+ * \c logger_config_begin() this is done once by \c logger_config_commit().
+ *
+ * \param[in]     id      Changed logger ID, \c logger_id_unknown if global
+ *                        configuration changed.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_common_unify(logger_id_t id)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_plan_mark(id);
+
+  if (logger_config_depth > 0) {
+    logger_config_unify = logger_true;
+  }
+  else {
+    logger_plan_publish();
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Register an output to a list of outputs.
+ *
+ * The given file stream may be on of \c stdout, \c stderr or a file stream
+ * opened by the user. The user provided function must take a single string
+ * argument. The default logging level is set to \c LOGGER_UNKNOWN thus no
+ * messages will appear on this stream.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_register(logger_output_t          *outputs,
+                                                            const size_t             size,
+                                                            logger_output_type_t     type,
+                                                            FILE                     *stream,
+                                                            logger_output_function_t function)
+{
+  logger_return_t ret = LOGGER_OK;
+  size_t          index;
+  logger_bool_t   found;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  /* check if this output stream is already registered */
+  found = logger_false;
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+        (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))){
+      found = logger_true;
+      break;
+    }
+  }
+
+  /* output is already registered */
+  if (found == logger_true) {
+    outputs[index].count++;
+    ret = LOGGER_ERR_OUTPUT_REGISTERED;
+  }
+  /* output is not registered */
+  else {
+    /* search for an empty slot */
+    found = logger_false;
+    for (index = 0 ; index < size ; index++) {
+      if (outputs[index].count == 0) {
+        found = logger_true;
+        break;
+      }
+    }
+
+    /* found an empty slot */
+    if (found == logger_true) {
+      /* outputs will change, print repeat and rate limit messages */
+      logger_config_change();
+
+      outputs[index].count++;
+      outputs[index].level     = LOGGER_UNKNOWN;
+      outputs[index].use_color = logger_false;
+      outputs[index].kv_format = LOGGER_KV_FORMAT_TEXT;
+      outputs[index].format    = LOGGER_OUTPUT_FORMAT_TEXT;
+      outputs[index].type      = type;
+      outputs[index].context   = &outputs[index];
+      outputs[index].counters  = &outputs[index].stats;
+      (void)memset(&outputs[index].stats, 0, sizeof(outputs[index].stats));
+
+      switch (type) {
+        case LOGGER_OUTPUT_TYPE_UNKNOWN:
+          /* nothing */
+          break;
+
+        case LOGGER_OUTPUT_TYPE_FILESTREAM:
+          outputs[index].stream = stream;
+          outputs[index].file   = logger_file_find(stream);
+          outputs[index].driver = &logger_output_stream_driver;
+
+          /* only stdout and stderr use color by default */
+          if ((stream == stdout) ||
+              (stream == stderr)) {
+            outputs[index].use_color = logger_true;
+          }
+          break;
+
+        case LOGGER_OUTPUT_TYPE_FUNCTION:
+          outputs[index].function = function;
+          outputs[index].driver   = &logger_output_function_driver;
+          break;
+
+        case LOGGER_OUTPUT_TYPE_DRIVER:
+        case LOGGER_OUTPUT_TYPE_RECORD:
+          /* registered by logger_output_driver_add() */
+          break;
+
+        case LOGGER_OUTPUT_TYPE_MAX:
+          /* nothing */
+          break;
+      }
+
+      outputs[index].latency = logger_latency_output(&outputs[index]);
+    }
+    else {
+      ret = LOGGER_ERR_OUTPUTS_FULL;
+    }
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister an output from a list of outputs.
+ *
+ * Remove given output from list of outputs.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_deregister(logger_output_t          *outputs,
+                                                              const size_t             size,
+                                                              logger_output_type_t     type,
+                                                              FILE                     *stream,
+                                                              logger_output_function_t function)
+{
+  logger_return_t ret = LOGGER_OK;
+  size_t          index;
+  logger_bool_t   found;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  /* check if this output is registered */
+  found = logger_false;
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+        (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))){
+      found = logger_true;
+      break;
+    }
+  }
+
+  /* found given output in a slot */
+  if (found == logger_true) {
+    outputs[index].count--;
+
+    /* remove this output if this was the last reference */
+    if (outputs[index].count <= 0) {
+      /* outputs will change, print repeat and rate limit messages */
+      logger_config_change();
+
+      /* wait until no thread prints to this output anymore */
+      outputs[index].count = 0;
+      logger_plan_mark(logger_plan_owner(outputs));
+      logger_plan_publish();
+      logger_plan_synchronize();
+
+      /* flush everything in this stream */
+      if (type == LOGGER_OUTPUT_TYPE_FILESTREAM) {
+        fflush(outputs[index].stream);
+      }
+
+      /* reset output to default values */
+      outputs[index].count     = 0;
+      outputs[index].level     = LOGGER_UNKNOWN;
+      outputs[index].use_color = logger_false;
+      outputs[index].type      = LOGGER_OUTPUT_TYPE_UNKNOWN;
+      outputs[index].stream    = (FILE *)NULL;
+      outputs[index].function  = (logger_output_function_t)NULL;
+      outputs[index].file      = (logger_file_t *)NULL;
+      outputs[index].driver    = (const logger_output_driver_t *)NULL;
+      outputs[index].context   = NULL;
+    }
+  }
+  else {
+    ret = LOGGER_ERR_OUTPUT_NOT_FOUND;
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Search an output in a list of outputs.
+ *
+ * The given output is searched in the given list of outputs.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_output_common_is_registered(logger_output_t          *outputs,
+                                                               const size_t             size,
+                                                               logger_output_type_t     type,
+                                                               FILE                     *stream,
+                                                               logger_output_function_t function)
+{
+  logger_bool_t ret = logger_false;
+  size_t        index;
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(logger_false);
+  }
+
+  /* check if this output stream is registered */
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+        (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))){
+      ret = logger_true;
+      break;
+    }
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for output in a list of outputs.
+ *
+ * Set the minimum logging level for given output. Only log messages
+ * equal or above the given level will be printed to the given output.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ * \param[in]     level     Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_level_set(logger_output_t          *outputs,
+                                                             const size_t             size,
+                                                             logger_output_type_t     type,
+                                                             FILE                     *stream,
+                                                             logger_output_function_t function,
+                                                             const logger_level_t     level)
+{
+  logger_return_t ret = LOGGER_OK;
+  size_t          index;
+  logger_bool_t   found;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  /* check if this output is registered */
+  found = logger_false;
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+        (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))){
+      found = logger_true;
+      break;
+    }
+  }
+
+  /* found given output in a slot */
+  if (found == logger_true) {
+    /* outputs will change, print repeat and rate limit messages */
+    logger_config_change();
+
+    /* set log level */
+    outputs[index].level = level;
+  }
+  else {
+    ret = LOGGER_ERR_OUTPUT_NOT_FOUND;
+  }
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_plan_owner(outputs));
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for output stream in a list of outputs.
+ *
+ * Query the currently set minimum level for the given logging output stream.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_level_t logger_output_common_level_get(logger_output_t          *outputs,
+                                                            const size_t             size,
+                                                            logger_output_type_t     type,
+                                                            FILE                     *stream,
+                                                            logger_output_function_t function)
+{
+  logger_level_t ret = LOGGER_UNKNOWN;
+  size_t         index;
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+         (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))) {
+      ret = outputs[index].level;
+      break;
+    }
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Modify the output color setting.
+ *
+ * Set the color setting for a given output to the given state.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ * \param[in]     flag      State of color setting.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_color(logger_output_t          *outputs,
+                                                         const size_t             size,
+                                                         logger_output_type_t     type,
+                                                         FILE                     *stream,
+                                                         logger_output_function_t function,
+                                                         logger_bool_t            flag)
+{
+  logger_return_t ret = LOGGER_OK;
+  size_t          index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+        (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))){
+      /* set color flag */
+      outputs[index].use_color = flag;
+      break;
+    }
+  }
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_plan_owner(outputs));
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the output color setting.
+ *
+ * Query the color setting for a given output.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_output_common_color_is_enabled(logger_output_t          *outputs,
+                                                                  const size_t             size,
+                                                                  logger_output_type_t     type,
+                                                                  FILE                     *stream,
+                                                                  logger_output_function_t function)
+{
+  logger_bool_t ret = logger_false;
+  size_t        index;
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(logger_false);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+        (outputs[index].stream == stream)) ||
+        ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+         (outputs[index].function == function))){
+      ret = outputs[index].use_color;
+      break;
+    }
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Modify the rendering of structured messages of an output.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ * \param[in]     format    Rendering of structured messages.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_kv_format_set(logger_output_t          *outputs,
+                                                                 const size_t             size,
+                                                                 logger_output_type_t     type,
+                                                                 FILE                     *stream,
+                                                                 logger_output_function_t function,
+                                                                 logger_kv_format_t       format)
+{
+  logger_return_t ret = LOGGER_ERR_OUTPUT_NOT_FOUND;
+  size_t          index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid format */
+  if ((format < LOGGER_KV_FORMAT_TEXT) ||
+      (format >= LOGGER_KV_FORMAT_MAX)) {
+    return(LOGGER_ERR_FORMAT_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if ((outputs[index].count > 0) &&
+        (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+          (outputs[index].stream == stream)) ||
+         ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+          (outputs[index].function == function)))) {
+      /* set rendering */
+      outputs[index].kv_format = format;
+      ret = LOGGER_OK;
+      break;
+    }
+  }
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_plan_owner(outputs));
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the rendering of structured messages of an output.
+ *
+ * \param[in]     outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Rendering of structured messages, \c LOGGER_KV_FORMAT_TEXT if
+ *                output is not found.
+ ******************************************************************************/
+LOGGER_INLINE logger_kv_format_t logger_output_common_kv_format_get(logger_output_t          *outputs,
+                                                                    const size_t             size,
+                                                                    logger_output_type_t     type,
+                                                                    FILE                     *stream,
+                                                                    logger_output_function_t function)
+{
+  logger_kv_format_t ret = LOGGER_KV_FORMAT_TEXT;
+  size_t             index;
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_KV_FORMAT_TEXT);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if ((outputs[index].count > 0) &&
+        (((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+          (outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+          (outputs[index].stream == stream)) ||
+         ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+          (outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+          (outputs[index].function == function)))) {
+      ret = outputs[index].kv_format;
+      break;
+    }
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Modify the format of an output.
+ *
+ * \param[in,out] outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ * \param[in]     format    Format of lines.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_format_set(logger_output_t          *outputs,
+                                                              const size_t             size,
+                                                              logger_output_type_t     type,
+                                                              FILE                     *stream,
+                                                              logger_output_function_t function,
+                                                              logger_output_format_t   format)
+{
+  logger_return_t ret = LOGGER_ERR_OUTPUT_NOT_FOUND;
+  size_t          index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid type */
+  if ((type <= LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+      (type >= LOGGER_OUTPUT_TYPE_MAX)) {
+    return(LOGGER_ERR_TYPE_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+      (stream == NULL)) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+      (function == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  /* GUARD: check for valid format, functions only take strings, streams and functions need lines */
+  if ((format < LOGGER_OUTPUT_FORMAT_TEXT) ||
+      (format >= LOGGER_OUTPUT_FORMAT_RECORD) ||
+      ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+       (format == LOGGER_OUTPUT_FORMAT_BINARY))) {
+    return(LOGGER_ERR_FORMAT_INVALID);
+  }
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if ((outputs[index].count > 0) &&
+        (((outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+          (outputs[index].stream == stream)) ||
+         ((outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+          (outputs[index].function == function)))) {
+      /* set format */
+      outputs[index].format = format;
+      ret = LOGGER_OK;
+      break;
+    }
+  }
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_plan_owner(outputs));
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the format of an output.
+ *
+ * \param[in]     outputs   List of logger outputs.
+ * \param[in]     size      Number of elements in list.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Format of lines, \c LOGGER_OUTPUT_FORMAT_TEXT if output is not
+ *                found.
+ ******************************************************************************/
+LOGGER_INLINE logger_output_format_t logger_output_common_format_get(logger_output_t          *outputs,
+                                                                     const size_t             size,
+                                                                     logger_output_type_t     type,
+                                                                     FILE                     *stream,
+                                                                     logger_output_function_t function)
+{
+  logger_output_format_t ret = LOGGER_OUTPUT_FORMAT_TEXT;
+  size_t                 index;
+
+  /* GUARD: check for valid output */
+  if (outputs == NULL) {
+    return(LOGGER_OUTPUT_FORMAT_TEXT);
+  }
+
+  /* check if this output is registered */
+  for (index = 0 ; index < size ; index++) {
+    if ((outputs[index].count > 0) &&
+        (((type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+          (outputs[index].type == LOGGER_OUTPUT_TYPE_FILESTREAM) &&
+          (outputs[index].stream == stream)) ||
+         ((type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+          (outputs[index].type == LOGGER_OUTPUT_TYPE_FUNCTION) &&
+          (outputs[index].function == function)))) {
+      ret = outputs[index].format;
+      break;
+    }
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query counters of an output.
+ *
+ * Sum up the counters of all global and ID specific registrations of the given
+ * output.
+ *
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
+ * \param[in]     function  User provided output function.
+ * \param[in]     driver    Driver writing the lines.
+ * \param[in]     context   Context of driver.
+ * \param[out]    stats     Counters.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_common_stats_get(logger_output_type_t         type,
+                                                             FILE                         *stream,
+                                                             logger_output_function_t     function,
+                                                             const logger_output_driver_t *driver,
+                                                             void                         *context,
+                                                             logger_output_stats_t        *stats)
+{
+  const logger_output_t *output;
+  logger_bool_t         found = logger_false;
+  size_t                id;
+  size_t                index;
+
+  /* GUARD: check for valid stats */
+  if (stats == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  (void)memset(stats, 0, sizeof(*stats));
+
+  /* global outputs first, then ID specific outputs of each ID */
+  for (id = 0 ; id <= LOGGER_ELEMENTS(logger_control) ; id++) {
+    for (index = 0 ; index < ((id == 0) ? LOGGER_ELEMENTS(logger_outputs) : LOGGER_ELEMENTS(logger_control[id - 1].outputs)) ; index++) {
+      output = (id == 0) ? &logger_outputs[index] : &logger_control[id - 1].outputs[index];
+
+      if ((output->count > 0) &&
+          (output->type == type) &&
+          (((type == LOGGER_OUTPUT_TYPE_FILESTREAM) && (output->stream == stream)) ||
+           ((type == LOGGER_OUTPUT_TYPE_FUNCTION) && (output->function == function)) ||
+           ((type == LOGGER_OUTPUT_TYPE_DRIVER) && (output->driver == driver) && (output->context == context)))) {
+        found = logger_true;
+
+        stats->lines  += LOGGER_COUNTER_GET(&output->stats.lines);
+        stats->bytes  += LOGGER_COUNTER_GET(&output->stats.bytes);
+        stats->errors += LOGGER_COUNTER_GET(&output->stats.errors);
+      }
+    }
+  }
+
+  return((found == logger_true) ? LOGGER_OK : LOGGER_ERR_OUTPUT_NOT_FOUND);
+}
+
+
+/***************************************************************************//**
+ * \brief  Register a global output stream.
+ *
+ * The given file stream may be on of \c stdout, \c stderr or a file stream
+ * opened by the user. The default logging level is set to \c LOGGER_UNKNOWN thus
+ * no messages will appear on this stream.
+ *
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_register(FILE *stream)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* add stream to global outputs */
+  ret = logger_output_common_register(logger_outputs,
+                                      LOGGER_ELEMENTS(logger_outputs),
+                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                      stream,
+                                      (logger_output_function_t)NULL);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister a global output stream.
+ *
+ * Remove given file stream from list of outputs.
+ *
+ * \param[in]     stream  Previous registered file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_deregister(FILE *stream)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* delete stream from global outputs */
+  ret = logger_output_common_deregister(logger_outputs,
+                                        LOGGER_ELEMENTS(logger_outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Search an output stream in list of global outputs.
+ *
+ * The given file stream is searched in the list of global outputs.
+ *
+ * \param[in]     stream  File stream.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_is_registered(FILE *stream)
+{
+  /* search stream in global outputs */
+  return(logger_output_common_is_registered(logger_outputs,
+                                            LOGGER_ELEMENTS(logger_outputs),
+                                            LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                            stream,
+                                            (logger_output_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for global output stream.
+ *
+ * Set the minimum logging level for given output stream. Only log messages
+ * equal or above the given level will be printed to the given stream.
+ *
+ * \param[in]     stream  Previous registered file stream.
+ * \param[in]     level   Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_level_set(FILE                 *stream,
+                                        const logger_level_t level)
+{
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set stream output level to global outputs */
+  return(logger_output_common_level_set(logger_outputs,
+                                        LOGGER_ELEMENTS(logger_outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL,
+                                        LOGGER_ALL ^ (level - 1)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for global output stream.
+ *
+ * Query the currently set minimum level for the given logging output stream.
+ *
+ * \param[in]     stream  Previous registered file stream.
+ *
+ * \return        Currently set logging level.
+ ******************************************************************************/
+logger_level_t logger_output_level_get(FILE *stream)
+{
+  logger_level_t level;
+
+  /* get stream output level to global outputs */
+  level = logger_output_common_level_get(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                         stream,
+                                         (logger_output_function_t)NULL);
+
+  /* return only lowest set bit */
+  return(LOGGER_ALL ^ (level - 1));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level mask for global output stream.
+ *
+ * Set a logging level mask for given output stream. Only log messages with
+ * a level set in the given level mask will be printed to the given stream.
+ *
+ * \param[in]     stream  Previous registered file stream.
+ * \param[in]     level   Level mask to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_level_mask_set(FILE                 *stream,
+                                             const logger_level_t level)
+{
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set stream output level to global outputs */
+  return(logger_output_common_level_set(logger_outputs,
+                                        LOGGER_ELEMENTS(logger_outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL,
+                                        level));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level mask for global output stream.
+ *
+ * Query the currently set level mask for the given logging output stream.
+ *
+ * \param[in]     stream  Previous registered file stream.
+ *
+ * \return        Currently set logging level mask.
+ ******************************************************************************/
+logger_level_t logger_output_level_mask_get(FILE *stream)
+{
+  logger_level_t level;
+
+  /* get stream output level to global outputs */
+  level = logger_output_common_level_get(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                         stream,
+                                         (logger_output_function_t)NULL);
+
+  return(level);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable the global output stream color setting.
+ *
+ * Enable the color setting for a given output stream.
+ *
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_color_enable(FILE *stream)
+{
+  /* set stream output level to global outputs */
+  return(logger_output_common_color(logger_outputs,
+                                    LOGGER_ELEMENTS(logger_outputs),
+                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                    stream,
+                                    (logger_output_function_t)NULL,
+                                    logger_true));
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable the global output stream color setting.
+ *
+ * Disable the color setting for a given output stream.
+ *
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_color_disable(FILE *stream)
+{
+  /* set stream output level to global outputs */
+  return(logger_output_common_color(logger_outputs,
+                                    LOGGER_ELEMENTS(logger_outputs),
+                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                    stream,
+                                    (logger_output_function_t)NULL,
+                                    logger_false));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the global output stream color setting.
+ *
+ * Query the color setting for a given output stream.
+ *
+ * \param[in]     stream    Opened file stream.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise
+ ******************************************************************************/
+logger_bool_t logger_output_color_is_enabled(FILE *stream)
+{
+  /* check if color for this stream is enabled */
+  return(logger_output_common_color_is_enabled(logger_outputs,
+                                               LOGGER_ELEMENTS(logger_outputs),
+                                               LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                               stream,
+                                               (logger_output_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set the rendering of structured messages of a global output stream.
+ *
+ * Messages printed by logger_kv() are rendered as text, logfmt or JSON
+ * depending on the output. Other messages are not changed.
+ *
+ * \param[in]     stream  Opened file stream.
+ * \param[in]     format  Rendering of structured messages.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_kv_format_set(FILE                     *stream,
+                                            const logger_kv_format_t format)
+{
+  return(logger_output_common_kv_format_set(logger_outputs,
+                                            LOGGER_ELEMENTS(logger_outputs),
+                                            LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                            stream,
+                                            (logger_output_function_t)NULL,
+                                            format));
+}
+
+
+/***************************************************************************//**
+ * \brief  Get the rendering of structured messages of a global output stream.
+ *
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        Rendering of structured messages.
+ ******************************************************************************/
+logger_kv_format_t logger_output_kv_format_get(FILE *stream)
+{
+  return(logger_output_common_kv_format_get(logger_outputs,
+                                            LOGGER_ELEMENTS(logger_outputs),
+                                            LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                            stream,
+                                            (logger_output_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set the format of a global output stream.
+ *
+ * With \c LOGGER_OUTPUT_FORMAT_JSON every line is a JSON object containing
+ * time, ID name, level, file, function, line and message instead of prefix and
+ * message. Colors are not used, fields of structured messages become members
+ * of the object. With \c LOGGER_OUTPUT_FORMAT_BINARY every message is written
+ * as flight recorder record, see \c logger_output_recorder_recover().
+ *
+ * \param[in]     stream  Opened file stream.
+ * \param[in]     format  Format of lines.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_format_set(FILE                         *stream,
+                                         const logger_output_format_t format)
+{
+  return(logger_output_common_format_set(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                         stream,
+                                         (logger_output_function_t)NULL,
+                                         format));
+}
+
+
+/***************************************************************************//**
+ * \brief  Get the format of a global output stream.
+ *
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        Format of lines.
+ ******************************************************************************/
+logger_output_format_t logger_output_format_get(FILE *stream)
+{
+  return(logger_output_common_format_get(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                         stream,
+                                         (logger_output_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Flush all output streams.
+ *
+ * Force a flush of all output streams and drivers. Managed files finish a
+ * queued rotation first.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_flush(void)
+{
+  size_t index;
+  size_t id;
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  /* GUARD: called by an output */
+  if (logger_print_lock(NULL) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* search for used global outputs */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_outputs) ; index++) {
+    if ((logger_outputs[index].count > 0) &&
+        (logger_outputs[index].driver->flush != NULL)) {
+      logger_outputs[index].driver->flush(logger_outputs[index].context);
+    }
+  }
+
+  /* search for used id specific outputs */
+  for (id = 0 ; id < LOGGER_ELEMENTS(logger_control) ; id++) {
+    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control[id].outputs) ; index++) {
+      if ((logger_control[id].outputs[index].count > 0) &&
+          (logger_control[id].outputs[index].driver->flush != NULL)) {
+        logger_control[id].outputs[index].driver->flush(logger_control[id].outputs[index].context);
+      }
+    }
+  }
+
+  logger_print_unlock(NULL);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query counters of an output stream.
+ *
+ * Lines, bytes and write errors of all global and ID specific registrations of
+ * the stream since they were registered.
+ *
+ * \param[in]     stream  Registered file stream.
+ * \param[out]    stats   Counters.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_stats_get(FILE                  *stream,
+                                        logger_output_stats_t *stats)
+{
+  return(logger_output_common_stats_get(LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL,
+                                        (const logger_output_driver_t *)NULL,
+                                        NULL,
+                                        stats));
+}
+
+
+/***************************************************************************//**
+ * \brief  Register a global output function.
+ *
+ * The user provided function must take a single string argument. The default
+ * logging level is set to \c LOGGER_UNKNOWN thus this function will not be
+ * called for any message.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_register(logger_output_function_t function)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* add function to global outputs */
+  ret = logger_output_common_register(logger_outputs,
+                                      LOGGER_ELEMENTS(logger_outputs),
+                                      LOGGER_OUTPUT_TYPE_FUNCTION,
+                                      (FILE *)NULL,
+                                      function);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister a global output function:
+ *
+ * Remove given output function from list of outputs.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_deregister(logger_output_function_t function)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* delete function from global outputs */
+  ret = logger_output_common_deregister(logger_outputs,
+                                        LOGGER_ELEMENTS(logger_outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Search a global output function in a list of global outputs.
+ *
+ * The given file function is searched in the list of global outputs.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_function_is_registered(logger_output_function_t function)
+{
+  /* search function in global outputs */
+  return(logger_output_common_is_registered(logger_outputs,
+                                            LOGGER_ELEMENTS(logger_outputs),
+                                            LOGGER_OUTPUT_TYPE_FUNCTION,
+                                            (FILE *)NULL,
+                                            function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for global output function.
+ *
+ * Set the minimum logging level for given output function. Only for log
+ * messages equal or above the given level the function will be called.
+ *
+ * \param[in]     function  User provided output function.
+ * \param[in]     level     Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_level_set(logger_output_function_t function,
+                                                 const logger_level_t     level)
+{
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set function output level from global outputs */
+  return(logger_output_common_level_set(logger_outputs,
+                                        LOGGER_ELEMENTS(logger_outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function,
+                                        LOGGER_ALL ^ (level - 1)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for global output function.
+ *
+ * Query the currently set minimum level for the given logging output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Currently set logging level.
+ ******************************************************************************/
+logger_level_t logger_output_function_level_get(logger_output_function_t function)
+{
+  logger_level_t level;
+
+  /* get function output level to global outputs */
+  level = logger_output_common_level_get(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FUNCTION,
+                                         (FILE *)NULL,
+                                         function);
+
+  /* return only lowest set bit */
+  return(LOGGER_ALL ^ (level - 1));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level mask for global output function.
+ *
+ * Set a logging level mask for given output function. Only for log messages
+ * with a level set in the given level mask the function will be called.
+ *
+ * \param[in]     function  User provided output function.
+ * \param[in]     level     Level mask to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_level_mask_set(logger_output_function_t function,
+                                                      const logger_level_t     level)
+{
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set function output level to global outputs */
+  return(logger_output_common_level_set(logger_outputs,
+                                        LOGGER_ELEMENTS(logger_outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function,
+                                        level));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level mask for global output function.
+ *
+ * Query the currently set level mask for the given logging output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Currently set logging level mask.
+ ******************************************************************************/
+logger_level_t logger_output_function_level_mask_get(logger_output_function_t function)
+{
+  logger_level_t level;
+
+  /* get function output level from global outputs */
+  level = logger_output_common_level_get(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FUNCTION,
+                                         (FILE *)NULL,
+                                         function);
+
+  return(level);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable the global output function color setting.
+ *
+ * Enable the color setting for a given output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_color_enable(logger_output_function_t function)
+{
+  /* set function output level to global outputs */
+  return(logger_output_common_color(logger_outputs,
+                                    LOGGER_ELEMENTS(logger_outputs),
+                                    LOGGER_OUTPUT_TYPE_FUNCTION,
+                                    (FILE *)NULL,
+                                    function,
+                                    logger_true));
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable the global output function color setting.
+ *
+ * Enable the color setting for a given output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_color_disable(logger_output_function_t function)
+{
+  /* set function output level to global outputs */
+  return(logger_output_common_color(logger_outputs,
+                                    LOGGER_ELEMENTS(logger_outputs),
+                                    LOGGER_OUTPUT_TYPE_FUNCTION,
+                                    (FILE *)NULL,
+                                    function,
+                                    logger_false));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the global output function color setting.
+ *
+ * Query the color setting for a given output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_function_color_is_enabled(logger_output_function_t function)
+{
+  /* check if color for this function is enabled */
+  return(logger_output_common_color_is_enabled(logger_outputs,
+                                               LOGGER_ELEMENTS(logger_outputs),
+                                               LOGGER_OUTPUT_TYPE_FUNCTION,
+                                               (FILE *)NULL,
+                                               function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set the rendering of structured messages of a global output function.
+ *
+ * \param[in]     function  User provided output function.
+ * \param[in]     format    Rendering of structured messages.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_kv_format_set(logger_output_function_t function,
+                                                     const logger_kv_format_t format)
+{
+  return(logger_output_common_kv_format_set(logger_outputs,
+                                            LOGGER_ELEMENTS(logger_outputs),
+                                            LOGGER_OUTPUT_TYPE_FUNCTION,
+                                            (FILE *)NULL,
+                                            function,
+                                            format));
+}
+
+
+/***************************************************************************//**
+ * \brief  Get the rendering of structured messages of a global output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Rendering of structured messages.
+ ******************************************************************************/
+logger_kv_format_t logger_output_function_kv_format_get(logger_output_function_t function)
+{
+  return(logger_output_common_kv_format_get(logger_outputs,
+                                            LOGGER_ELEMENTS(logger_outputs),
+                                            LOGGER_OUTPUT_TYPE_FUNCTION,
+                                            (FILE *)NULL,
+                                            function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set the format of a global output function.
+ *
+ * Functions take strings, \c LOGGER_OUTPUT_FORMAT_BINARY is rejected.
+ *
+ * \param[in]     function  User provided output function.
+ * \param[in]     format    Format of lines.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_format_set(logger_output_function_t     function,
+                                                  const logger_output_format_t format)
+{
+  return(logger_output_common_format_set(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FUNCTION,
+                                         (FILE *)NULL,
+                                         function,
+                                         format));
+}
+
+
+/***************************************************************************//**
+ * \brief  Get the format of a global output function.
+ *
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Format of lines.
+ ******************************************************************************/
+logger_output_format_t logger_output_function_format_get(logger_output_function_t function)
+{
+  return(logger_output_common_format_get(logger_outputs,
+                                         LOGGER_ELEMENTS(logger_outputs),
+                                         LOGGER_OUTPUT_TYPE_FUNCTION,
+                                         (FILE *)NULL,
+                                         function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query counters of an output function.
+ *
+ * Lines and bytes passed to all global and ID specific registrations of the
+ * function since they were registered.
+ *
+ * \param[in]     function  Registered output function.
+ * \param[out]    stats     Counters.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_stats_get(logger_output_function_t function,
+                                                 logger_output_stats_t    *stats)
+{
+  return(logger_output_common_stats_get(LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function,
+                                        (const logger_output_driver_t *)NULL,
+                                        NULL,
+                                        stats));
+}
+
+
+/***************************************************************************//**
+ * \brief  Find a global output driver.
+ *
+ * \param[in]     type      Type of output.
+ * \param[in]     driver    User provided driver.
+ * \param[in]     context   Context passed to the functions of the driver.
+ * \param[in]     function  User provided record function.
+ *
+ * \return        Registered output, \c NULL if not found.
+ ******************************************************************************/
+LOGGER_INLINE logger_output_t *logger_output_driver_find(logger_output_type_t            type,
+                                                         const logger_output_driver_t    *driver,
+                                                         void                            *context,
+                                                         logger_output_record_function_t function)
+{
+  size_t index;
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_outputs) ; index++) {
+    if ((logger_outputs[index].count > 0) &&
+        (((type == LOGGER_OUTPUT_TYPE_DRIVER) &&
+          (logger_outputs[index].type == LOGGER_OUTPUT_TYPE_DRIVER) &&
+          (logger_outputs[index].driver == driver) &&
+          (logger_outputs[index].context == context)) ||
+         ((type == LOGGER_OUTPUT_TYPE_RECORD) &&
+          (logger_outputs[index].type == LOGGER_OUTPUT_TYPE_RECORD) &&
+          (logger_outputs[index].record_function == function)))) {
+      return(&logger_outputs[index]);
+    }
+  }
+
+  return((logger_output_t *)NULL);
+}
+
+
+/***************************************************************************//**
+ * \brief  Add a global output driver.
+ *
+ * \param[in]     type      Type of output.
+ * \param[in]     driver    Driver writing the lines.
+ * \param[in]     context   Context passed to the functions of the driver, record
+ *                          functions get the output itself.
+ * \param[in]     function  User provided record function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_driver_add(logger_output_type_t            type,
+                                                       const logger_output_driver_t    *driver,
+                                                       void                            *context,
+                                                       logger_output_record_function_t function)
+{
+  logger_output_t *output;
+  size_t          index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  output = logger_output_driver_find(type, driver, context, function);
+
+  /* output is already registered */
+  if (output != NULL) {
+    output->count++;
+    return(LOGGER_ERR_OUTPUT_REGISTERED);
+  }
+
+  /* search for an empty slot */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_outputs) ; index++) {
+    if (logger_outputs[index].count == 0) {
+      output = &logger_outputs[index];
+      break;
+    }
+  }
+
+  /* GUARD: no empty slot */
+  if (output == NULL) {
+    return(LOGGER_ERR_OUTPUTS_FULL);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  output->count           = 1;
+  output->level           = LOGGER_UNKNOWN;
+  output->use_color       = logger_false;
+  output->kv_format       = LOGGER_KV_FORMAT_TEXT;
+  output->format          = (type == LOGGER_OUTPUT_TYPE_RECORD) ? LOGGER_OUTPUT_FORMAT_RECORD : LOGGER_OUTPUT_FORMAT_TEXT;
+  output->type            = type;
+  output->record_function = function;
+  output->driver          = driver;
+  output->context         = (type == LOGGER_OUTPUT_TYPE_RECORD) ? (void *)output : context;
+  output->counters        = &output->stats;
+  output->latency         = logger_latency_output(output);
+  (void)memset(&output->stats, 0, sizeof(output->stats));
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Remove a global output driver.
+ *
+ * The driver is flushed and closed when the last registration is removed.
+ *
+ * \param[in,out] output  Registered output, NULL if not found.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_driver_remove(logger_output_t *output)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: output must be registered */
+  if (output == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  output->count--;
+
+  /* remove this output if this was the last reference */
+  if (output->count <= 0) {
+    /* outputs will change, print repeat and rate limit messages */
+    logger_config_change();
+
+    /* wait until no thread prints to this output anymore */
+    output->count = 0;
+    logger_plan_mark(logger_id_unknown);
+    logger_plan_publish();
+    logger_plan_synchronize();
+
+    if (output->driver->flush != NULL) {
+      output->driver->flush(output->context);
+    }
+
+    if (output->driver->close != NULL) {
+      output->driver->close(output->context);
+    }
+
+    (void)memset(output, 0, sizeof(*output));
+  }
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level of a global output driver.
+ *
+ * \param[in,out] output  Registered output, NULL if not found.
+ * \param[in]     level   Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_output_driver_level(logger_output_t      *output,
+                                                         const logger_level_t level)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* GUARD: output must be registered */
+  if (output == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  output->level = LOGGER_ALL ^ (level - 1);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Register a global output driver.
+ *
+ * The functions of the driver are called with \p context for every message.
+ * \c write gets the record of the message and the whole line with its length.
+ * Text lines go to \c writev instead if the driver provides it, as parts like
+ * prefix and message which are not copied together. The same driver may be
+ * registered with different contexts. The default logging level is set to
+ * \c LOGGER_UNKNOWN thus no messages will appear on this output.
+ *
+ * \param[in]     driver   User provided driver, must provide \c write.
+ * \param[in]     context  Context passed to the functions of the driver.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_driver_register(const logger_output_driver_t *driver,
+                                              void                         *context)
+{
+  /* GUARD: check for valid driver */
+  if ((driver == NULL) ||
+      (driver->write == NULL)) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  return(logger_output_driver_add(LOGGER_OUTPUT_TYPE_DRIVER, driver, context, (logger_output_record_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister a global output driver.
+ *
+ * The driver is flushed and closed when the last registration is removed.
+ *
+ * \param[in]     driver   User provided driver.
+ * \param[in]     context  Context passed to the functions of the driver.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_driver_deregister(const logger_output_driver_t *driver,
+                                                void                         *context)
+{
+  return(logger_output_driver_remove(logger_output_driver_find(LOGGER_OUTPUT_TYPE_DRIVER, driver, context, (logger_output_record_function_t)NULL)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Search a global output driver.
+ *
+ * \param[in]     driver   User provided driver.
+ * \param[in]     context  Context passed to the functions of the driver.
+ *
+ * \return        \c logger_true if driver is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_driver_is_registered(const logger_output_driver_t *driver,
+                                                 void                         *context)
+{
+  return((logger_output_driver_find(LOGGER_OUTPUT_TYPE_DRIVER, driver, context, (logger_output_record_function_t)NULL) != NULL) ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for global output driver.
+ *
+ * Only log messages equal or above the given level will be passed to the
+ * driver.
+ *
+ * \param[in]     driver   User provided driver.
+ * \param[in]     context  Context passed to the functions of the driver.
+ * \param[in]     level    Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_driver_level_set(const logger_output_driver_t *driver,
+                                               void                         *context,
+                                               const logger_level_t         level)
+{
+  return(logger_output_driver_level(logger_output_driver_find(LOGGER_OUTPUT_TYPE_DRIVER, driver, context, (logger_output_record_function_t)NULL), level));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set the format of a global output driver.
+ *
+ * With \c LOGGER_OUTPUT_FORMAT_RECORD no line is formatted, \c write gets the
+ * record and an empty line.
+ *
+ * \param[in]     driver   User provided driver.
+ * \param[in]     context  Context passed to the functions of the driver.
+ * \param[in]     format   Format of lines.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_driver_format_set(const logger_output_driver_t *driver,
+                                                void                         *context,
+                                                const logger_output_format_t format)
+{
+  logger_output_t *output;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid format */
+  if ((format < LOGGER_OUTPUT_FORMAT_TEXT) ||
+      (format >= LOGGER_OUTPUT_FORMAT_MAX)) {
+    return(LOGGER_ERR_FORMAT_INVALID);
+  }
+
+  output = logger_output_driver_find(LOGGER_OUTPUT_TYPE_DRIVER, driver, context, (logger_output_record_function_t)NULL);
+
+  /* GUARD: output must be registered */
+  if (output == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  output->format = format;
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query counters of an output driver.
+ *
+ * Lines and bytes passed to the driver since it was registered.
+ *
+ * \param[in]     driver   Registered driver.
+ * \param[in]     context  Context given during registration.
+ * \param[out]    stats    Counters.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_driver_stats_get(const logger_output_driver_t *driver,
+                                               void                         *context,
+                                               logger_output_stats_t        *stats)
+{
+  return(logger_output_common_stats_get(LOGGER_OUTPUT_TYPE_DRIVER,
+                                        (FILE *)NULL,
+                                        (logger_output_function_t)NULL,
+                                        driver,
+                                        context,
+                                        stats));
+}
+
+
+/***************************************************************************//**
+ * \brief  Register a global record output function.
+ *
+ * The function gets ID, level, time, call site and message of every message
+ * as \c logger_record_t. No line is formatted for it, if only record outputs
+ * print a message neither prefix nor colors are formatted. The default logging
+ * level is set to \c LOGGER_UNKNOWN thus no messages will be passed.
+ *
+ * \param[in]     function  User provided record function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_record_register(logger_output_record_function_t function)
+{
+  /* GUARD: check for valid function */
+  if (function == NULL) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  return(logger_output_driver_add(LOGGER_OUTPUT_TYPE_RECORD, &logger_output_record_driver, NULL, function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister a global record output function.
+ *
+ * \param[in]     function  User provided record function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_record_deregister(logger_output_record_function_t function)
+{
+  return(logger_output_driver_remove(logger_output_driver_find(LOGGER_OUTPUT_TYPE_RECORD, (const logger_output_driver_t *)NULL, NULL, function)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Search a global record output function.
+ *
+ * \param[in]     function  User provided record function.
+ *
+ * \return        \c logger_true if function is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_record_is_registered(logger_output_record_function_t function)
+{
+  return((logger_output_driver_find(LOGGER_OUTPUT_TYPE_RECORD, (const logger_output_driver_t *)NULL, NULL, function) != NULL) ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for global record output function.
+ *
+ * \param[in]     function  User provided record function.
+ * \param[in]     level     Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_record_level_set(logger_output_record_function_t function,
+                                               const logger_level_t            level)
+{
+  return(logger_output_driver_level(logger_output_driver_find(LOGGER_OUTPUT_TYPE_RECORD, (const logger_output_driver_t *)NULL, NULL, function), level));
+}
+
+
+/***************************************************************************//**
+ * \brief  Open a managed output file with rotation.
+ *
+ * Open the file given by \p path for appending and register the resulting
+ * stream as global output. The stream can then be used with every
+ * \c logger_output_*() and \c logger_id_output_*() function like any other
+ * file stream. Before a line would make the file exceed \p rotate_bytes or
+ * when the file is older than \p rotate_interval seconds a background thread
+ * renames the current file to `path.N` and opens a new file. Writers never wait
+ * for it, lines written until the new file is opened still go to the renamed
+ * file. N increases with every rotation, so the highest number is the newest
+ * rotated file. Only \p keep rotated files are kept, older ones are removed.
+ * Rotated files are never renamed again, N continues after the highest number
+ * found next to \p path, also across restarts of the program.
+ * Rotation only happens between complete lines, the returned stream stays valid
+ * across rotations.
+ *
+ * \param[in]     path             Path of the file to write.
+ * \param[in]     rotate_bytes     Maximum file size in bytes, 0 disables.
+ * \param[in]     rotate_interval  Maximum file age in seconds, 0 disables.
+ * \param[in]     keep             Number of rotated files to keep, 0 keeps all.
+ *
+ * \return        Registered file stream, \c NULL if an error occurred.
+ ******************************************************************************/
+FILE *logger_output_file_open(const char     *path,
+                              const size_t   rotate_bytes,
+                              const uint32_t rotate_interval,
+                              const uint16_t keep)
+{
+  logger_file_t *file = (logger_file_t *)NULL;
+  size_t        index;
+
+  /* GUARD: path must be valid and leave room for the generation suffix */
+  if (path == NULL || path[0] == '\0' ||
+      strlen(path) + LOGGER_FILE_SUFFIX_MAX >= LOGGER_PATH_MAX) {
+    return((FILE *)NULL);
+  }
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_files) ; index++) {
+    if (logger_files[index].used == logger_false) {
+      file = &logger_files[index];
+      break;
+    }
+  }
+
+  /* GUARD: all managed files are used */
+  if (file == NULL) {
+    return((FILE *)NULL);
+  }
+
+  /* GUARD: rotation needs the background thread */
+  if (logger_compress_start() != LOGGER_OK) {
+    return((FILE *)NULL);
+  }
+
+  (void)memset(file, 0, sizeof(*file));
+  (void)logger_string_copy(file->path, path, sizeof(file->path));
+  file->next_fd         = -1;
+  file->rotate_bytes    = rotate_bytes;
+  file->rotate_interval = rotate_interval;
+  file->keep            = keep;
+
+  /* continue numbering of already rotated files and remove obsolete ones */
+  logger_file_scan(file);
+
+  file->stream = fopen(file->path, "a");
+
+  /* GUARD: file could not be opened */
+  if (file->stream == NULL) {
+    return((FILE *)NULL);
+  }
+
+  file->used   = logger_true;
+  file->bytes  = (size_t)ftell(file->stream);
+  file->opened = time(NULL);
+
+  if (logger_output_register(file->stream) != LOGGER_OK) {
+    (void)fclose(file->stream);
+    (void)memset(file, 0, sizeof(*file));
+
+    return((FILE *)NULL);
+  }
+
+  return(file->stream);
+}
+
+
+/***************************************************************************//**
+ * \brief  Close a managed output file.
+ *
+ * Deregister the stream from global outputs and from the outputs of all IDs
+ * and close the file afterwards. Waits until all rotated files are compressed.
+ *
+ * \param[in]     stream  Stream returned by \c logger_output_file_open().
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_file_close(FILE *stream)
+{
+  logger_file_t *file = logger_file_find(stream);
+  logger_id_t   id;
+
+  /* GUARD: stream must be a managed file */
+  if (file == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  for (id = 0 ; id < (logger_id_t)LOGGER_ELEMENTS(logger_control) ; id++) {
+    if (logger_control[id].used == logger_true) {
+      while (logger_id_output_deregister(id, stream) == LOGGER_OK) {
+        /* remove all registrations */
+      }
+    }
+  }
+
+  while (logger_output_deregister(stream) == LOGGER_OK) {
+    /* remove all registrations */
+  }
+
+  /* no writer is left, finish a rotation in progress */
+  logger_compress_rotate_wait(file);
+
+  if (file->next_fd >= 0) {
+    logger_file_swap(file, file->next_fd);
+  }
+
+  (void)fclose(file->stream);
+
+  /* rotated files are complete when the file is closed */
+  if (file->compress == logger_true) {
+    logger_compress_drain();
+  }
+
+  (void)memset(file, 0, sizeof(*file));
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Check if stream is a managed output file.
+ *
+ * \param[in]     stream  File stream to check.
+ *
+ * \return        \c logger_true if stream is a managed file, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_file_is_open(FILE *stream)
+{
+  return((logger_file_find(stream) != NULL) ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Rotate a managed output file now.
+ *
+ * Independent of size and age rotate the file immediately, e.g. after an
+ * external tool requested it. Waits until the background thread has renamed
+ * the file. If a continued line is open the new file is used at its end.
+ *
+ * \param[in]     stream  Stream returned by \c logger_output_file_open().
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_file_rotate(FILE *stream)
+{
+  logger_return_t ret;
+  logger_file_t   *file = logger_file_find(stream);
+
+  /* GUARD: stream must be a managed file */
+  if (file == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  flockfile(file->stream);
+  ret = logger_file_rotate_request(file);
+  funlockfile(file->stream);
+
+  logger_compress_rotate_wait(file);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable compression of rotated files.
+ *
+ * Every file rotated afterwards is compressed to `path.N.lz` by a background
+ * thread, the writing thread never waits for compression. The file is written
+ * as independent blocks which can be decompressed with \c logger_decompress()
+ * or the `logger-decompress` tool.
+ *
+ * \param[in]     stream  Stream returned by \c logger_output_file_open().
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_file_compression_enable(FILE *stream)
+{
+  logger_return_t ret  = LOGGER_OK;
+  logger_file_t   *file = logger_file_find(stream);
+
+  /* GUARD: stream must be a managed file */
+  if (file == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  ret = logger_compress_start();
+
+  if (ret == LOGGER_OK) {
+    file->compress = logger_true;
+  }
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable compression of rotated files.
+ *
+ * Already queued files are still compressed.
+ *
+ * \param[in]     stream  Stream returned by \c logger_output_file_open().
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_file_compression_disable(FILE *stream)
+{
+  logger_file_t *file = logger_file_find(stream);
+
+  /* GUARD: stream must be a managed file */
+  if (file == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  file->compress = logger_false;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query compression of rotated files.
+ *
+ * \param[in]     stream  Stream returned by \c logger_output_file_open().
+ *
+ * \return        \c logger_true if compression is enabled, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_file_compression_is_enabled(FILE *stream)
+{
+  logger_file_t *file = logger_file_find(stream);
+
+  return((file != NULL) ? file->compress : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the queue of background rotation and compression.
+ *
+ * Rotations and compressions of all managed files share a queue of
+ * \c LOGGER_COMPRESS_JOBS_MAX jobs. A rotation not queued is tried again with
+ * the next line, a rotated file not queued stays uncompressed. The peak and
+ * the dropped jobs are cleared by \c logger_stats_reset().
+ *
+ * \param[out]    stats   Counters.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_file_queue_stats_get(logger_file_queue_stats_t *stats)
+{
+  /* GUARD: check for valid stats */
+  if (stats == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
+  }
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  stats->queued  = logger_compress.count;
+  stats->peak    = logger_compress.peak;
+  stats->dropped = logger_compress.dropped;
+
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Decompress a compressed log file.
+ *
+ * Read blocks written by the background compression from \p source and write
+ * the original text to \p destination. Each block is validated before it is
+ * decompressed.
+ *
+ * \param[in]     source       Stream of compressed data.
+ * \param[in]     destination  Stream for decompressed data.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_decompress(FILE *source,
+                                  FILE *destination)
+{
+  uint8_t  header[LOGGER_COMPRESS_HEADER_SIZE];
+  size_t   size;
+  size_t   length;
+  uint32_t method;
+  long     decompressed;
+
+  /* GUARD: streams must be valid */
+  if (source == NULL || destination == NULL) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  while ((size = fread(header, 1, sizeof(header), source)) > 0) {
+    /* GUARD: header must be complete */
+    if (size != sizeof(header)) {
+      return(LOGGER_ERR_DATA_INVALID);
+    }
+
+    method = header[4];
+    size   = logger_compress_get32(&header[8]);
+    length = logger_compress_get32(&header[12]);
+
+    /* GUARD: header must be sane and block complete */
+    if (memcmp(header, logger_compress_magic, sizeof(logger_compress_magic)) != 0 ||
+        size > LOGGER_COMPRESS_BLOCK_SIZE ||
+        length > LOGGER_COMPRESS_BLOCK_BOUND - LOGGER_COMPRESS_HEADER_SIZE ||
+        fread(logger_decompress_input, 1, length, source) != length) {
+      return(LOGGER_ERR_DATA_INVALID);
+    }
+
+    switch (method) {
+      case LOGGER_COMPRESS_METHOD_STORED:
+        decompressed = (length == size) ? (long)length : -1;
+        (void)memcpy(logger_decompress_output, logger_decompress_input, length);
+        break;
+
+      case LOGGER_COMPRESS_METHOD_LZ:
+        decompressed = logger_lz_decompress(logger_decompress_input, length, logger_decompress_output, size);
+        break;
+
+#ifdef LOGGER_HAVE_ZLIB
+      case LOGGER_COMPRESS_METHOD_ZLIB:
+        {
+          uLongf zlength = (uLongf)size;
+
+          decompressed = (uncompress(logger_decompress_output, &zlength, logger_decompress_input, (uLong)length) == Z_OK) ? (long)zlength : -1;
+        }
+        break;
+#endif /* LOGGER_HAVE_ZLIB */
+
+      default:
+        decompressed = -1;
+        break;
+    }
+
+    /* GUARD: block must decompress to announced size */
+    if (decompressed != (long)size) {
+      return(LOGGER_ERR_DATA_INVALID);
+    }
+
+    if (fwrite(logger_decompress_output, 1, size, destination) != size) {
+      return(LOGGER_ERR_STREAM_INVALID);
+    }
+  }
+
+  /* GUARD: stop on read errors */
+  if (ferror(source) != 0) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Register the flight recorder output.
+ *
+ * The flight recorder keeps the most recent messages in a ring buffer of
+ * \c LOGGER_RECORDER_SIZE bytes in memory. Unlike other outputs it records the
+ * messages of all enabled IDs independent of the level of the ID, so debug
+ * messages that are never printed are still available for a post-mortem
+ * analysis. The default logging level is set to \c LOGGER_UNKNOWN thus no
+ * messages will be recorded.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_register(void)
+{
+  /* start with an empty ring, keep writing at head so a recorder file stays one ring */
+  if (logger_recorder.count <= 0) {
+    logger_recorder.first = (uint32_t)LOGGER_ATOMIC_LOAD(&logger_recorder.cursor);
+  }
+
+  logger_recorder.count++;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister the flight recorder output.
+ *
+ * Recorded messages are kept until the recorder is registered again.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_deregister(void)
+{
+  /* GUARD: recorder must be registered */
+  if (logger_recorder.count <= 0) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  logger_recorder.count--;
+
+  if (logger_recorder.count <= 0) {
+    logger_recorder.level = LOGGER_UNKNOWN;
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Check if flight recorder output is registered.
+ *
+ * \return        \c logger_true if recorder is registered, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_output_recorder_is_registered(void)
+{
+  return((logger_recorder.count > 0) ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for flight recorder output.
+ *
+ * Set the minimum logging level of recorded messages.
+ *
+ * \param[in]     level   Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_level_set(const logger_level_t level)
+{
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  return(logger_output_recorder_level_mask_set(LOGGER_ALL ^ (level - 1)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for flight recorder output.
+ *
+ * \return        Currently set logging level.
+ ******************************************************************************/
+logger_level_t logger_output_recorder_level_get(void)
+{
+  /* return only lowest set bit */
+  return(LOGGER_ALL ^ (logger_output_recorder_level_mask_get() - 1));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level mask for flight recorder output.
+ *
+ * \param[in]     level   Level mask to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_level_mask_set(const logger_level_t level)
+{
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* GUARD: recorder must be registered */
+  if (logger_recorder.count <= 0) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  logger_recorder.level = level;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level mask for flight recorder output.
+ *
+ * \return        Currently set logging level mask.
+ ******************************************************************************/
+logger_level_t logger_output_recorder_level_mask_get(void)
+{
+  return((logger_recorder.count > 0) ? logger_recorder.level : LOGGER_UNKNOWN);
+}
+
+
+/***************************************************************************//**
+ * \brief  Dump flight recorder contents.
+ *
+ * Write all recorded messages, oldest first, to the given stream. Each line
+ * starts with the sequence number and the time of the message followed by
+ * ID name, level, file, function and line.
+ *
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_dump(FILE *stream)
+{
+  /* GUARD: check for valid stream */
+  if (stream == NULL) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: called by an output */
+  if (logger_print_lock(NULL) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* recorder writes unbuffered, keep order of already buffered output */
+  (void)fflush(stream);
+
+  logger_recorder_dump(fileno(stream));
+
+  logger_print_unlock(NULL);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Dump flight recorder contents on crash.
+ *
+ * Install handlers for \c SIGSEGV, \c SIGABRT, \c SIGBUS, \c SIGFPE and
+ * \c SIGILL. On such a signal the recorder contents are written to the file
+ * given by \p path or to \c stderr if \p path is \c NULL. Afterwards the
+ * default action of the signal takes place.
+ *
+ * \param[in]     path    Path of dump file or \c NULL for \c stderr.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_crash_dump_enable(const char *path)
+{
+  struct sigaction action;
+  size_t           index;
+
+  /* GUARD: path must fit into storage */
+  if (path != NULL && strlen(path) >= sizeof(logger_recorder.crash_path)) {
+    return(LOGGER_ERR_STRING_TOO_LONG);
+  }
+
+  if (path != NULL) {
+    (void)logger_string_copy(logger_recorder.crash_path, path, sizeof(logger_recorder.crash_path));
+  }
+  else {
+    logger_recorder.crash_path[0] = '\0';
+  }
+
+  /* GUARD: handlers are already installed */
+  if (logger_recorder.crash_dump == logger_true) {
+    return(LOGGER_OK);
+  }
+
+  (void)memset(&action, 0, sizeof(action));
+  action.sa_handler = logger_recorder_crash_handler;
+  action.sa_flags   = SA_RESETHAND;
+  (void)sigemptyset(&action.sa_mask);
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_recorder_signals) ; index++) {
+    (void)sigaction(logger_recorder_signals[index], &action, &logger_recorder.crash_actions[index]);
+  }
+
+  logger_recorder.crash_dump = logger_true;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Stop dumping flight recorder contents on crash.
+ *
+ * Restore the signal handlers which were active before
+ * \c logger_output_recorder_crash_dump_enable().
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_crash_dump_disable(void)
+{
+  size_t index;
+
+  /* GUARD: handlers must be installed */
+  if (logger_recorder.crash_dump == logger_false) {
+    return(LOGGER_OK);
+  }
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_recorder_signals) ; index++) {
+    (void)sigaction(logger_recorder_signals[index], &logger_recorder.crash_actions[index], NULL);
+  }
+
+  logger_recorder.crash_dump = logger_false;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Keep flight recorder in a file.
+ *
+ * Map the file given by \p path as ring buffer of the flight recorder. The
+ * kernel keeps the contents of the shared mapping, so the recorded messages
+ * survive even if the process is killed by \c SIGKILL or the OOM killer. A
+ * file written before is continued where it ended. Use
+ * \c logger_output_recorder_recover() or the `logger-recover` tool to read
+ * the messages.
+ *
+ * \param[in]     path    Path of recorder file.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_file_open(const char *path)
+{
+  logger_recorder_file_t   *header;
+  logger_recorder_record_t *record;
+  struct stat              status;
+  size_t                   map_size = sizeof(logger_recorder_file_t) + LOGGER_RECORDER_SIZE;
+  size_t                   position;
+  size_t                   head = 0;
+  uint32_t                 sequence = 0;
+  logger_bool_t            valid;
+  void                     *map;
+  int                      fd;
+
+  /* GUARD: check for valid path */
+  if (path == NULL || path[0] == '\0') {
+    return(LOGGER_ERR_STRING_INVALID);
+  }
+
+  fd = open(path, O_RDWR | O_CREAT, 0644);
+
+  /* GUARD: file must be accessible */
+  if (fd < 0) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  valid = (fstat(fd, &status) == 0 && (size_t)status.st_size == map_size) ? logger_true : logger_false;
+
+  if (valid == logger_false &&
+      (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)map_size) != 0)) {
+    (void)close(fd);
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+
+  /* GUARD: file must be mappable */
+  if (map == MAP_FAILED) {
+    return(LOGGER_ERR_OUT_OF_MEMORY);
+  }
+
+  /* replace a previously used file */
+  (void)logger_output_recorder_file_close();
+
+  header = (logger_recorder_file_t *)map;
+
+  if (valid == logger_false ||
+      memcmp(header->magic, LOGGER_RECORDER_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != LOGGER_RECORDER_FILE_VERSION ||
+      header->header_size != sizeof(*header) ||
+      header->size != LOGGER_RECORDER_SIZE) {
+    (void)memset(map, 0, map_size);
+    (void)memcpy(header->magic, LOGGER_RECORDER_FILE_MAGIC, sizeof(header->magic));
+    header->version     = LOGGER_RECORDER_FILE_VERSION;
+    header->header_size = sizeof(*header);
+    header->size        = LOGGER_RECORDER_SIZE;
+  }
+
+  logger_recorder.map      = map;
+  logger_recorder.map_size = map_size;
+  logger_recorder.buffer   = (uint8_t *)map + sizeof(*header);
+  logger_recorder.size     = LOGGER_RECORDER_SIZE;
+
+  /* continue after the newest record */
+  for (position = logger_recorder_scan(logger_recorder.buffer, logger_recorder.size, 0) ;
+       position < logger_recorder.size ;
+       position = logger_recorder_scan(logger_recorder.buffer, logger_recorder.size, position + record->size)) {
+    record = (logger_recorder_record_t *)&logger_recorder.buffer[position];
+
+    if (head == 0 || record->sequence > sequence) {
+      sequence = record->sequence;
+      head     = position + record->size;
+    }
+  }
+
+  if (head + sizeof(logger_recorder_record_t) > logger_recorder.size) {
+    head = 0;
+  }
+
+  LOGGER_ATOMIC_STORE(&logger_recorder.cursor, ((uint64_t)head << 32) | sequence);
+  logger_recorder.first = sequence;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Stop keeping flight recorder in a file.
+ *
+ * Unmap the recorder file, the recorder continues with an empty ring buffer in
+ * memory. The file keeps the recorded messages.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_file_close(void)
+{
+  /* GUARD: recorder file must be open */
+  if (logger_recorder.map == NULL) {
+    return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+  }
+
+  (void)munmap(logger_recorder.map, logger_recorder.map_size);
+
+  logger_recorder.map      = NULL;
+  logger_recorder.map_size = 0;
+  logger_recorder.buffer   = (uint8_t *)logger_recorder_storage;
+  logger_recorder.size     = sizeof(logger_recorder_storage);
+  logger_recorder.first    = (uint32_t)LOGGER_ATOMIC_LOAD(&logger_recorder.cursor);
+  LOGGER_ATOMIC_STORE(&logger_recorder.cursor, (uint64_t)logger_recorder.first);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Recover messages from a flight recorder file.
+ *
+ * Read a file written by \c logger_output_recorder_file_open(), possibly by a
+ * process that died, or by an output with \c LOGGER_OUTPUT_FORMAT_BINARY and
+ * write the recorded messages oldest first to \p stream. Records which were
+ * torn by the death of the process fail their checksum and are skipped.
+ *
+ * \param[in]     path    Path of recorder file.
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_recorder_recover(const char *path,
+                                               FILE       *stream)
+{
+  const logger_recorder_file_t   *header;
+  const logger_recorder_record_t *record;
+  const uint8_t                  *buffer;
+  logger_recorder_dump_t         dump;
+  struct stat                    status;
+  size_t                         size;
+  size_t                         position;
+  size_t                         newest = 0;
+  uint32_t                       sequence = 0;
+  logger_bool_t                  found = logger_false;
+  logger_bool_t                  ring  = logger_true;
+  void                           *map;
+  int                            fd;
+
+  /* GUARD: check for valid path */
+  if (path == NULL || path[0] == '\0') {
+    return(LOGGER_ERR_STRING_INVALID);
+  }
+
+  /* GUARD: check for valid stream */
+  if (stream == NULL) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  fd = open(path, O_RDONLY);
+
+  /* GUARD: file must be readable */
+  if (fd < 0) {
+    return(LOGGER_ERR_STREAM_INVALID);
+  }
+
+  /* GUARD: file must contain a header */
+  if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(*header)) {
+    (void)close(fd);
+    return(LOGGER_ERR_DATA_INVALID);
+  }
+
+  map = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+
+  /* GUARD: file must be mappable */
+  if (map == MAP_FAILED) {
+    return(LOGGER_ERR_OUT_OF_MEMORY);
+  }
+
+  header = (const logger_recorder_file_t *)map;
+
+  if (logger_recorder_valid((const uint8_t *)map, (size_t)status.st_size, 0) == logger_true) {
+    /* records of a binary output follow each other without header */
+    buffer = (const uint8_t *)map;
+    size   = (size_t)status.st_size;
+    ring   = logger_false;
+  }
+  else {
+    /* GUARD: check header */
+    if (memcmp(header->magic, LOGGER_RECORDER_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != LOGGER_RECORDER_FILE_VERSION ||
+        header->header_size != sizeof(*header) ||
+        header->size != (uint64_t)status.st_size - sizeof(*header)) {
+      (void)munmap(map, (size_t)status.st_size);
+      return(LOGGER_ERR_DATA_INVALID);
+    }
+
+    buffer = (const uint8_t *)map + sizeof(*header);
+    size   = (size_t)header->size;
+  }
+
+  /* the newest record splits the ring into older and newer records, the last record ends a file of a binary output */
+  for (position = logger_recorder_scan(buffer, size, 0) ;
+       position < size ;
+       position = logger_recorder_scan(buffer, size, position + record->size)) {
+    record = (const logger_recorder_record_t *)&buffer[position];
+
+    if (found == logger_false || record->sequence > sequence || ring == logger_false) {
+      found    = logger_true;
+      sequence = record->sequence;
+      newest   = position;
+    }
+  }
+
+  (void)fflush(stream);
+  dump.fd   = fileno(stream);
+  dump.used = 0;
+
+  if (found == logger_true) {
+    record = (const logger_recorder_record_t *)&buffer[newest];
+
+    /* older records behind the newest one */
+    for (position = logger_recorder_scan(buffer, size, newest + record->size) ;
+         position < size ;
+         position = logger_recorder_scan(buffer, size, position + ((const logger_recorder_record_t *)&buffer[position])->size)) {
+      logger_recorder_dump_record(&dump, (const logger_recorder_record_t *)&buffer[position]);
+    }
+
+    /* newer records from the start of the ring up to the newest one */
+    for (position = logger_recorder_scan(buffer, size, 0) ;
+         position <= newest ;
+         position = logger_recorder_scan(buffer, size, position + ((const logger_recorder_record_t *)&buffer[position])->size)) {
+      logger_recorder_dump_record(&dump, (const logger_recorder_record_t *)&buffer[position]);
+    }
+  }
+
+  logger_recorder_dump_flush(&dump);
+
+  (void)munmap(map, (size_t)status.st_size);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Request a logging ID.
+ *
+ * Request a ID for later use with calls to \c logger(). If an ID with the same
+ * symbolic name has already been requested that ID is returned otherwise a new
+ * ID is allocated. Each logging ID is disabled by default.
+ *
+ * \param[in]     name    Symbolic name for the ID.
+ *
+ * \return        ID number if ID is available, error code otherwise.
+ ******************************************************************************/
+logger_id_t logger_id_request(const char *name)
+{
+  logger_id_t   id = logger_id_unknown;
+  size_t        index;
+  logger_bool_t found;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(logger_id_unknown);
+  }
+
+  /* GUARD: check for valid name */
+  if (name == NULL) {
+    return(logger_id_unknown);
+  }
+
+  /* start search */
+  found = logger_false;
+
+  /* search for an already existing ID with the same name */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
+    if (logger_control[index].used == logger_true) {
+      if (strncmp(logger_control[index].name, name, LOGGER_ELEMENTS(logger_control[index].name)) == 0) {
+        logger_control[index].count++;
+        found = logger_true;
+        break;
+      }
+    }
+  }
+
+  /* search for an available ID */
+  if (found == logger_false) {
+    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
+      if (logger_control[index].used == logger_false) {
+        found = logger_true;
+        /* reset the ID, threads may still read the plan published by the release */
+        (void)memset(&logger_control[index], 0, offsetof(logger_control_t, plan));
+
+        /* initialize the ID */
+        logger_control[index].used                  = logger_true;
+        logger_control[index].count                 = 1;
+        logger_control[index].enabled               = logger_false;
+        logger_control[index].level                 = LOGGER_UNKNOWN;
+        logger_control[index].prefix                = LOGGER_PFX_UNSET;
+        logger_control[index].color                 = logger_false;
+        logger_control[index].color_string.begin[0] = '\0';
+        logger_control[index].color_string.end[0]   = '\0';
+        logger_control[index].color_string_changed  = logger_false;
+
+        /* copy the name */
+        (void)strncpy(logger_control[index].name, name, LOGGER_ELEMENTS(logger_control[index].name));
+        logger_control[index].name[LOGGER_ELEMENTS(logger_control[index].name) - 1] = '\0';
+
+        /* apply level specification once per ID */
+        logger_level_rule_apply((logger_id_t)index);
+
+        /* inherit level of parent ID */
+        logger_id_level_resolve();
+
+        /* update unified output lists of each ID */
+        (void)logger_output_common_unify((logger_id_t)index);
+
+        break;
+      }
+    }
+  }
+
+  /* found an empty slot */
+  if (found == logger_true) {
+    id = (logger_id_t)index;
+  }
+  else {
+    id = logger_id_unknown;
+  }
+
+  return(id);
+}
+
+
+/***************************************************************************//**
+ * \brief  Release a logging ID.
+ *
+ * Release a ID. After this call logging to this ID is not possible anymore.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_release(const logger_id_t id)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  logger_control[id].count--;
+
+  /* if this was the last ID */
+  if (logger_control[id].count <= 0) {
+    /* outputs will change, print repeat and rate limit messages */
+    logger_config_change();
+
+    /* forget kept messages and partial lines */
+    (void)pthread_mutex_lock(&logger_lazy_mutex);
+    logger_lazy_drop(id);
+    (void)pthread_mutex_unlock(&logger_lazy_mutex);
+    logger_continuation_drop(id);
+
+    /* print suppressed repeats while outputs of the ID still exist */
+    if (logger_print_lock(&logger_repeat_mutex) == logger_true) {
+      logger_fingerprint_drop(id);
+      logger_print_unlock(&logger_repeat_mutex);
+    }
+
+    /* wait until no thread prints with the outputs of the ID anymore */
+    logger_control[id].used = logger_false;
+    logger_plan_release(id);
+
+    /* reset the ID, the plan stays valid for threads which logged too late */
+    (void)memset(&logger_control[id], 0, offsetof(logger_control_t, plan));
+
+    /* reset all ID dependent values to defaults */
+    logger_control[id].used                  = logger_false;
+    logger_control[id].count                 = 0;
+    logger_control[id].enabled               = logger_false;
+    logger_control[id].level                 = LOGGER_UNKNOWN;
+    logger_control[id].prefix                = LOGGER_PFX_UNSET;
+    logger_control[id].color                 = logger_false;
+    logger_control[id].color_string.begin[0] = '\0';
+    logger_control[id].color_string.end[0]   = '\0';
+    logger_control[id].color_string_changed  = logger_false;
+    logger_control[id].name[0]               = '\0';
+
+    /* reset outputs */
+    (void)memset(logger_control[id].outputs, 0, sizeof(logger_control[id].outputs));
+
+    /* children inherit from further ancestors now */
+    logger_id_level_resolve();
+
+    /* publish the configuration of each ID */
+    (void)logger_output_common_unify(id);
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable a logging ID for output.
+ *
+ * Enable given logging ID for all outputs.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_enable(const logger_id_t id)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* enable given ID */
+  logger_control[id].enabled = logger_true;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable a logger ID for output.
+ *
+ * Disable given logging ID for all outputs.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_disable(const logger_id_t id)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  /* disable given ID */
+  logger_control[id].enabled = logger_false;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the current enable state of ID.
+ *
+ * Query the current enable state of given logging ID.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c logger_true if id is enabled, \c logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_is_enabled(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* ID enable state */
+  return(logger_control[id].enabled);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query if a given level for a given ID would generate any output
+ *
+ * Query if a call to logger() for the given ID and level would generate any
+ * output. This is useful to to avoid expensive calculations when subsequent
+ * calls to logger() would never output the results.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     level   Level.
+ *
+ * \return        \c logger_true if output would be generated, \c logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_generates_output(const logger_id_t    id,
+                                         const logger_level_t level)
+{
+  logger_bool_t       generates_output = logger_false;
+  const logger_plan_t *plan;
+  size_t              index;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(logger_false);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(logger_false);
+  }
+
+  logger_plan_read_lock();
+  plan  = LOGGER_ATOMIC_LOAD(&logger_control[id].plan);
+
+  /* check if ID is enabled and level is enabled, for this thread at least */
+  if ((plan->enabled == logger_true) &&
+      (((plan->level | logger_thread_level | logger_thread_levels[id]) & level) != 0)) {
+    /* loop over all possible outputs */
+    for (index = 0 ; index < LOGGER_ELEMENTS(plan->outputs) ; index++) {
+      /* heck if output is enabled and level is enabled */
+      if ((plan->outputs[index].count > 0) &&
+          ((plan->outputs[index].level & level) != 0)) {
+        generates_output = logger_true;
+        break;
+      }
+    }
+  }
+
+  logger_plan_read_unlock();
+
+  return(generates_output);
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for ID.
+ *
+ * Set the minimum logging level for given ID. Only log messages equal or above
+ * the given level will be printed to outputs. Children of the ID in the dotted
+ * hierarchy of names without own level, e.g. "db.pool" for "db", inherit it.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     level   Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_level_set(const logger_id_t    id,
+                                    const logger_level_t level)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  /* set ID level and pass it to children */
+  logger_control[id].own_level_set = logger_true;
+  logger_control[id].own_level     = LOGGER_ALL ^ (level - 1);
+  logger_control[id].level         = logger_control[id].own_level;
+  logger_id_level_resolve();
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for ID.
+ *
+ * Query the currently set minimum level for the given logging ID.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        Currently set level.
+ ******************************************************************************/
+logger_level_t logger_id_level_get(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* get ID level, return only lowest set bit */
+  return(LOGGER_ALL ^ (logger_control[id].level - 1));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level mask for ID.
+ *
+ * Set a logging level mask for given ID. Only log messages with a level set in
+ * the given level mask will be printed to outputs. Children of the ID without
+ * own level inherit it.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     level   Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_level_mask_set(const logger_id_t    id,
+                                         const logger_level_t level)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  /* set ID level and pass it to children */
+  logger_control[id].own_level_set = logger_true;
+  logger_control[id].own_level     = level;
+  logger_control[id].level         = level;
+  logger_id_level_resolve();
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for ID.
+ *
+ * Query the currently set minimum level for the given logging ID.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        Currently set level.
+ ******************************************************************************/
+logger_level_t logger_id_level_mask_get(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  return(logger_control[id].level);
+}
+
+
+/***************************************************************************//**
+ * \brief  Inherit logging level of parent ID.
+ *
+ * Forget the level set for given ID. The ID uses the level of the nearest
+ * ancestor in the dotted hierarchy of names which has a level set, e.g. ID
+ * "db.pool.conn" uses the level of "db.pool" or else of "db". Without such
+ * an ancestor the ID has no level.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_level_inherit(const logger_id_t id)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  logger_control[id].own_level_set = logger_false;
+  logger_control[id].own_level     = LOGGER_UNKNOWN;
+  logger_id_level_resolve();
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Find ID by name.
+ *
+ * \param[in]     name    Name of ID.
+ *
+ * \return        Index of ID, \c LOGGER_ELEMENTS(logger_control) if not found.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_id_find(const char *name)
+{
+  size_t index;
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
+    if ((index != (size_t)logger_system_id) &&
+        (logger_control[index].used == logger_true) &&
+        (strcmp(logger_control[index].name, name) == 0)) {
+      break;
+    }
+  }
+
+  return(index);
+}
+
+
+/***************************************************************************//**
+ * \brief  Resolve effective levels of all IDs.
+ *
+ * IDs without own level get the level of the nearest ancestor which has one.
+ * This is done whenever a level or the set of IDs changes, so checking the
+ * level of a message never depends on the depth of the hierarchy. While
+ * configuration is batched only IDs with own level change until commit.
+ ******************************************************************************/
+LOGGER_INLINE void logger_id_level_resolve(void)
+{
+  char           name[LOGGER_NAME_MAX];
+  char           *dot;
+  logger_level_t level;
+  size_t         index;
+  size_t         parent;
+
+  /* GUARD: resolve once when batched configuration is committed */
+  if (logger_config_depth > 0) {
+    logger_config_resolve = logger_true;
+    return;
+  }
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
+    if ((index == (size_t)logger_system_id) ||
+        (logger_control[index].used == logger_false)) {
+      continue;
+    }
+
+    if (logger_control[index].own_level_set == logger_true) {
+      level = logger_control[index].own_level;
+    }
+    else {
+      level = LOGGER_UNKNOWN;
+      (void)memcpy(name, logger_control[index].name, sizeof(name));
+
+      /* walk up the hierarchy until an ancestor has its own level */
+      while ((dot = strrchr(name, '.')) != NULL) {
+        *dot   = '\0';
+        parent = logger_id_find(name);
+
+        if ((parent < LOGGER_ELEMENTS(logger_control)) &&
+            (logger_control[parent].own_level_set == logger_true)) {
+          level = logger_control[parent].own_level;
+          break;
+        }
+      }
+    }
+
+    /* only IDs whose level changed publish a new plan */
+    if (logger_control[index].level != level) {
+      logger_control[index].level = level;
+      logger_plan_mark((logger_id_t)index);
+    }
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Match ID name against a pattern.
+ *
+ * A '*' in the pattern matches any sequence of characters, a '?' matches a
+ * single character. All other characters match themselves.
+ *
+ * \param[in]     pattern Pattern to match.
+ * \param[in]     name    ID name.
+ *
+ * \return        \c logger_true if name matches pattern, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_pattern_match(const char *pattern,
+                                                 const char *name)
+{
+  const char *star_pattern = NULL;
+  const char *star_name    = NULL;
+
+  while (*name != '\0') {
+    if (*pattern == '*') {
+      /* remember position to retry with a longer match */
+      star_pattern = ++pattern;
+      star_name    = name;
+    }
+    else if ((*pattern == '?') || (*pattern == *name)) {
+      pattern++;
+      name++;
+    }
+    else if (star_pattern != NULL) {
+      /* let the last '*' match one more character */
+      pattern = star_pattern;
+      name    = ++star_name;
+    }
+    else {
+      return(logger_false);
+    }
+  }
+
+  while (*pattern == '*') {
+    pattern++;
+  }
+
+  return((*pattern == '\0') ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Get level for name.
+ *
+ * Translate a level name like "DEBUG" or "LOGGER_DEBUG" ignoring case.
+ *
+ * \param[in]     name    Level name, not terminated.
+ * \param[in]     length  Length of level name.
+ *
+ * \return        Level, \c LOGGER_UNKNOWN if name is unknown.
+ ******************************************************************************/
+LOGGER_INLINE logger_level_t logger_level_parse(const char *name,
+                                                size_t     length)
+{
+  static const char prefix[] = "LOGGER_";
+  size_t            index;
+  size_t            position;
+
+  /* skip optional prefix */
+  for (position = 0 ; position < length && position < sizeof(prefix) - 1 ; position++) {
+    if (toupper((unsigned char)name[position]) != prefix[position]) {
+      break;
+    }
+  }
+
+  if (position == sizeof(prefix) - 1) {
+    name   += position;
+    length -= position;
+  }
+
+  /* first name is LOGGER_UNKNOWN */
+  for (index = 1 ; index < LOGGER_ELEMENTS(logger_level_names) ; index++) {
+    if (strlen(logger_level_names[index]) != length) {
+      continue;
+    }
+
+    for (position = 0 ; position < length ; position++) {
+      if (toupper((unsigned char)name[position]) != logger_level_names[index][position]) {
+        break;
+      }
+    }
+
+    if (position == length) {
+      return((logger_level_t)(1 << (index - 1)));
+    }
+  }
+
+  return(LOGGER_UNKNOWN);
+}
+
+
+/***************************************************************************//**
+ * \brief  Apply level specification to ID.
+ *
+ * The first rule matching the name of the ID enables it and sets its level.
+ * IDs without matching rule are not changed. Levels of children are resolved
+ * by the caller.
+ *
+ * \param[in]     id      Logger ID.
+ ******************************************************************************/
+LOGGER_INLINE void logger_level_rule_apply(logger_id_t id)
+{
+  size_t index;
+
+  for (index = 0 ; index < logger_level_rule_count ; index++) {
+    if (logger_pattern_match(logger_level_rules[index].pattern, logger_control[id].name) == logger_true) {
+      logger_control[id].enabled       = logger_true;
+      logger_control[id].own_level_set = logger_true;
+      logger_control[id].own_level     = LOGGER_ALL ^ (logger_level_rules[index].level - 1);
+      logger_control[id].level         = logger_control[id].own_level;
+      break;
+    }
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Set levels of IDs by a specification.
+ *
+ * The specification is a comma separated list of rules \c "pattern=LEVEL",
+ * e.g. \c "net=DEBUG,db.*=WARNING,*=ERR". A pattern matches ID names, '*'
+ * matches any sequence of characters and '?' a single character. Level names
+ * are those of \c logger_level_name_get() with optional \c "LOGGER_" prefix
+ * and any case.
+ *
+ * The first matching rule enables an ID and sets its level like
+ * \c logger_id_level_set(). Rules are matched once when an ID is requested
+ * and immediately for all already requested IDs, never for each message.
+ * Later calls to \c logger_id_level_set() and friends override them.
+ *
+ * \c logger_init() calls this function with the content of the environment
+ * variable \c LOGGER_LEVELS. A \c NULL or empty specification removes all
+ * rules. An invalid specification leaves the rules unchanged.
+ *
+ * \param[in]     spec    Level specification.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_level_spec_set(const char *spec)
+{
+  logger_level_rule_t rules[LOGGER_LEVEL_RULES_MAX];
+  size_t              count = 0;
+  const char          *rule;
+  const char          *separator;
+  const char          *end;
+  size_t              pattern_length;
+  size_t              index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* parse whole specification before changing anything */
+  for (rule = (spec != NULL) ? spec : "" ; *rule != '\0' ; rule = (*end == ',') ? end + 1 : end) {
+    /* skip leading white space */
+    while (isspace((unsigned char)*rule)) {
+      rule++;
+    }
+
+    for (end = rule ; *end != '\0' && *end != ',' ; end++) {
+    }
+
+    /* ignore empty rules */
+    if (end == rule) {
+      continue;
+    }
+
+    separator = memchr(rule, '=', (size_t)(end - rule));
+
+    /* GUARD: check for separator */
+    if (separator == NULL) {
+      return(LOGGER_ERR_STRING_INVALID);
+    }
+
+    /* strip white space in front of separator */
+    for (pattern_length = (size_t)(separator - rule) ; pattern_length > 0 && isspace((unsigned char)rule[pattern_length - 1]) ; pattern_length--) {
+    }
+
+    /* GUARD: check for pattern */
+    if (pattern_length == 0) {
+      return(LOGGER_ERR_STRING_INVALID);
+    }
+
+    /* GUARD: check for space */
+    if ((count >= LOGGER_ELEMENTS(rules)) ||
+        (pattern_length >= LOGGER_ELEMENTS(rules[count].pattern))) {
+      return(LOGGER_ERR_STRING_TOO_LONG);
+    }
+
+    /* strip trailing white space */
+    while (isspace((unsigned char)end[-1])) {
+      end--;
+    }
+
+    /* strip white space behind separator */
+    do {
+      separator++;
+    } while (separator < end && isspace((unsigned char)*separator));
+
+    rules[count].level = logger_level_parse(separator, (size_t)(end - separator));
+
+    /* GUARD: check for valid level */
+    if (rules[count].level == LOGGER_UNKNOWN) {
+      return(LOGGER_ERR_LEVEL_UNKNOWN);
+    }
+
+    (void)memcpy(rules[count].pattern, rule, pattern_length);
+    rules[count].pattern[pattern_length] = '\0';
+    count++;
+
+    /* skip white space behind the rule */
+    while (*end != '\0' && *end != ',') {
+      end++;
+    }
+  }
+
+  /* outputs will change, print repeat and rate limit messages */
+  logger_config_change();
+
+  (void)memcpy(logger_level_rules, rules, count * sizeof(rules[0]));
+  logger_level_rule_count = count;
+
+  /* apply to already requested IDs */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
+    if ((index != (size_t)logger_system_id) && (logger_control[index].used == logger_true)) {
+      logger_level_rule_apply((logger_id_t)index);
+    }
+  }
+
+  logger_id_level_resolve();
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Keep messages of ID that are not printed.
+ *
+ * Messages of the given ID that are not printed because of the ID level are
+ * kept instead of being discarded. Only the latest \p count messages are
+ * kept. When a message with level \p trigger or higher is printed for this ID
+ * the kept messages are printed before it. This gives the context of a failure
+ * without printing all messages all the time.
+ *
+ * All IDs share storage for \c LOGGER_LAZY_MESSAGES_MAX messages. If it is
+ * full the oldest message of any ID is dropped.
+ *
+ * \param[in]     id       Logger ID.
+ * \param[in]     count    Number of messages to keep.
+ * \param[in]     trigger  Lowest level printing the kept messages.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_lazy_enable(const logger_id_t    id,
+                                      const uint16_t       count,
+                                      const logger_level_t trigger)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid count */
+  if ((count == 0) ||
+      (count > LOGGER_LAZY_MESSAGES_MAX)) {
+    return(LOGGER_ERR_SIZE_INVALID);
+  }
+
+  /* GUARD: check for valid trigger level, a single level is needed */
+  if ((trigger == 0) ||
+      ((trigger & ~LOGGER_ALL) != 0) ||
+      ((trigger & (trigger - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  (void)pthread_mutex_lock(&logger_lazy_mutex);
+
+  /* a smaller count drops the oldest kept messages next time */
+  LOGGER_ATOMIC_STORE(&logger_control[id].lazy_trigger, LOGGER_ALL ^ (trigger - 1));
+  LOGGER_ATOMIC_STORE(&logger_control[id].lazy_count, count);
+
+  (void)pthread_mutex_unlock(&logger_lazy_mutex);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Stop keeping messages of ID that are not printed.
+ *
+ * Messages kept so far are dropped.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_lazy_disable(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_lazy_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_lazy_drop(id);
+
+  LOGGER_ATOMIC_STORE(&logger_control[id].lazy_count, 0);
+  LOGGER_ATOMIC_STORE(&logger_control[id].lazy_trigger, LOGGER_UNKNOWN);
+
+  logger_print_unlock(&logger_lazy_mutex);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query if messages of ID that are not printed are kept.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c logger_true if messages are kept, \c logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_lazy_is_enabled(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(logger_false);
+  }
+
+  return(LOGGER_ATOMIC_LOAD(&logger_control[id].lazy_count) > 0 ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Collect partial lines of ID per thread.
+ *
+ * Messages without a trailing '\n' are normally printed right away and the
+ * next message continues the line. If several threads use the ID their parts
+ * get mixed up. With line buffering the parts are collected per thread and
+ * the whole line is printed at once when the part with '\n' arrives. The line
+ * gets prefix and level of its first part. Each thread collects only
+ * \c LOGGER_CONTINUATIONS_MAX lines at the same time, further partial lines
+ * are printed right away. Colors of a line can't be changed between parts.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_line_buffer_enable(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  LOGGER_ATOMIC_STORE(&logger_control[id].line_buffer, logger_true);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Print partial lines of ID right away.
+ *
+ * Partial lines collected so far are dropped.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_line_buffer_disable(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: called by an output */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  LOGGER_ATOMIC_STORE(&logger_control[id].line_buffer, logger_false);
+
+  logger_continuation_drop(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query if partial lines of ID are collected per thread.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        \c logger_true if partial lines are collected, \c logger_false
+ *                otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_line_buffer_is_enabled(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(logger_false);
+  }
+
+  return(LOGGER_ATOMIC_LOAD(&logger_control[id].line_buffer));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set rate limit for ID.
+ *
+ * Limit the messages of the given ID with a token bucket. The bucket holds up
+ * to \p burst messages and is refilled with \p rate messages per second. Only
+ * printed messages take a token, suppressed repeats don't. A rate of `0`
+ * disables the limit.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     rate    Messages per second.
+ * \param[in]     burst   Messages printed at once.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_rate_limit_set(const logger_id_t         id,
+                                         const logger_rate_limit_t rate,
+                                         const logger_rate_limit_t burst)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid burst */
+  if ((rate > 0) &&
+      (burst == 0)) {
+    return(LOGGER_ERR_SIZE_INVALID);
+  }
+
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_limit_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_bucket_set(&logger_control[id].bucket, rate, burst);
+
+  logger_print_unlock(&logger_limit_mutex);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query rate limit for ID.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        Messages per second, 0 if unlimited.
+ ******************************************************************************/
+logger_rate_limit_t logger_id_rate_limit_get(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(0);
+  }
+
+  return(LOGGER_ATOMIC_LOAD(&logger_control[id].bucket.rate));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging prefix for ID.
+ *
+ * Set the prefix for given ID. All messages for this ID will get this prefix
+ * from now on.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     prefix  Prefix to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_prefix_set(const logger_id_t     id,
+                                     const logger_prefix_t prefix)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid prefix */
+  if ((prefix < LOGGER_PFX_EMPTY) ||
+      (prefix > LOGGER_PFX_UNSET)) {
+    return(LOGGER_ERR_PREFIX_UNKNOWN);
+  }
+
+  /* set ID prefix */
+  logger_control[id].prefix = prefix;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging prefix for ID.
+ *
+ * Query the currently set prefix for the given logging ID.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        Currently set prefix.
+ ******************************************************************************/
+logger_prefix_t logger_id_prefix_get(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_PFX_EMPTY);
+  }
+
+  /* get ID prefix */
+  return(logger_control[id].prefix);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query name for id.
+ *
+ * Query the name for the given logging ID.
+ *
+ * \param[in]     id      Logger ID.
+ *
+ * \return        Symbolic name of the ID.
+ ******************************************************************************/
+const char *logger_id_name_get(const logger_id_t id)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(NULL);
+  }
+
+  /* get ID name */
+  return(logger_control[id].name);
+}
+
+
+/***************************************************************************//**
+ * \brief  Register an id specific output stream.
+ *
+ * The given file stream may be on of \c stdout, \c stderr or a file stream
+ * opened by the user. The default logging level is set to \c LOGGER_UNKNOWN thus
+ * no messages will appear on this stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_register(const logger_id_t id,
+                                          FILE              *stream)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* add stream to system outputs */
+  (void)logger_output_common_register(logger_control[logger_system_id].outputs,
+                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
+                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                      stream,
+                                      (logger_output_function_t)NULL);
+  (void)logger_output_common_level_set(logger_control[logger_system_id].outputs,
+                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
+                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                      stream,
+                                      (logger_output_function_t)NULL,
+                                      LOGGER_ALL);
+
+  /* add stream to global outputs */
+  ret = logger_output_common_register(logger_control[id].outputs,
+                                      LOGGER_ELEMENTS(logger_control[id].outputs),
+                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                      stream,
+                                      (logger_output_function_t)NULL);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister an id specific output stream.
+ *
+ * Remove given file stream from list of outputs.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Previous registered file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_deregister(const logger_id_t id,
+                                            FILE              *stream)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* delete stream from global outputs */
+  ret = logger_output_common_deregister(logger_control[id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL);
+
+  /* delete stream from system outputs */
+  (void)logger_output_common_deregister(logger_control[logger_system_id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Search an output stream in id specific outputs.
+ *
+ * The given file stream is searched in of id specific outputs.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  File stream.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_output_is_registered(const logger_id_t id,
+                                             FILE              *stream)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* search stream in id specific outputs */
+  return(logger_output_common_is_registered(logger_control[id].outputs,
+                                            LOGGER_ELEMENTS(logger_control[id].outputs),
+                                            LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                            stream,
+                                            (logger_output_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for id specific output stream.
+ *
+ * Set the minimum logging level for given output stream. Only log messages
+ * equal or above the given level will be printed to the given stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Previous registered file stream.
+ * \param[in]     level   Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_level_set(const logger_id_t    id,
+                                           FILE                 *stream,
+                                           const logger_level_t level)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set stream output level to id specific outputs */
+  return(logger_output_common_level_set(logger_control[id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL,
+                                        LOGGER_ALL ^ (level - 1)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for id specific output stream.
+ *
+ * Query the currently set minimum level for the given logging output stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Previous registered file stream.
+ *
+ * \return        Currently set logging level.
+ ******************************************************************************/
+logger_level_t logger_id_output_level_get(const logger_id_t id,
+                                          FILE              *stream)
+{
+  logger_level_t level;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* get stream output level from id specific outputs */
+  level = logger_output_common_level_get(logger_control[id].outputs,
+                                         LOGGER_ELEMENTS(logger_control[id].outputs),
+                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                         stream,
+                                         (logger_output_function_t)NULL);
+
+  /* return only lowest set bit */
+  return(LOGGER_ALL ^ (level - 1));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level mask for id specific output stream.
+ *
+ * Set a logging level mask for given output stream. Only log messages
+ * with a level set in the given level mask will be printed to the given stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Previous registered file stream.
+ * \param[in]     level   Level mask to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_level_mask_set(const logger_id_t    id,
+                                                FILE                 *stream,
+                                                const logger_level_t level)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set stream output level to id specific outputs */
+  return(logger_output_common_level_set(logger_control[id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                        stream,
+                                        (logger_output_function_t)NULL,
+                                        level));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level mask for id specific output stream.
+ *
+ * Query the currently set level mask for the given logging output stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Previous registered file stream.
+ *
+ * \return        Currently set logging level mask.
+ ******************************************************************************/
+logger_level_t logger_id_output_level_mask_get(const logger_id_t id,
+                                               FILE              *stream)
+{
+  logger_level_t level;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* get stream output level from id specific outputs */
+  level = logger_output_common_level_get(logger_control[id].outputs,
+                                         LOGGER_ELEMENTS(logger_control[id].outputs),
+                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                         stream,
+                                         (logger_output_function_t)NULL);
+
+  return(level);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable the id specific output stream color setting.
+ *
+ * Enable the color setting for a given output stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_color_enable(const logger_id_t id,
+                                              FILE              *stream)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* enable stream output color in id specific outputs */
+  return(logger_output_common_color(logger_control[id].outputs,
+                                    LOGGER_ELEMENTS(logger_control[id].outputs),
+                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                    stream,
+                                    (logger_output_function_t)NULL,
+                                    logger_true));
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable the id specific output stream color setting.
+ *
+ * Disable the color setting for a given output stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_color_disable(const logger_id_t id,
+                                               FILE              *stream)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* disable stream output color in id specific outputs */
+  return(logger_output_common_color(logger_control[id].outputs,
+                                    LOGGER_ELEMENTS(logger_control[id].outputs),
+                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                    stream,
+                                    (logger_output_function_t)NULL,
+                                    logger_false));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the id specific output stream color setting.
+ *
+ * Query the color setting for a given output stream.
+ *
+ * \param[in]     id      Logger ID.
+ * \param[in]     stream  Opened file stream.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_output_color_is_enabled(const logger_id_t id,
+                                                FILE              *stream)
+{
+  /* check if color for this stream is enabled */
+  return(logger_output_common_color_is_enabled(logger_control[id].outputs,
+                                               LOGGER_ELEMENTS(logger_control[id].outputs),
+                                               LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                               stream,
+                                               (logger_output_function_t)NULL));
+}
+
+
+/***************************************************************************//**
+ * \brief  Register an id specific output stream.
+ *
+ * The user provided function must take a single string argument. The default
+ * logging level is set to \c LOGGER_UNKNOWN thus this function will not be
+ * called for any message.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_function_register(const logger_id_t        id,
+                                                   logger_output_function_t function)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* add function to system outputs */
+  (void)logger_output_common_register(logger_control[logger_system_id].outputs,
+                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
+                                      LOGGER_OUTPUT_TYPE_FUNCTION,
+                                      (FILE *)NULL,
+                                      function);
+  (void)logger_output_common_level_set(logger_control[logger_system_id].outputs,
+                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
+                                      LOGGER_OUTPUT_TYPE_FUNCTION,
+                                      (FILE *)NULL,
+                                      function,
+                                      LOGGER_ALL);
+
+  /* add function to global outputs */
+  ret = logger_output_common_register(logger_control[id].outputs,
+                                      LOGGER_ELEMENTS(logger_control[id].outputs),
+                                      LOGGER_OUTPUT_TYPE_FUNCTION,
+                                      (FILE *)NULL,
+                                      function);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Deregister an id specific output function.
+ *
+ * Remove given file function from list of outputs.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_function_deregister(const logger_id_t        id,
+                                                     logger_output_function_t function)
+{
+  logger_return_t ret = LOGGER_OK;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* delete function from global outputs */
+  ret = logger_output_common_deregister(logger_control[id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function);
+
+  /* delete function from system outputs */
+  (void)logger_output_common_deregister(logger_control[logger_system_id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function);
+
+  /* update unified output lists of each ID */
+  (void)logger_output_common_unify(id);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Search an output function in id specific outputs.
+ *
+ * The given output function is searched in of id specific outputs.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_id_output_function_is_registered(const logger_id_t        id,
+                                                      logger_output_function_t function)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* search function in global outputs */
+  return(logger_output_common_is_registered(logger_control[id].outputs,
+                                            LOGGER_ELEMENTS(logger_control[id].outputs),
+                                            LOGGER_OUTPUT_TYPE_FUNCTION,
+                                            (FILE *)NULL,
+                                            function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level for id specific output function.
+ *
+ * Set the minimum logging level for given output function. Only log messages
+ * equal or above the given level will be printed to the given function.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ * \param[in]     level     Level to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_function_level_set(const logger_id_t        id,
+                                                    logger_output_function_t function,
+                                                    const logger_level_t     level)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0 &&
+      (level & (level - 1)) == 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set function output level to id specific outputs */
+  return(logger_output_common_level_set(logger_control[id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function,
+                                        LOGGER_ALL ^ (level - 1)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level for id specific output function.
+ *
+ * Query the currently set minimum level for the given logging output function.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Currently set logging level.
+ ******************************************************************************/
+logger_level_t logger_id_output_function_level_get(const logger_id_t        id,
+                                                   logger_output_function_t function)
+{
+  logger_level_t level;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* get function output level from id specific outputs */
+  level = logger_output_common_level_get(logger_control[id].outputs,
+                                         LOGGER_ELEMENTS(logger_control[id].outputs),
+                                         LOGGER_OUTPUT_TYPE_FUNCTION,
+                                         (FILE *)NULL,
+                                         function);
+
+  /* return only lowest set bit */
+  return(LOGGER_ALL ^ (level - 1));
+}
+
+
+/***************************************************************************//**
+ * \brief  Set logging level mask for id specific output function.
+ *
+ * Set a logging level mask for given output function. Only for log messages
+ * with a level set in the given level mask the function will be called.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ * \param[in]     level     Level mask to set.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_function_level_mask_set(const logger_id_t        id,
+                                                         logger_output_function_t function,
+                                                         const logger_level_t     level)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* set function output level to id specific outputs */
+  return(logger_output_common_level_set(logger_control[id].outputs,
+                                        LOGGER_ELEMENTS(logger_control[id].outputs),
+                                        LOGGER_OUTPUT_TYPE_FUNCTION,
+                                        (FILE *)NULL,
+                                        function,
+                                        level));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query logging level mask for id specific output function.
+ *
+ * Query the currently set minimum level for the given logging output function.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        Currently set logging level mask.
+ ******************************************************************************/
+logger_level_t logger_id_output_function_level_mask_get(const logger_id_t        id,
+                                                   logger_output_function_t function)
 {
   logger_level_t level;
 
-  /* get stream output level to global outputs */
-  level = logger_output_common_level_get(logger_outputs,
-                                         LOGGER_ELEMENTS(logger_outputs),
-                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                         stream,
-                                         (logger_output_function_t)NULL);
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_UNKNOWN);
+  }
+
+  /* get function output level from id specific outputs */
+  level = logger_output_common_level_get(logger_control[id].outputs,
+                                         LOGGER_ELEMENTS(logger_control[id].outputs),
+                                         LOGGER_OUTPUT_TYPE_FUNCTION,
+                                         (FILE *)NULL,
+                                         function);
+
+  return(level);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable the id specific output function color setting.
+ *
+ * Enable the color setting for a given output function.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_function_color_enable(const logger_id_t        id,
+                                                       logger_output_function_t function)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* enable function output enable to id specific outputs */
+  return(logger_output_common_color(logger_control[id].outputs,
+                                    LOGGER_ELEMENTS(logger_control[id].outputs),
+                                    LOGGER_OUTPUT_TYPE_FUNCTION,
+                                    (FILE *)NULL,
+                                    function,
+                                    logger_true));
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable the id specific output function color setting.
+ *
+ * Disable the color setting for a given output function.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_output_function_color_disable(const logger_id_t        id,
+                                                        logger_output_function_t function)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* disable function output color in id specific outputs */
+  return(logger_output_common_color(logger_control[id].outputs,
+                                    LOGGER_ELEMENTS(logger_control[id].outputs),
+                                    LOGGER_OUTPUT_TYPE_FUNCTION,
+                                    (FILE *)NULL,
+                                    function,
+                                    logger_false));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the id specific output function color setting.
+ *
+ * Query the color setting for a given output function.
+ *
+ * \param[in]     id        Logger ID.
+ * \param[in]     function  User provided output function.
+ *
+ * \return        \c logger_true if logger is found, logger_false otherwise
+ ******************************************************************************/
+logger_bool_t logger_id_output_function_color_is_enabled(const logger_id_t        id,
+                                                         logger_output_function_t function)
+{
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(logger_false);
+  }
+
+  /* check if color for this function is enabled */
+  return(logger_output_common_color_is_enabled(logger_control[id].outputs,
+                                               LOGGER_ELEMENTS(logger_control[id].outputs),
+                                               LOGGER_OUTPUT_TYPE_FUNCTION,
+                                               (FILE *)NULL,
+                                               function));
+}
+
+
+/***************************************************************************//**
+ * \brief  Change terminal text color and attributes.
+ *
+ * Change text color and attributes for all messages of given ID when they are
+ * printed to \c stdout or \c stdin. Outputs to other streams including files
+ * will have no color unless explicit enabled. This function uses escape
+ * sequences of unix consoles. Attributes can be combined using `|`. To set any
+ * other markup strings use logger_id_color_string_set().
+ *
+ * \param[in]     id      ID for setting level.
+ * \param[in]     fg      Text foreground.
+ * \param[in]     bg      Text background.
+ * \param[in]     attr    Text attribute.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_color_console_set(const logger_id_t        id,
+                                            const logger_text_fg_t   fg,
+                                            const logger_text_bg_t   bg,
+                                            const logger_text_attr_t attr)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  logger_control[id].color = logger_true;
+  (void)logger_color_console_format(logger_control[id].color_string.begin, LOGGER_ELEMENTS(logger_control[id].color_string.begin), fg, bg, attr);
+  (void)logger_color_console_format(logger_control[id].color_string.end, LOGGER_ELEMENTS(logger_control[id].color_string.end), LOGGER_FG_UNCHANGED, LOGGER_BG_UNCHANGED, LOGGER_ATTR_RESET);
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  /* print the new color strings with the next message */
+  LOGGER_ATOMIC_STORE(&logger_control[id].color_string_changed, logger_true);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Change terminal text color and attributes.
+ *
+ * Change text color and attributes for all messages of given ID when they are
+ * printed to \c stdout or \c stdin. Outputs to other streams including files
+ * will have no color unless explicit enabled. To set colors for unix consoles
+ * use logger_color_prefix_set().
+ *
+ * \param[in]     id      ID for setting level.
+ * \param[in]     begin   Text color begin markup.
+ * \param[in]     end     Text color end markup.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_color_string_set(const logger_id_t id,
+                                           const char        *begin,
+                                           const char        *end)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for too long color strings */
+  if ((strlen(begin) >= LOGGER_ELEMENTS(logger_control[id].color_string.begin)) ||
+      (strlen(end)   >= LOGGER_ELEMENTS(logger_control[id].color_string.end))) {
+    return(LOGGER_ERR_STRING_TOO_LONG);
+  }
+
+  logger_control[id].color = logger_true;
+  (void)strncpy(logger_control[id].color_string.begin, begin, LOGGER_ELEMENTS(logger_control[id].color_string.begin));
+  (void)strncpy(logger_control[id].color_string.end, end, LOGGER_ELEMENTS(logger_control[id].color_string.end));
+  logger_control[id].color_string.begin[LOGGER_ELEMENTS(logger_control[id].color_string.begin) - 1] = '\0';
+  logger_control[id].color_string.end[LOGGER_ELEMENTS(logger_control[id].color_string.end) - 1]   = '\0';
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  /* print the new color strings with the next message */
+  LOGGER_ATOMIC_STORE(&logger_control[id].color_string_changed, logger_true);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Reset terminal text color and attributes.
+ *
+ * Reset text color and attributes of given ID back to defaults.
+ *
+ * \param[in]     id      ID for setting level.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_id_color_reset(const logger_id_t id)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  logger_control[id].color                 = logger_false;
+  logger_control[id].color_string.begin[0] = '\0';
+  logger_control[id].color_string.end[0]   = '\0';
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(id);
+
+  /* print the new color strings with the next message */
+  LOGGER_ATOMIC_STORE(&logger_control[id].color_string_changed, logger_true);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable logger prefix colors.
+ *
+ * Enable logger prefix color output.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_prefix_enable(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_color_prefix_enabled = logger_true;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable logger prefix colors.
+ *
+ * Disable logger prefix color output.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_prefix_disable(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_color_prefix_enabled = logger_false;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the current enable state of logger prefix colors.
+ *
+ * Query the current prefix color enable state of logger.
+ *
+ * \return        \c logger_true if logger prefix color is enabled, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_color_prefix_is_enabled(void)
+{
+  return(logger_color_prefix_enabled);
+}
+
+
+/***************************************************************************//**
+ * \brief  Change terminal text color and attributes for prefix.
+ *
+ * Change text color and attributes for message prefix with given level when
+ * they are printed to \c stdout or \c stdin. Outputs to other streams
+ * including files will have no color unless explicit enabled. This function
+ * uses escape sequences of unix consoles. Attributes can be combined using
+ * `|`. To set any other markup strings use logger_color_prefix_string_set().
+ *
+ * \param[in]     level   Level to set.
+ * \param[in]     fg      Text foreground.
+ * \param[in]     bg      Text background.
+ * \param[in]     attr    Text attribute.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_prefix_console_set(const logger_level_t     level,
+                                                const logger_text_fg_t   fg,
+                                                const logger_text_bg_t   bg,
+                                                const logger_text_attr_t attr)
+{
+  size_t   index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* get index for level */
+  index = logger_level_to_index(level);
+
+  (void)logger_color_console_format(logger_level_colors[index].begin, LOGGER_ELEMENTS(logger_level_colors[index].begin), fg, bg, attr);
+  (void)logger_color_console_format(logger_level_colors[index].end, LOGGER_ELEMENTS(logger_level_colors[index].end), LOGGER_FG_UNCHANGED, LOGGER_BG_UNCHANGED, LOGGER_ATTR_RESET);
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Change text color and attributes for prefix.
+ *
+ * Change text color and attributes for message prefix with given level when
+ * they are printed to \c stdout or \c stdin. Outputs to other streams
+ * including files will have no color unless explicit enabled. To set colors
+ * for unix consoles use logger_color_prefix_set().
+ *
+ * \param[in]     level   Level for setting color string.
+ * \param[in]     begin   Text color begin markup.
+ * \param[in]     end     Text color end markup.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_prefix_string_set(const logger_level_t level,
+                                               const char           *begin,
+                                               const char           *end)
+{
+  size_t   index;
+
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* GUARD: check for too long color strings */
+  if ((strlen(begin) >= LOGGER_ELEMENTS(logger_level_colors[index].begin)) ||
+      (strlen(end)   >= LOGGER_ELEMENTS(logger_level_colors[index].end))) {
+    return(LOGGER_ERR_STRING_TOO_LONG);
+  }
+
+  /* get index for level */
+  index = logger_level_to_index(level);
+
+  (void)strncpy(logger_level_colors[index].begin, begin, LOGGER_ELEMENTS(logger_level_colors[index].begin));
+  (void)strncpy(logger_level_colors[index].end, end, LOGGER_ELEMENTS(logger_level_colors[index].end));
+  logger_level_colors[index].begin[LOGGER_ELEMENTS(logger_level_colors[index].begin) - 1] = '\0';
+  logger_level_colors[index].end[LOGGER_ELEMENTS(logger_level_colors[index].end) - 1]   = '\0';
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Change terminal text color and attributes for prefix.
+ *
+ * Reset text color and attributes for message prefix to console default escape
+ * sequences.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_prefix_reset(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  memcpy(logger_level_colors, logger_level_colors_console, sizeof(logger_level_colors));
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable logger message colors.
+ *
+ * Enable logger message color output.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_message_enable(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_color_message_enabled = logger_true;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Disable logger message colors.
+ *
+ * Disable logger message color output.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_color_message_disable(void)
+{
+  /* GUARD: outputs and drivers must not change the configuration */
+  if (logger_print_active() == logger_true) {
+    return(LOGGER_ERR_REENTRANT);
+  }
+
+  logger_color_message_enabled = logger_false;
+
+  /* publish the configuration of each ID */
+  (void)logger_output_common_unify(logger_id_unknown);
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query the current enable state of logger message colors.
+ *
+ * Query the current color message enable state of logger.
+ *
+ * \return        \c logger_true if logger color is enabled, logger_false otherwise.
+ ******************************************************************************/
+logger_bool_t logger_color_message_is_enabled(void)
+{
+  return(logger_color_message_enabled);
+}
+
+
+/***************************************************************************//**
+ * \brief  Query name for level.
+ *
+ * Query the name for the given logging level.
+ *
+ * \param[in]     level   Level for querying name
+ *
+ * \return        Symbolic name of the level.
+ ******************************************************************************/
+const char *logger_level_name_get(const logger_level_t level)
+{
+  size_t   index;
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(logger_level_names[logger_level_to_index(LOGGER_UNKNOWN)]);
+  }
+
+  /* get index for level */
+  index = logger_level_to_index(level);
+
+  /* get level name */
+  return(logger_level_names[index]);
+}
+
+
+/***************************************************************************//**
+ * \brief  strip path from file name.
+ *
+ * Strip path from a fully qualified file name. Returns pointer to string part
+ * after last separator.
+ *
+ * \param[in]     file    File name containing path
+ *
+ * \return        Pointer to file name.
+ ******************************************************************************/
+LOGGER_INLINE const char *logger_strip_path(const char *file)
+{
+  const char *basename;
+
+  /* find last separator */
+  basename = strrchr(file, '/');
+  if (basename != NULL) {
+    /* eat last separator */
+    basename++;
+  }
+  else {
+    /* unable to find separator, use whole file name */
+    basename = file;
+  }
+
+  return(basename);
+}
+
+
+/***************************************************************************//**
+ * \brief  Format date string
+ *
+ * Print date string into provided memory. The date is only formatted again if
+ * the time changed since the last call of the thread.
+ *
+ * \param[out]    date       Formatted date string.
+ * \param[in]     date_size  String length of formatted date string.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_format_date(char   *date,
+                                                 size_t date_size)
+{
+  time_t                            current_time;
+  static LOGGER_THREAD_LOCAL time_t previous_time = 0;
+
+  /* get current time */
+  current_time = time(NULL);
+
+  /* do the expensive stuff only if needed */
+  if (current_time != previous_time) {
+    size_t    index;
+    struct tm local;
+    struct tm *tmp;
+
+    /* update previous time */
+    previous_time = current_time;
+
+    /* convert to local time, threads format dates at the same time */
+    tmp = localtime_r(&current_time, &local);
+
+    /* if localtime returned a valid time */
+    if (tmp != NULL) {
+      if (strftime(date, date_size, LOGGER_FORMAT_STRFTIME, tmp) == 0) {
+        for (index = 0 ; index < 8 && index < date_size - 2 ; index++) {
+          date[index] = '#';
+        }
+        date[index] = '\0';
+      }
+    }
+    else {
+      for (index = 0 ; index < 8 && index < date_size - 2 ; index++) {
+        date[index] = '#';
+      }
+      date[index] = '\0';
+    }
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Format message prefix
+ *
+ * Print the prefix into provided memory.
+ *
+ * \param[in]     id           ID outputting this message.
+ * \param[in]     plan         Output plan of the ID.
+ * \param[out]    prefix       Formatted message prefix.
+ * \param[in]     prefix_size  String length of formatted message prefix.
+ * \param[in]     level        Level of this message.
+ * \param[in]     file         Name of file where this call happened.
+ * \param[in]     function     Name of function where this call happened.
+ * \param[in]     line         Line where this call happened.
+ * \param[in]     append       Message continues the previous message, it
+ *                             gets no prefix.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_format_prefix(logger_id_t         id,
+                                                   const logger_plan_t *plan,
+                                                   char                *prefix,
+                                                   uint16_t            prefix_size,
+                                                   logger_level_t      level,
+                                                   const char          *file,
+                                                   const char          *function,
+                                                   uint32_t            line,
+                                                   logger_bool_t       append)
+{
+  /* do prefix stuff only if needed */
+  if ((append == logger_false) &&
+      (plan->prefix != LOGGER_PFX_EMPTY)) {
+    logger_prefix_t local_prefix;
+    char * write_ptr = prefix;
+    char * end_ptr   = prefix + prefix_size;
+
+    if (plan->prefix & LOGGER_PFX_UNSET) {
+      local_prefix = plan->prefix_standard;
+    }
+    else {
+      local_prefix = plan->prefix;
+    }
+
+    /* prefix date */
+    if ((write_ptr < end_ptr) &&
+        ((local_prefix & LOGGER_PFX_DATE) != 0)) {
+      write_ptr += logger_prefix_concatenate(write_ptr,
+                                             end_ptr,
+                                             logger_date,
+                                             LOGGER_FORMAT_STRING_DATE_WIDTH);
+    }
+
+    /* prefix id name */
+    if ((write_ptr < end_ptr) &&
+        ((local_prefix & LOGGER_PFX_NAME) != 0)) {
+      write_ptr += logger_prefix_concatenate(write_ptr,
+                                             end_ptr,
+                                             logger_id_name_get(id),
+                                             LOGGER_FORMAT_STRING_NAME_WIDTH);
+    }
+
+    /* prefix level */
+    if ((write_ptr < end_ptr) &&
+        ((local_prefix & LOGGER_PFX_LEVEL) != 0)) {
+      write_ptr += logger_prefix_concatenate(write_ptr,
+                                             end_ptr,
+                                             logger_level_name_get(level),
+                                             LOGGER_FORMAT_STRING_LEVEL_WIDTH);
+    }
+
+    /* prefix file name */
+    if ((write_ptr < end_ptr) &&
+        ((local_prefix & LOGGER_PFX_FILE) != 0)) {
+      write_ptr += logger_prefix_concatenate(write_ptr,
+                                             end_ptr,
+                                             logger_strip_path(file),
+                                             LOGGER_FORMAT_STRING_FILE_WIDTH);
+    }
+
+    /* prefix function name */
+    if ((write_ptr < end_ptr) &&
+        ((local_prefix & LOGGER_PFX_FUNCTION) != 0)) {
+      write_ptr += logger_prefix_concatenate(write_ptr,
+                                             end_ptr,
+                                             function,
+                                             LOGGER_FORMAT_STRING_FUNCTION_WIDTH);
+    }
+
+    /* prefix line number */
+    if ((write_ptr < end_ptr) &&
+        ((local_prefix & LOGGER_PFX_LINE) != 0)) {
+      char linenumber[10];
+      char *ptr = &linenumber[LOGGER_ELEMENTS(linenumber) - 1];
+
+      /* convert line number to string, starting with the lowest digit at the end of the string */
+      *ptr = '\0';
+      while (line > 0) {
+        int idx;
+
+        idx  = line % 10;
+        line = line / 10;
+        *(--ptr) = logger_int_to_char[idx];
+      }
+
+      write_ptr += logger_prefix_concatenate(write_ptr,
+                                             end_ptr,
+                                             ptr,
+                                             LOGGER_FORMAT_STRING_LINE_WIDTH);
+    }
+
+    /* append ' ' to prefix string */
+    if (write_ptr < end_ptr) {
+      *(write_ptr++) = ' ';
+    }
+    if (write_ptr < end_ptr) {
+      *(write_ptr++) = '\0';
+    }
+
+    /* terminate prefix string if it is too small */
+    if (write_ptr == end_ptr &&
+        *(write_ptr - 1) != '\0') {
+      *(--write_ptr) = '\0';
+      *(--write_ptr) = ' ';
+      *(--write_ptr) = '.';
+      *(--write_ptr) = '.';
+      *(--write_ptr) = '.';
+    }
+  }
+  else {
+    /* clear prefix */
+    prefix[0] = '\0';
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  String copy
+ *
+ * Copies string from `src` to `dest` until end on `src` is reached or `n`
+ * characters are copied. The string in `dest` is '\0' terminated if length of
+ * string in `src` is less than `n`. Otherwise the string will *not* be
+ * terminated. The function returns the number of characters copied to `dest`
+ * not including the '\0'.
+ *
+ * \param[out]    dest  Destination string.
+ * \param[in]     src   Source string. Needs to be '\0' terminated.
+ * \param[in]     n     Maximum amount of characters available in destination
+ *                      string.
+ *
+ * \return     Number of characters written to destination string.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_string_copy(char       *dest,
+                                        const char *src,
+                                        size_t     n)
+{
+  size_t index;
+
+  for (index = 0 ; index < n && src[index] != '\0' ; index++) {
+    dest[index] = src[index];
+  }
+
+  if (index < n) {
+    dest[index] = '\0';
+  }
+
+  return(index);
+}
+
+
+/***************************************************************************//**
+ * \brief  String copy
+ *
+ * Copies string from `src` to `dest` until end on `src` is reached. Fill the
+ * given width of string with spaces and append the prefix field separator. The
+ * function returns the number of characters copied to `dest.
+ *
+ * This function is used to generate aligned prefixes of logger messages.
+ *
+ * @attention The returned string is not terminated with a '\0' character! This
+ *            needs to be done externally
+ *
+ * \param[out]    dest       Destination string.
+ * \param[in]     dest_end   Pointer to character after the absolute end of
+ *                           destination string. Has nothing to do with width.
+ * \param[in]     src        Source string. Needs to be '\0' terminated.
+ * \param[in]     width      Width of field in destination string.
+ *
+ * \return     Number of characters written to destination string.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_prefix_concatenate(char       *dest,
+                                               const char *dest_end,
+                                               const char *src,
+                                               size_t     width)
+{
+  size_t characters = 0;
+
+  /* copy src to dest */
+  while (dest != dest_end &&
+         src != NULL &&
+         *src != '\0') {
+    *(dest++) = *(src++);
+    characters++;
+  }
+
+  /* fill string with spaces */
+  while (dest != dest_end &&
+         characters < width) {
+    *(dest++) = ' ';
+    characters++;
+  }
+
+  /* append separator */
+  if (dest != dest_end) {
+    *(dest++) = LOGGER_FORMAT_STRING_SEPARATOR;
+    characters++;
+  }
+
+  return characters;
+}
+
+
+/***************************************************************************//**
+ * \brief  Append characters to a structured message.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     src        Characters to append.
+ * \param[in]     length     Number of characters to append.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_kv_put(char       *write_ptr,
+                                  const char *end_ptr,
+                                  const char *src,
+                                  size_t     length)
+{
+  length = LOGGER_NUMERIC_MIN(length, (size_t)(end_ptr - write_ptr));
+  (void)memcpy(write_ptr, src, length);
+
+  return(write_ptr + length);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append unsigned integer to a structured message.
+ *
+ * Two digits are converted per step, starting with the lowest digits at the
+ * end of a temporary string.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     value      Value to append.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_kv_put_u64(char       *write_ptr,
+                                      const char *end_ptr,
+                                      uint64_t   value)
+{
+  char number[20];
+  char *ptr = &number[LOGGER_ELEMENTS(number)];
+
+  while (value >= 100) {
+    size_t idx;
+
+    idx   = (size_t)(value % 100) * 2;
+    value = value / 100;
+    *(--ptr) = logger_int_to_chars[idx + 1];
+    *(--ptr) = logger_int_to_chars[idx];
+  }
+
+  if (value >= 10) {
+    *(--ptr) = logger_int_to_chars[value * 2 + 1];
+    *(--ptr) = logger_int_to_chars[value * 2];
+  }
+  else {
+    *(--ptr) = logger_int_to_char[value];
+  }
+
+  return(logger_kv_put(write_ptr, end_ptr, ptr, (size_t)(&number[LOGGER_ELEMENTS(number)] - ptr)));
+}
+
+
+/***************************************************************************//**
+ * \brief  Append signed integer to a structured message.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     value      Value to append.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_kv_put_i64(char       *write_ptr,
+                                      const char *end_ptr,
+                                      int64_t    value)
+{
+  if (value < 0) {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "-", 1);
+    return(logger_kv_put_u64(write_ptr, end_ptr, (uint64_t)0 - (uint64_t)value));
+  }
+
+  return(logger_kv_put_u64(write_ptr, end_ptr, (uint64_t)value));
+}
+
+
+/***************************************************************************//**
+ * \brief  Append floating point number to a structured message.
+ *
+ * Numbers are printed with up to six decimal places without trailing zeros.
+ * Only very large and very small numbers use the slower \c snprintf(). Not a
+ * number and infinity are \c null in JSON.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     value      Value to append.
+ * \param[in]     format     Rendering of structured message.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_kv_put_f64(char               *write_ptr,
+                                      const char         *end_ptr,
+                                      double             value,
+                                      logger_kv_format_t format)
+{
+  uint64_t integral;
+  uint64_t fraction;
+  char     number[32];
+  int      characters;
+  int      digits;
+
+  /* not a number and infinity */
+  if ((value != value) ||
+      (value > 1.7976931348623157e308) ||
+      (value < -1.7976931348623157e308)) {
+    if (format == LOGGER_KV_FORMAT_JSON) {
+      return(logger_kv_put(write_ptr, end_ptr, "null", 4));
+    }
+    else if (value != value) {
+      return(logger_kv_put(write_ptr, end_ptr, "nan", 3));
+    }
+    else if (value > 0) {
+      return(logger_kv_put(write_ptr, end_ptr, "inf", 3));
+    }
+    else {
+      return(logger_kv_put(write_ptr, end_ptr, "-inf", 4));
+    }
+  }
+
+  if (value < 0) {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "-", 1);
+    value     = -value;
+  }
+
+  /* numbers not fitting fixed point */
+  if ((value >= 1e15) ||
+      ((value != 0.0) && (value < 1e-6))) {
+    characters = snprintf(number, sizeof(number), "%.17g", value);
+    return(logger_kv_put(write_ptr, end_ptr, number, (size_t)LOGGER_NUMERIC_LIMIT(characters, 0, (int)sizeof(number) - 1)));
+  }
+
+  /* round to six decimal places */
+  integral = (uint64_t)value;
+  fraction = (uint64_t)((value - (double)integral) * 1e6 + 0.5);
+  if (fraction >= 1000000) {
+    integral++;
+    fraction -= 1000000;
+  }
+
+  write_ptr = logger_kv_put_u64(write_ptr, end_ptr, integral);
+
+  if (fraction > 0) {
+    /* strip trailing zeros */
+    digits = 6;
+    while ((fraction % 10) == 0) {
+      fraction = fraction / 10;
+      digits--;
+    }
+
+    number[0] = '.';
+    for (characters = digits ; characters > 0 ; characters--) {
+      number[characters] = logger_int_to_char[fraction % 10];
+      fraction = fraction / 10;
+    }
+
+    write_ptr = logger_kv_put(write_ptr, end_ptr, number, (size_t)digits + 1);
+  }
+
+  return(write_ptr);
+}
+
+
+/***************************************************************************//**
+ * \brief  Find the next character of a string needing an escape.
+ *
+ * Control characters including the terminating '\0' always need an escape,
+ * '"' and '\\' only in quoted strings. With SSE2 16 characters are checked at
+ * once. The aligned loads may read beyond the end of the string but never
+ * beyond the page containing it.
+ *
+ * \param[in]     string  String to scan.
+ * \param[in]     quote   String is quoted.
+ *
+ * \return     Pointer to the first character needing an escape.
+ ******************************************************************************/
+LOGGER_INLINE LOGGER_NO_SANITIZE_ADDRESS const char *logger_escape_scan(const char    *string,
+                                                                        logger_bool_t quote)
+{
+#ifdef LOGGER_HAVE_SSE2
+  __m128i control   = _mm_set1_epi8(0x1F);
+  __m128i quotes    = _mm_set1_epi8('"');
+  __m128i backslash = _mm_set1_epi8('\\');
+  __m128i chunk;
+  __m128i found;
+  int     mask;
+
+  /* check single characters up to the first aligned block */
+  while (((uintptr_t)string & 15) != 0) {
+    if (((unsigned char)*string < ' ') ||
+        ((quote == logger_true) && ((*string == '"') || (*string == '\\')))) {
+      return(string);
+    }
+    string++;
+  }
+
+  for ( ; ; string += 16) {
+    chunk = _mm_load_si128((const __m128i *)string);
+
+    /* unsigned compare: max(chunk, 0x1F) equals 0x1F for control characters */
+    found = _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control);
+    if (quote == logger_true) {
+      found = _mm_or_si128(found, _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes),
+                                               _mm_cmpeq_epi8(chunk, backslash)));
+    }
+
+    mask = _mm_movemask_epi8(found);
+    if (mask != 0) {
+      return(string + __builtin_ctz((unsigned int)mask));
+    }
+  }
+#else
+  while (((unsigned char)*string >= ' ') &&
+         ((quote == logger_false) || ((*string != '"') && (*string != '\\')))) {
+    string++;
+  }
+
+  return(string);
+#endif /* LOGGER_HAVE_SSE2 */
+}
+
+
+/***************************************************************************//**
+ * \brief  Check if a string of a structured message needs quotes.
+ *
+ * \param[in]     string  String to check.
+ *
+ * \return     \c logger_true if string is empty or contains spaces, '=', '"'
+ *             or control characters, \c logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_kv_needs_quotes(const char *string)
+{
+  if (*string == '\0') {
+    return(logger_true);
+  }
+
+  for ( ; *string != '\0' ; string++) {
+    if (((unsigned char)*string <= ' ') ||
+        (*string == '=') ||
+        (*string == '"') ||
+        (*string == '\x7F')) {
+      return(logger_true);
+    }
+  }
+
+  return(logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append escaped characters of a string.
+ *
+ * Control characters are always escaped. Quoted strings escape '"' and '\\'
+ * too, which makes them valid JSON and logfmt strings. Escape sequences are
+ * never cut, the string pointer is advanced to the first character not
+ * appended.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in,out] string     String to append.
+ * \param[in]     quote      String is quoted.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_escape_put(char          *write_ptr,
+                                      const char    *end_ptr,
+                                      const char    **string,
+                                      logger_bool_t quote)
+{
+  static const char hex[] = "0123456789abcdef";
+  const char        *src = *string;
+  const char        *plain;
+  char              escape[6];
+  size_t            length;
+
+  while ((write_ptr < end_ptr) &&
+         (*src != '\0')) {
+    /* copy characters not needing escapes at once */
+    plain  = src;
+    src    = logger_escape_scan(src, quote);
+    length = LOGGER_NUMERIC_MIN((size_t)(src - plain), (size_t)(end_ptr - write_ptr));
+    (void)memcpy(write_ptr, plain, length);
+    write_ptr += length;
+    src        = plain + length;
+
+    if ((*src != '\0') &&
+        (write_ptr < end_ptr)) {
+      escape[0] = '\\';
+      length    = 2;
+
+      switch (*src) {
+        case '\n':
+          escape[1] = 'n';
+          break;
+
+        case '\r':
+          escape[1] = 'r';
+          break;
+
+        case '\t':
+          escape[1] = 't';
+          break;
+
+        case '"':
+        case '\\':
+          escape[1] = *src;
+          break;
+
+        default:
+          escape[1] = 'u';
+          escape[2] = '0';
+          escape[3] = '0';
+          escape[4] = hex[((unsigned char)*src >> 4) & 0x0F];
+          escape[5] = hex[(unsigned char)*src & 0x0F];
+          length    = 6;
+          break;
+      }
+
+      /* GUARD: don't cut escape sequences */
+      if ((size_t)(end_ptr - write_ptr) < length) {
+        break;
+      }
+
+      (void)memcpy(write_ptr, escape, length);
+      write_ptr += length;
+      src++;
+    }
+  }
+
+  *string = src;
+
+  return(write_ptr);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append string to a structured message.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     string     String to append.
+ * \param[in]     quote      Put string into quotes.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_kv_put_string(char          *write_ptr,
+                                         const char    *end_ptr,
+                                         const char    *string,
+                                         logger_bool_t quote)
+{
+  if (quote == logger_true) {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "\"", 1);
+  }
+
+  write_ptr = logger_escape_put(write_ptr, end_ptr, &string, quote);
+
+  /* strings cut short fill the destination */
+  if (*string != '\0') {
+    return((char *)end_ptr);
+  }
+
+  if (quote == logger_true) {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "\"", 1);
+  }
+
+  return(write_ptr);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append value of a field to a structured message.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     field      Field to append.
+ * \param[in]     format     Rendering of structured message.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_kv_put_value(char               *write_ptr,
+                                        const char         *end_ptr,
+                                        const logger_kv_t  *field,
+                                        logger_kv_format_t format)
+{
+  switch (field->type) {
+    case LOGGER_KV_TYPE_U64:
+      write_ptr = logger_kv_put_u64(write_ptr, end_ptr, field->value.u64);
+      break;
+
+    case LOGGER_KV_TYPE_I64:
+      write_ptr = logger_kv_put_i64(write_ptr, end_ptr, field->value.i64);
+      break;
+
+    case LOGGER_KV_TYPE_F64:
+      write_ptr = logger_kv_put_f64(write_ptr, end_ptr, field->value.f64, format);
+      break;
+
+    case LOGGER_KV_TYPE_BOOL:
+      if (field->value.b == logger_false) {
+        write_ptr = logger_kv_put(write_ptr, end_ptr, "false", 5);
+      }
+      else {
+        write_ptr = logger_kv_put(write_ptr, end_ptr, "true", 4);
+      }
+      break;
+
+    case LOGGER_KV_TYPE_STR:
+      if (field->value.str == NULL) {
+        write_ptr = logger_kv_put(write_ptr, end_ptr, "null", 4);
+      }
+      else if (format == LOGGER_KV_FORMAT_JSON) {
+        write_ptr = logger_kv_put_string(write_ptr, end_ptr, field->value.str, logger_true);
+      }
+      else {
+        write_ptr = logger_kv_put_string(write_ptr, end_ptr, field->value.str, logger_kv_needs_quotes(field->value.str));
+      }
+      break;
+  }
+
+  return(write_ptr);
+}
+
+
+/***************************************************************************//**
+ * \brief  Render structured message as JSON object.
+ *
+ * Like a JSON line, fields which don't fit are left out and strings which
+ * don't fit are shortened, so the message is always a valid JSON object.
+ *
+ * \param[out]    message       Rendered message.
+ * \param[in]     message_size  Size of rendered message.
+ * \param[in]     kv            Structured message.
+ ******************************************************************************/
+LOGGER_INLINE void logger_kv_render_json(char                   *message,
+                                         size_t                 message_size,
+                                         const logger_kv_list_t *kv)
+{
+  char       *write_ptr = message;
+  const char *end_ptr   = message + message_size - 2;
+
+  /* GUARD: message too short for a member */
+  if (message_size < 2 * LOGGER_JSON_MEMBER_MIN) {
+    message[0] = '\0';
+    return;
+  }
+
+  write_ptr = logger_kv_put(write_ptr, end_ptr, "{\"msg\":", 7);
+  write_ptr = logger_json_put_string(write_ptr, end_ptr, kv->message);
+
+  write_ptr = logger_json_put_members(write_ptr, end_ptr, kv);
+
+  /* room for the end is always left */
+  *(write_ptr++) = '}';
+  *write_ptr     = '\0';
+}
+
+
+/***************************************************************************//**
+ * \brief  Render structured message.
+ *
+ * Render message and fields without parsing a format string. The rendered
+ * message is always '\0' terminated, text and logfmt end with "..." if they
+ * are too long, see \c logger_kv_render_json() for JSON.
+ *
+ * \param[out]    message       Rendered message.
+ * \param[in]     message_size  Size of rendered message.
+ * \param[in]     kv            Structured message.
+ * \param[in]     format        Rendering of structured message.
+ ******************************************************************************/
+LOGGER_INLINE void logger_kv_render(char                   *message,
+                                    size_t                 message_size,
+                                    const logger_kv_list_t *kv,
+                                    logger_kv_format_t     format)
+{
+  char       *write_ptr = message;
+  const char *end_ptr   = message + message_size;
+  size_t     index;
+
+  /* GUARD: JSON is shortened differently */
+  if (format == LOGGER_KV_FORMAT_JSON) {
+    logger_kv_render_json(message, message_size, kv);
+    return;
+  }
+
+  if (format == LOGGER_KV_FORMAT_LOGFMT) {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "msg=", 4);
+    write_ptr = logger_kv_put_string(write_ptr, end_ptr, kv->message, logger_kv_needs_quotes(kv->message));
+  }
+  else {
+    write_ptr = logger_kv_put_string(write_ptr, end_ptr, kv->message, logger_false);
+  }
+
+  for (index = 0 ; index < kv->count ; index++) {
+    const logger_kv_t *field = &kv->fields[index];
+
+    write_ptr = logger_kv_put(write_ptr, end_ptr, " ", 1);
+    write_ptr = logger_kv_put_string(write_ptr, end_ptr, field->key, logger_false);
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "=", 1);
+    write_ptr = logger_kv_put_value(write_ptr, end_ptr, field, format);
+  }
+
+  /* terminate message, mark it if it is too long */
+  if (write_ptr < end_ptr) {
+    *write_ptr = '\0';
+  }
+  else {
+    (void)memcpy(message + message_size - 4, "...", 4);
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Get structured message rendered in the given format.
+ *
+ * Every format is rendered only once per message, however many outputs use
+ * it.
+ *
+ * \param[in,out] kv            Structured message.
+ * \param[in]     format        Rendering of structured message.
+ *
+ * \return     Rendered message.
+ ******************************************************************************/
+LOGGER_INLINE const char *logger_kv_rendered(logger_kv_list_t   *kv,
+                                             logger_kv_format_t format)
+{
+  if (kv->rendered[format] == logger_false) {
+    logger_kv_render(kv->strings[format], sizeof(kv->strings[format]), kv, format);
+    kv->rendered[format] = logger_true;
+  }
+
+  return(kv->strings[format]);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append string to a JSON line.
+ *
+ * The string is always closed, if it doesn't fit it ends with "...". There
+ * must be room for at least 5 characters.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string.
+ * \param[in]     string     String to append.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_json_put_string(char       *write_ptr,
+                                           const char *end_ptr,
+                                           const char *string)
+{
+  *(write_ptr++) = '"';
+
+  write_ptr = logger_escape_put(write_ptr, end_ptr - 4, &string, logger_true);
+
+  if (*string != '\0') {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, "...", 3);
+  }
+
+  *(write_ptr++) = '"';
+
+  return(write_ptr);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append fields of a structured message as JSON members.
+ *
+ * Fields which don't fit are left out, strings which don't fit are shortened.
+ *
+ * \param[out]    write_ptr  Position in destination string.
+ * \param[in]     end_ptr    Pointer to character after the end of destination
+ *                           string, room for closing the object is left behind.
+ * \param[in]     kv         Structured message.
+ *
+ * \return     Position after the appended characters.
+ ******************************************************************************/
+LOGGER_INLINE char *logger_json_put_members(char                   *write_ptr,
+                                            const char             *end_ptr,
+                                            const logger_kv_list_t *kv)
+{
+  size_t index;
+
+  for (index = 0 ; index < kv->count ; index++) {
+    /* GUARD: check for room of key and number */
+    if (end_ptr - write_ptr < LOGGER_JSON_MEMBER_MIN) {
+      break;
+    }
+
+    /* key leaves room for the longest number */
+    write_ptr = logger_kv_put(write_ptr, end_ptr, ",", 1);
+    write_ptr = logger_json_put_string(write_ptr, end_ptr - 30, kv->fields[index].key);
+    write_ptr = logger_kv_put(write_ptr, end_ptr, ":", 1);
+
+    if ((kv->fields[index].type == LOGGER_KV_TYPE_STR) &&
+        (kv->fields[index].value.str != NULL)) {
+      write_ptr = logger_json_put_string(write_ptr, end_ptr, kv->fields[index].value.str);
+    }
+    else {
+      write_ptr = logger_kv_put_value(write_ptr, end_ptr, &kv->fields[index], LOGGER_KV_FORMAT_JSON);
+    }
+  }
+
+  return(write_ptr);
+}
+
+
+/***************************************************************************//**
+ * \brief  Format JSON line.
+ *
+ * Print a message as a single JSON object followed by '\n'. Members which
+ * don't fit are left out, strings which don't fit are shortened, the line is
+ * always valid JSON.
+ *
+ * \param[out]    line       Formatted line.
+ * \param[in]     line_size  Size of formatted line.
+ * \param[in]     id         ID outputting this message.
+ * \param[in]     level      Level of this message.
+ * \param[in]     origin     Origin of message, NULL for messages of the logger
+ *                           itself.
+ * \param[in]     message    Formatted message.
+ * \param[in]     kv         Structured message, NULL for other messages.
+ *
+ * \return     Length of formatted line.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_json_format(char                  *line,
+                                        size_t                line_size,
+                                        logger_id_t           id,
+                                        logger_level_t        level,
+                                        const logger_origin_t *origin,
+                                        const char            *message,
+                                        const logger_kv_list_t *kv)
+{
+  char       *write_ptr = line;
+  const char *end_ptr   = line + line_size - 3;
+
+  /* GUARD: lines too short for the fixed members */
+  if (line_size < 4 * LOGGER_JSON_MEMBER_MIN) {
+    line[0] = '\0';
+    return(0);
+  }
+
+  write_ptr = logger_kv_put(write_ptr, end_ptr, "{\"time\":", 8);
+  write_ptr = logger_json_put_string(write_ptr, end_ptr - 3 * LOGGER_JSON_MEMBER_MIN, (origin != NULL) ? origin->date : logger_date);
+
+  write_ptr = logger_kv_put(write_ptr, end_ptr, ",\"id\":", 6);
+  write_ptr = logger_json_put_string(write_ptr, end_ptr - 2 * LOGGER_JSON_MEMBER_MIN, logger_id_name_get(id));
+
+  write_ptr = logger_kv_put(write_ptr, end_ptr, ",\"level\":", 9);
+  write_ptr = logger_json_put_string(write_ptr, end_ptr - LOGGER_JSON_MEMBER_MIN, logger_level_name_get(level));
+
+  if ((origin != NULL) &&
+      (origin->file != NULL) &&
+      (end_ptr - write_ptr >= 3 * LOGGER_JSON_MEMBER_MIN)) {
+    write_ptr = logger_kv_put(write_ptr, end_ptr, ",\"file\":", 8);
+    write_ptr = logger_json_put_string(write_ptr, end_ptr - 2 * LOGGER_JSON_MEMBER_MIN, logger_strip_path(origin->file));
+
+    write_ptr = logger_kv_put(write_ptr, end_ptr, ",\"function\":", 12);
+    write_ptr = logger_json_put_string(write_ptr, end_ptr - LOGGER_JSON_MEMBER_MIN, origin->function);
+
+    write_ptr = logger_kv_put(write_ptr, end_ptr, ",\"line\":", 8);
+    write_ptr = logger_kv_put_u64(write_ptr, end_ptr, origin->line);
+  }
+
+  write_ptr = logger_kv_put(write_ptr, end_ptr, ",\"message\":", 11);
+  write_ptr = logger_json_put_string(write_ptr, end_ptr, (kv != NULL) ? kv->message : message);
+
+  /* fields of structured messages become members */
+  if (kv != NULL) {
+    write_ptr = logger_json_put_members(write_ptr, end_ptr, kv);
+  }
+
+  /* room for the end is always left */
+  *(write_ptr++) = '}';
+  *(write_ptr++) = '\n';
+  *write_ptr     = '\0';
+
+  return((size_t)(write_ptr - line));
+}
+
+
+/***************************************************************************//**
+ * \brief  Find managed file for a stream.
+ *
+ * \param[in]     stream  File stream to search for.
+ *
+ * \return        Managed file, \c NULL if stream is not managed.
+ ******************************************************************************/
+LOGGER_INLINE logger_file_t *logger_file_find(FILE *stream)
+{
+  size_t index;
+
+  /* GUARD: NULL is never a managed stream */
+  if (stream == NULL) {
+    return((logger_file_t *)NULL);
+  }
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_files) ; index++) {
+    if (logger_files[index].used == logger_true &&
+        logger_files[index].stream == stream) {
+      return(&logger_files[index]);
+    }
+  }
+
+  return((logger_file_t *)NULL);
+}
+
+
+/***************************************************************************//**
+ * \brief  Get the generation of a rotated file name.
+ *
+ * \param[in]     name    Directory entry name.
+ * \param[in]     base    Base name of the managed file.
+ *
+ * \return        Generation of `base.N` or `base.N.lz`, 0 if name doesn't match.
+ ******************************************************************************/
+LOGGER_INLINE uint32_t logger_file_generation(const char *name,
+                                              const char *base)
+{
+  size_t   length = strlen(base);
+  uint32_t generation = 0;
+
+  /* GUARD: name must start with "base." */
+  if (strncmp(name, base, length) != 0 || name[length] != '.') {
+    return(0);
+  }
+
+  for (name += length + 1 ; *name >= '0' && *name <= '9' ; name++) {
+    generation = generation * 10 + (uint32_t)(*name - '0');
+  }
+
+  /* GUARD: only digits and an optional compression suffix are allowed after the dot */
+  if (*name != '\0' && strcmp(name, LOGGER_COMPRESS_SUFFIX) != 0) {
+    return(0);
+  }
+
+  return(generation);
+}
+
+
+/***************************************************************************//**
+ * \brief  Scan for already rotated files.
+ *
+ * Continue numbering after the newest rotated file found next to the managed
+ * file and remove rotated files exceeding the keep limit.
+ *
+ * \param[in,out] file    Managed file.
+ ******************************************************************************/
+LOGGER_INLINE void logger_file_scan(logger_file_t *file)
+{
+  char          directory[LOGGER_PATH_MAX];
+  char          rotated[LOGGER_PATH_MAX + LOGGER_FILE_SUFFIX_MAX];
+  const char    *base = strrchr(file->path, '/');
+  DIR           *dir;
+  struct dirent *entry;
+  uint32_t      newest = 0;
+  uint32_t      generation;
+
+  if (base == NULL) {
+    (void)logger_string_copy(directory, ".", sizeof(directory));
+    base = file->path;
+  }
+  else {
+    (void)logger_string_copy(directory, file->path, sizeof(directory));
+    directory[(base == file->path) ? 1 : (size_t)(base - file->path)] = '\0';
+    base++;
+  }
+
+  dir = opendir(directory);
+
+  /* GUARD: nothing rotated yet if directory can't be read */
+  if (dir == NULL) {
+    file->generation = 1;
+    return;
+  }
+
+  while ((entry = readdir(dir)) != NULL) {
+    generation = logger_file_generation(entry->d_name, base);
+    newest     = (generation > newest) ? generation : newest;
+  }
+
+  if (file->keep > 0 && newest > file->keep) {
+    rewinddir(dir);
+
+    while ((entry = readdir(dir)) != NULL) {
+      generation = logger_file_generation(entry->d_name, base);
+
+      if (generation > 0 && generation <= newest - file->keep) {
+        (void)snprintf(rotated, sizeof(rotated), "%s.%" PRIu32, file->path, generation);
+        (void)unlink(rotated);
+        (void)snprintf(rotated, sizeof(rotated), "%s.%" PRIu32 LOGGER_COMPRESS_SUFFIX, file->path, generation);
+        (void)unlink(rotated);
+      }
+    }
+  }
+
+  (void)closedir(dir);
+
+  file->generation = newest + 1;
+}
+
+
+/***************************************************************************//**
+ * \brief  Switch the stream of a managed file to a new file.
+ *
+ * Buffered data still goes to the old file. Must be called with the stream
+ * locked and between complete lines.
+ *
+ * \param[in,out] file    Managed file.
+ * \param[in]     fd      Descriptor of the new file, closed afterwards.
+ ******************************************************************************/
+LOGGER_INLINE void logger_file_swap(logger_file_t *file,
+                                    int           fd)
+{
+  (void)fflush(file->stream);
+
+  /* replacing the descriptor keeps the stream and all outputs valid */
+  (void)dup2(fd, fileno(file->stream));
+  (void)close(fd);
+
+  file->next_fd = -1;
+  file->bytes   = 0;
+  file->opened  = time(NULL);
+}
+
+
+/***************************************************************************//**
+ * \brief  Rotate managed file.
+ *
+ * Runs on the background thread. Rename the current file to the next
+ * generation, open a new file at the path and switch the stream to it. Lines
+ * written meanwhile still go to the renamed file. If a continued line is open
+ * the writer switches the stream at the end of the line. Afterwards the
+ * renamed file is queued for compression and the oldest rotated file is
+ * removed.
+ *
+ * If the new file can't be created the rename is undone and the next rotation
+ * is tried after another \c rotate_bytes or \c rotate_interval.
+ *
+ * \param[in,out] file    Managed file.
+ ******************************************************************************/
+LOGGER_INLINE void logger_file_rotate(logger_file_t *file)
+{
+  char rotated[LOGGER_PATH_MAX + LOGGER_FILE_SUFFIX_MAX];
+  int  fd = -1;
+
+  (void)snprintf(rotated, sizeof(rotated), "%s.%" PRIu32, file->path, file->generation);
+
+  if (rename(file->path, rotated) == 0) {
+    fd = open(file->path, O_WRONLY | O_APPEND | O_CREAT, 0666);
+
+    if (fd < 0) {
+      (void)rename(rotated, file->path);
+    }
+  }
+
+  flockfile(file->stream);
+
+  if (fd < 0) {
+    file->bytes  = 0;
+    file->opened = time(NULL);
+  }
+  else if (file->line_open == logger_true) {
+    file->next_fd = fd;
+  }
+  else {
+    logger_file_swap(file, fd);
+  }
+
+  file->rotating = logger_false;
+
+  funlockfile(file->stream);
+
+  /* GUARD: nothing rotated */
+  if (fd < 0) {
+    return;
+  }
+
+  if (file->compress == logger_true) {
+    logger_compress_enqueue(rotated);
+  }
+
+  if (file->keep > 0 && file->generation > file->keep) {
+    (void)snprintf(rotated, sizeof(rotated), "%s.%" PRIu32, file->path, file->generation - file->keep);
+    logger_compress_cancel(rotated);
+    (void)unlink(rotated);
+    (void)snprintf(rotated, sizeof(rotated), "%s.%" PRIu32 LOGGER_COMPRESS_SUFFIX, file->path, file->generation - file->keep);
+    (void)unlink(rotated);
+  }
+
+  file->generation++;
+}
+
+
+/***************************************************************************//**
+ * \brief  Queue rotation of a managed file.
+ *
+ * Must be called with the stream locked.
+ *
+ * \param[in,out] file    Managed file.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_file_rotate_request(logger_file_t *file)
+{
+  /* GUARD: rotation is already queued */
+  if (file->rotating == logger_true) {
+    return(LOGGER_OK);
+  }
+
+  /* GUARD: background thread is busy with too many jobs, try again later */
+  if (logger_compress_job_enqueue(file, "") == logger_false) {
+    return(LOGGER_ERR_UNKNOWN);
+  }
+
+  file->rotating = logger_true;
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Write a line to a managed file.
+ *
+ * Queue rotation if the line would exceed the size limit or the file is too
+ * old. Rotation is postponed while a continued line is open. The writer never
+ * waits for rotation, until the background thread has switched files lines
+ * still go to the current file.
+ *
+ * \param[in,out] file      Managed file.
+ * \param[in]     line      Line to write.
+ * \param[in]     length    Length of line.
+ * \param[in]     complete  Line is never continued, even without '\n'.
+ *
+ * \return     Number of bytes written.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_file_write(logger_file_t       *file,
+                                       const char          *line,
+                                       const size_t        length,
+                                       const logger_bool_t complete)
+{
+  size_t written;
+
+  flockfile(file->stream);
+
+  if (file->line_open == logger_false) {
+    /* new file waited for the end of a continued line */
+    if (file->next_fd >= 0) {
+      logger_file_swap(file, file->next_fd);
+    }
+
+    if (file->bytes > 0 &&
+        ((file->rotate_bytes > 0 && file->bytes + length > file->rotate_bytes) ||
+         (file->rotate_interval > 0 && difftime(time(NULL), file->opened) >= (double)file->rotate_interval))) {
+      (void)logger_file_rotate_request(file);
+    }
+  }
+
+  written = fwrite(line, 1, length, file->stream);
+
+  file->bytes += length;
+
+  if (length > 0) {
+    file->line_open = ((complete == logger_true) || (line[length - 1] == '\n')) ? logger_false : logger_true;
+  }
+
+  funlockfile(file->stream);
+
+  return(written);
+}
+
+
+/***************************************************************************//**
+ * \brief  Store a 32 bit value little endian.
+ *
+ * \param[out]    buffer  Destination of four bytes.
+ * \param[in]     value   Value to store.
+ ******************************************************************************/
+LOGGER_INLINE void logger_compress_put32(uint8_t        *buffer,
+                                         const uint32_t value)
+{
+  buffer[0] = (uint8_t)(value);
+  buffer[1] = (uint8_t)(value >> 8);
+  buffer[2] = (uint8_t)(value >> 16);
+  buffer[3] = (uint8_t)(value >> 24);
+}
+
+
+/***************************************************************************//**
+ * \brief  Load a 32 bit little endian value.
+ *
+ * \param[in]     buffer  Source of four bytes.
+ *
+ * \return        Loaded value.
+ ******************************************************************************/
+LOGGER_INLINE uint32_t logger_compress_get32(const uint8_t *buffer)
+{
+  return((uint32_t)buffer[0]         | ((uint32_t)buffer[1] << 8) |
+         ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24));
+}
+
+
+/***************************************************************************//**
+ * \brief  Write a LZ length extension.
+ *
+ * Lengths not fitting into a token nibble are continued with bytes of 255
+ * followed by the remainder.
+ *
+ * \param[out]    output    Destination buffer.
+ * \param[in,out] position  Write position in destination.
+ * \param[in]     capacity  Size of destination.
+ * \param[in]     length    Remaining length to write.
+ *
+ * \return        \c logger_true if length fit into buffer, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_lz_length_put(uint8_t      *output,
+                                                 size_t       *position,
+                                                 const size_t capacity,
+                                                 size_t       length)
+{
+  for ( ; length >= 255 ; length -= 255) {
+    if (*position >= capacity) {
+      return(logger_false);
+    }
+    output[(*position)++] = 255;
+  }
+
+  if (*position >= capacity) {
+    return(logger_false);
+  }
+  output[(*position)++] = (uint8_t)length;
+
+  return(logger_true);
+}
+
+
+/***************************************************************************//**
+ * \brief  Write one LZ sequence.
+ *
+ * A sequence consists of a token holding literal length and match length in
+ * its nibbles, optional length extensions, the literals and a 16 bit match
+ * offset. The last sequence of a block only contains literals.
+ *
+ * \param[out]    output    Destination buffer.
+ * \param[in,out] position  Write position in destination.
+ * \param[in]     capacity  Size of destination.
+ * \param[in]     literals  Literal bytes.
+ * \param[in]     count     Number of literal bytes.
+ * \param[in]     offset    Match offset, 0 for the last sequence.
+ * \param[in]     length    Match length, at least \c LOGGER_LZ_MATCH_MIN.
+ *
+ * \return        \c logger_true if sequence fit into buffer, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_lz_sequence_put(uint8_t       *output,
+                                                   size_t        *position,
+                                                   const size_t  capacity,
+                                                   const uint8_t *literals,
+                                                   const size_t  count,
+                                                   const size_t  offset,
+                                                   const size_t  length)
+{
+  size_t match = (offset > 0) ? length - LOGGER_LZ_MATCH_MIN : 0;
+
+  if (*position >= capacity) {
+    return(logger_false);
+  }
+  output[(*position)++] = (uint8_t)((LOGGER_NUMERIC_MIN(count, 15) << 4) | LOGGER_NUMERIC_MIN(match, 15));
+
+  if (count >= 15 && logger_lz_length_put(output, position, capacity, count - 15) == logger_false) {
+    return(logger_false);
+  }
+
+  if (count > capacity - *position) {
+    return(logger_false);
+  }
+  (void)memcpy(&output[*position], literals, count);
+  *position += count;
+
+  /* last sequence has no match */
+  if (offset == 0) {
+    return(logger_true);
+  }
+
+  if (capacity - *position < 2) {
+    return(logger_false);
+  }
+  output[(*position)++] = (uint8_t)(offset);
+  output[(*position)++] = (uint8_t)(offset >> 8);
+
+  if (match >= 15 && logger_lz_length_put(output, position, capacity, match - 15) == logger_false) {
+    return(logger_false);
+  }
+
+  return(logger_true);
+}
+
+
+/***************************************************************************//**
+ * \brief  Compress a block with the built in LZ compressor.
+ *
+ * Greedy LZ77 using a single entry hash table of four byte sequences. Matches
+ * never reach outside the block so each block decompresses on its own.
+ *
+ * \param[in]     input     Uncompressed data.
+ * \param[in]     size      Size of uncompressed data.
+ * \param[out]    output    Destination buffer.
+ * \param[in]     capacity  Size of destination.
+ *
+ * \return        Size of compressed data, 0 if it didn't fit into destination.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_lz_compress(const uint8_t *input,
+                                        const size_t  size,
+                                        uint8_t       *output,
+                                        const size_t  capacity)
+{
+  size_t   position = 0;
+  size_t   anchor   = 0;
+  size_t   current  = 0;
+  size_t   reference;
+  size_t   length;
+  uint32_t sequence;
+  uint32_t hash;
+
+  (void)memset(logger_lz_hash, 0, sizeof(logger_lz_hash));
+
+  while (size >= LOGGER_LZ_MATCH_MIN && current <= size - LOGGER_LZ_MATCH_MIN) {
+    (void)memcpy(&sequence, &input[current], sizeof(sequence));
+    hash                 = (sequence * 2654435761U) >> (32 - LOGGER_LZ_HASH_BITS);
+    reference            = logger_lz_hash[hash];
+    logger_lz_hash[hash] = (uint32_t)(current + 1);
+
+    if (reference == 0 ||
+        current - (reference - 1) > 0xFFFF ||
+        memcmp(&input[reference - 1], &input[current], LOGGER_LZ_MATCH_MIN) != 0) {
+      current++;
+      continue;
+    }
+
+    reference--;
+    for (length = LOGGER_LZ_MATCH_MIN ; current + length < size && input[reference + length] == input[current + length] ; length++) {
+      /* extend match */
+    }
+
+    if (logger_lz_sequence_put(output, &position, capacity, &input[anchor], current - anchor, current - reference, length) == logger_false) {
+      return(0);
+    }
+
+    current += length;
+    anchor   = current;
+  }
+
+  if (logger_lz_sequence_put(output, &position, capacity, &input[anchor], size - anchor, 0, 0) == logger_false) {
+    return(0);
+  }
+
+  return(position);
+}
+
+
+/***************************************************************************//**
+ * \brief  Read a LZ length extension.
+ *
+ * \param[in]     input     Compressed data.
+ * \param[in,out] position  Read position in compressed data.
+ * \param[in]     size      Size of compressed data.
+ * \param[in,out] length    Length to extend.
+ *
+ * \return        \c logger_true if extension is valid, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_lz_length_get(const uint8_t *input,
+                                                 size_t        *position,
+                                                 const size_t  size,
+                                                 size_t        *length)
+{
+  uint8_t value;
+
+  do {
+    if (*position >= size) {
+      return(logger_false);
+    }
+    value    = input[(*position)++];
+    *length += value;
+  } while (value == 255);
+
+  return(logger_true);
+}
+
+
+/***************************************************************************//**
+ * \brief  Decompress a block of the built in LZ compressor.
+ *
+ * Every length and offset is checked, corrupted input never reads or writes
+ * outside of the given buffers.
+ *
+ * \param[in]     input     Compressed data.
+ * \param[in]     size      Size of compressed data.
+ * \param[out]    output    Destination buffer.
+ * \param[in]     capacity  Size of destination.
+ *
+ * \return        Size of decompressed data, -1 if data is invalid.
+ ******************************************************************************/
+LOGGER_INLINE long logger_lz_decompress(const uint8_t *input,
+                                        const size_t  size,
+                                        uint8_t       *output,
+                                        const size_t  capacity)
+{
+  size_t  current  = 0;
+  size_t  position = 0;
+  size_t  count;
+  size_t  offset;
+  size_t  length;
+  uint8_t token;
+
+  while (current < size) {
+    token = input[current++];
+    count = token >> 4;
+
+    if (count == 15 && logger_lz_length_get(input, &current, size, &count) == logger_false) {
+      return(-1);
+    }
+
+    if (count > size - current || count > capacity - position) {
+      return(-1);
+    }
+    (void)memcpy(&output[position], &input[current], count);
+    current  += count;
+    position += count;
+
+    /* last sequence has no match */
+    if (current == size) {
+      break;
+    }
+
+    if (size - current < 2) {
+      return(-1);
+    }
+    offset   = (size_t)input[current] | ((size_t)input[current + 1] << 8);
+    current += 2;
+    length   = token & 0x0F;
+
+    if (length == 15 && logger_lz_length_get(input, &current, size, &length) == logger_false) {
+      return(-1);
+    }
+    length += LOGGER_LZ_MATCH_MIN;
+
+    if (offset == 0 || offset > position || length > capacity - position) {
+      return(-1);
+    }
+
+    /* copy byte wise, source and destination may overlap */
+    for ( ; length > 0 ; length--, position++) {
+      output[position] = output[position - offset];
+    }
+  }
+
+  return((long)position);
+}
+
+
+/***************************************************************************//**
+ * \brief  Compress one block including its header.
+ *
+ * Uses zlib if available and the built in LZ compressor otherwise. Blocks not
+ * getting smaller are stored uncompressed.
+ *
+ * \param[in]     input   Uncompressed data.
+ * \param[in]     size    Size of uncompressed data.
+ * \param[out]    output  Destination of at least \c LOGGER_COMPRESS_BLOCK_BOUND bytes.
+ *
+ * \return        Size of block including header.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_compress_block(const uint8_t *input,
+                                           const size_t  size,
+                                           uint8_t       *output)
+{
+  uint8_t                  *payload = &output[LOGGER_COMPRESS_HEADER_SIZE];
+  logger_compress_method_t method   = LOGGER_COMPRESS_METHOD_STORED;
+  size_t                   length   = 0;
+#ifdef LOGGER_HAVE_ZLIB
+  uLongf                   zlength  = (uLongf)(LOGGER_COMPRESS_BLOCK_BOUND - LOGGER_COMPRESS_HEADER_SIZE);
+
+  if (compress2(payload, &zlength, input, (uLong)size, Z_BEST_SPEED) == Z_OK) {
+    method = LOGGER_COMPRESS_METHOD_ZLIB;
+    length = (size_t)zlength;
+  }
+#else  /* LOGGER_HAVE_ZLIB */
+  length = logger_lz_compress(input, size, payload, LOGGER_COMPRESS_BLOCK_BOUND - LOGGER_COMPRESS_HEADER_SIZE);
+  method = LOGGER_COMPRESS_METHOD_LZ;
+#endif /* LOGGER_HAVE_ZLIB */
+
+  if (length == 0 || length >= size) {
+    method = LOGGER_COMPRESS_METHOD_STORED;
+    length = size;
+    (void)memcpy(payload, input, size);
+  }
+
+  (void)memcpy(output, logger_compress_magic, sizeof(logger_compress_magic));
+  output[4] = (uint8_t)method;
+  output[5] = 0;
+  output[6] = 0;
+  output[7] = 0;
+  logger_compress_put32(&output[8],  (uint32_t)size);
+  logger_compress_put32(&output[12], (uint32_t)length);
+
+  return(LOGGER_COMPRESS_HEADER_SIZE + length);
+}
+
+
+/***************************************************************************//**
+ * \brief  Compress a rotated file.
+ *
+ * Write `path.lz` block by block through a temporary file and remove the
+ * uncompressed file on success.
+ *
+ * \param[in]     path    Path of rotated file.
+ ******************************************************************************/
+LOGGER_INLINE void logger_compress_file(const char *path)
+{
+  char          target[LOGGER_PATH_MAX + LOGGER_FILE_SUFFIX_MAX];
+  char          temporary[LOGGER_PATH_MAX + LOGGER_FILE_SUFFIX_MAX];
+  FILE          *source;
+  FILE          *destination;
+  size_t        size;
+  size_t        length;
+  logger_bool_t failed = logger_false;
+
+  (void)snprintf(target,    sizeof(target),    "%s" LOGGER_COMPRESS_SUFFIX, path);
+  (void)snprintf(temporary, sizeof(temporary), "%s" LOGGER_COMPRESS_SUFFIX ".tmp", path);
+
+  source = fopen(path, "rb");
+
+  /* GUARD: file vanished */
+  if (source == NULL) {
+    return;
+  }
+
+  destination = fopen(temporary, "wb");
+
+  /* GUARD: leave file uncompressed if target can't be written */
+  if (destination == NULL) {
+    (void)fclose(source);
+    return;
+  }
+
+  while ((size = fread(logger_compress_input, 1, sizeof(logger_compress_input), source)) > 0) {
+    length = logger_compress_block(logger_compress_input, size, logger_compress_output);
+
+    if (fwrite(logger_compress_output, 1, length, destination) != length) {
+      failed = logger_true;
+      break;
+    }
+  }
+
+  if (ferror(source) != 0) {
+    failed = logger_true;
+  }
+
+  (void)fclose(source);
+
+  if (fclose(destination) != 0) {
+    failed = logger_true;
+  }
+
+  if (failed == logger_false && rename(temporary, target) == 0) {
+    (void)unlink(path);
+  }
+  else {
+    (void)unlink(temporary);
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Background compression and rotation thread.
+ *
+ * Take jobs from the queue one after the other, rotate managed files and
+ * compress rotated files.
+ *
+ * \param[in]     argument  Unused.
+ *
+ * \return        Never returns.
+ ******************************************************************************/
+static void *logger_compress_worker(void *argument)
+{
+  (void)argument;
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  for (;;) {
+    while (logger_compress.count == 0) {
+      (void)pthread_cond_wait(&logger_compress.wakeup, &logger_compress.mutex);
+    }
+
+    (void)memcpy(&logger_compress.current, &logger_compress.jobs[logger_compress.head], sizeof(logger_compress.current));
+    logger_compress.head   = (logger_compress.head + 1) % LOGGER_ELEMENTS(logger_compress.jobs);
+    logger_compress.count--;
+    logger_compress.busy   = logger_true;
+    logger_compress.cancel = logger_false;
+
+    (void)pthread_mutex_unlock(&logger_compress.mutex);
+
+    if (logger_compress.current.rotate != NULL) {
+      logger_file_rotate(logger_compress.current.rotate);
+    }
+    else {
+      logger_compress_file(logger_compress.current.path);
+    }
+
+    (void)pthread_mutex_lock(&logger_compress.mutex);
+
+    /* file has been pruned while it was compressed */
+    if (logger_compress.cancel == logger_true) {
+      char target[LOGGER_PATH_MAX + LOGGER_FILE_SUFFIX_MAX];
+
+      (void)snprintf(target, sizeof(target), "%s" LOGGER_COMPRESS_SUFFIX, logger_compress.current.path);
+      (void)unlink(target);
+    }
+
+    logger_compress.busy = logger_false;
+    (void)pthread_cond_broadcast(&logger_compress.idle);
+  }
+
+  return(NULL);
+}
+
+
+/***************************************************************************//**
+ * \brief  Start the background compression thread.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_compress_start(void)
+{
+  logger_return_t ret = LOGGER_OK;
+  pthread_attr_t  attributes;
+  pthread_t       thread;
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  if (logger_compress.running == logger_false) {
+    if (pthread_attr_init(&attributes) != 0) {
+      ret = LOGGER_ERR_UNKNOWN;
+    }
+    else {
+      (void)pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+      if (pthread_create(&thread, &attributes, logger_compress_worker, NULL) != 0) {
+        ret = LOGGER_ERR_UNKNOWN;
+      }
+      else {
+        logger_compress.running = logger_true;
+      }
+
+      (void)pthread_attr_destroy(&attributes);
+    }
+  }
+
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Queue a background job.
+ *
+ * The caller never waits for the job. Jobs not fitting are counted as dropped,
+ * see \c logger_output_file_queue_stats_get().
+ *
+ * \param[in]     rotate  Managed file to rotate, \c NULL to compress \p path.
+ * \param[in]     path    Path of rotated file to compress.
+ *
+ * \return        \c logger_true if the job is queued, logger_false if the queue is full.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_compress_job_enqueue(logger_file_t *rotate,
+                                                        const char    *path)
+{
+  logger_bool_t queued = logger_false;
+  size_t        index;
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  if (logger_compress.count < LOGGER_ELEMENTS(logger_compress.jobs)) {
+    index = (logger_compress.head + logger_compress.count) % LOGGER_ELEMENTS(logger_compress.jobs);
+    logger_compress.jobs[index].rotate = rotate;
+    (void)logger_string_copy(logger_compress.jobs[index].path, path, sizeof(logger_compress.jobs[index].path));
+    logger_compress.jobs[index].path[sizeof(logger_compress.jobs[index].path) - 1] = '\0';
+    logger_compress.count++;
+    logger_compress.peak = LOGGER_NUMERIC_MAX(logger_compress.peak, logger_compress.count);
+    queued = logger_true;
+
+    (void)pthread_cond_signal(&logger_compress.wakeup);
+  }
+  else {
+    logger_compress.dropped++;
+  }
+
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
+
+  return(queued);
+}
+
+
+/***************************************************************************//**
+ * \brief  Queue a rotated file for compression.
+ *
+ * The caller never waits for compression. If the queue is full the file stays
+ * uncompressed.
+ *
+ * \param[in]     path    Path of rotated file.
+ ******************************************************************************/
+LOGGER_INLINE void logger_compress_enqueue(const char *path)
+{
+  (void)logger_compress_job_enqueue((logger_file_t *)NULL, path);
+}
+
+
+/***************************************************************************//**
+ * \brief  Wait until a managed file has no queued or running rotation.
+ *
+ * \param[in]     file    Managed file.
+ ******************************************************************************/
+LOGGER_INLINE void logger_compress_rotate_wait(const logger_file_t *file)
+{
+  logger_bool_t pending = logger_true;
+  size_t        index;
+
+  /* GUARD: nothing to wait for without worker */
+  if (logger_compress.running == logger_false) {
+    return;
+  }
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  while (pending == logger_true) {
+    pending = (logger_compress.busy == logger_true && logger_compress.current.rotate == file) ? logger_true : logger_false;
+
+    for (index = 0 ; index < logger_compress.count ; index++) {
+      if (logger_compress.jobs[(logger_compress.head + index) % LOGGER_ELEMENTS(logger_compress.jobs)].rotate == file) {
+        pending = logger_true;
+      }
+    }
+
+    if (pending == logger_true) {
+      (void)pthread_cond_wait(&logger_compress.idle, &logger_compress.mutex);
+    }
+  }
+
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
+}
+
+
+/***************************************************************************//**
+ * \brief  Drop a rotated file from compression.
+ *
+ * Remove a pending job for a pruned file or mark the running job to delete
+ * its result.
+ *
+ * \param[in]     path    Path of pruned file.
+ ******************************************************************************/
+LOGGER_INLINE void logger_compress_cancel(const char *path)
+{
+  size_t index;
+  size_t kept = 0;
+  size_t source;
+  size_t destination;
+
+  /* GUARD: nothing to cancel without worker */
+  if (logger_compress.running == logger_false) {
+    return;
+  }
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  for (index = 0 ; index < logger_compress.count ; index++) {
+    source      = (logger_compress.head + index) % LOGGER_ELEMENTS(logger_compress.jobs);
+    destination = (logger_compress.head + kept)  % LOGGER_ELEMENTS(logger_compress.jobs);
+
+    if (logger_compress.jobs[source].rotate != NULL || strcmp(logger_compress.jobs[source].path, path) != 0) {
+      if (source != destination) {
+        (void)memcpy(&logger_compress.jobs[destination], &logger_compress.jobs[source], sizeof(logger_compress.jobs[destination]));
+      }
+      kept++;
+    }
+  }
+  logger_compress.count = kept;
+
+  if (logger_compress.busy == logger_true && logger_compress.current.rotate == NULL && strcmp(logger_compress.current.path, path) == 0) {
+    logger_compress.cancel = logger_true;
+  }
+
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
+}
+
+
+/***************************************************************************//**
+ * \brief  Wait until all queued files are compressed.
+ ******************************************************************************/
+LOGGER_INLINE void logger_compress_drain(void)
+{
+  /* GUARD: nothing to wait for without worker */
+  if (logger_compress.running == logger_false) {
+    return;
+  }
+
+  (void)pthread_mutex_lock(&logger_compress.mutex);
+
+  while (logger_compress.count > 0 || logger_compress.busy == logger_true) {
+    (void)pthread_cond_wait(&logger_compress.idle, &logger_compress.mutex);
+  }
+
+  (void)pthread_mutex_unlock(&logger_compress.mutex);
+}
+
+
+/***************************************************************************//**
+ * \brief  Calculate checksum of a flight recorder record.
+ *
+ * 32 bit FNV-1a over the record header with checksum set to 0 followed by the
+ * strings of the record.
+ *
+ * \param[in]     record   Record header.
+ * \param[in]     strings  Strings of the record.
+ *
+ * \return        Checksum of record.
+ ******************************************************************************/
+LOGGER_INLINE uint32_t logger_recorder_checksum(const logger_recorder_record_t *record,
+                                                const uint8_t                  *strings)
+{
+  logger_recorder_record_t header = *record;
+  const uint8_t            *data  = (const uint8_t *)&header;
+  uint32_t                 hash   = 2166136261U;
+  size_t                   length = 0;
+  size_t                   index;
+
+  header.checksum = 0;
+
+  for (index = 0 ; index < sizeof(header) ; index++) {
+    hash = (hash ^ data[index]) * 16777619U;
+  }
+
+  for (index = 0 ; index < LOGGER_RECORDER_STRINGS ; index++) {
+    length += header.lengths[index];
+  }
+
+  for (index = 0 ; index < length ; index++) {
+    hash = (hash ^ strings[index]) * 16777619U;
+  }
+
+  return(hash);
+}
+
+
+/***************************************************************************//**
+ * \brief  Check a flight recorder record.
+ *
+ * A record is valid if it has the magic number, its sizes fit into the ring,
+ * its strings are terminated and the checksum matches.
+ *
+ * \param[in]     buffer    Ring buffer.
+ * \param[in]     size      Size of ring buffer.
+ * \param[in]     position  Position of record.
+ *
+ * \return        \c logger_true if record is valid, logger_false otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_bool_t logger_recorder_valid(const uint8_t *buffer,
+                                                  const size_t  size,
+                                                  const size_t  position)
+{
+  const logger_recorder_record_t *record;
+  const uint8_t                  *strings;
+  size_t                         length = sizeof(logger_recorder_record_t);
+  size_t                         index;
+
+  /* GUARD: header must fit into ring */
+  if (position > size || size - position < sizeof(logger_recorder_record_t)) {
+    return(logger_false);
+  }
+
+  record  = (const logger_recorder_record_t *)&buffer[position];
+  strings = &buffer[position + sizeof(*record)];
+
+  for (index = 0 ; index < LOGGER_RECORDER_STRINGS ; index++) {
+    length += record->lengths[index];
+  }
+
+  /* GUARD: check magic and sizes */
+  if (record->magic != LOGGER_RECORDER_MAGIC ||
+      record->size < length ||
+      record->size > size - position ||
+      (record->size % LOGGER_RECORDER_ALIGNMENT) != 0) {
+    return(logger_false);
+  }
+
+  /* GUARD: every string must be terminated */
+  for (index = 0 ; index < LOGGER_RECORDER_STRINGS ; index++) {
+    if (record->lengths[index] == 0 || strings[record->lengths[index] - 1] != '\0') {
+      return(logger_false);
+    }
+    strings += record->lengths[index];
+  }
+
+  return((record->checksum == logger_recorder_checksum(record, &buffer[position + sizeof(*record)])) ? logger_true : logger_false);
+}
+
+
+/***************************************************************************//**
+ * \brief  Find the next valid record in a ring buffer.
+ *
+ * Scan aligned positions, skipping torn or overwritten records.
+ *
+ * \param[in]     buffer    Ring buffer.
+ * \param[in]     size      Size of ring buffer.
+ * \param[in]     position  First position to check.
+ *
+ * \return        Position of next valid record, \p size if there is none.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_recorder_scan(const uint8_t *buffer,
+                                          const size_t  size,
+                                          size_t        position)
+{
+  for ( ; position < size ; position += LOGGER_RECORDER_ALIGNMENT) {
+    if (logger_recorder_valid(buffer, size, position) == logger_true) {
+      return(position);
+    }
+  }
+
+  return(size);
+}
+
 
-  return(level);
+/***************************************************************************//**
+ * \brief  Copy a string into a record.
+ *
+ * \param[out]    destination  Destination in record.
+ * \param[in]     source       String to copy.
+ * \param[in]     length       Length of the string in the record including '\0'.
+ *
+ * \return        Pointer behind the copied string.
+ ******************************************************************************/
+LOGGER_INLINE uint8_t *logger_recorder_string_put(uint8_t      *destination,
+                                                  const char   *source,
+                                                  const size_t length)
+{
+  (void)memcpy(destination, source, length - 1);
+  destination[length - 1] = '\0';
+
+  return(destination + length);
 }
 
 
 /***************************************************************************//**
- * \brief  Enable the global output stream color setting.
+ * \brief  Prepare the header of a flight recorder record.
  *
- * Enable the color setting for a given output stream.
+ * Strings are truncated to fit into \p budget, every string keeps at least its
+ * '\0'. The sequence number is left to the caller.
  *
- * \param[in]     stream  Opened file stream.
+ * \param[out]    record   Header of record.
+ * \param[in]     strings  ID name, file, function and message.
+ * \param[in]     budget   Maximum size of strings, at least one byte each.
+ * \param[in]     level    Level of this message.
+ * \param[in]     line     Line where this call happened.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Size of record including strings and padding.
  ******************************************************************************/
-logger_return_t logger_output_color_enable(FILE *stream)
+LOGGER_INLINE size_t logger_recorder_record_init(logger_recorder_record_t *record,
+                                                 const char               **strings,
+                                                 size_t                   budget,
+                                                 logger_level_t           level,
+                                                 uint32_t                 line)
 {
-  /* set stream output level to global outputs */
-  return(logger_output_common_color(logger_outputs,
-                                    LOGGER_ELEMENTS(logger_outputs),
-                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                    stream,
-                                    (logger_output_function_t)NULL,
-                                    logger_true));
+  size_t size = sizeof(logger_recorder_record_t);
+  size_t index;
+
+  (void)memset(record, 0, sizeof(*record));
+
+  for (index = 0 ; index < LOGGER_RECORDER_STRINGS ; index++) {
+    record->lengths[index]  = (uint16_t)LOGGER_NUMERIC_MIN(strlen(strings[index]) + 1, LOGGER_NUMERIC_MIN(budget - (LOGGER_RECORDER_STRINGS - 1 - index), 0xFFFF));
+    budget                 -= record->lengths[index];
+    size                   += record->lengths[index];
+  }
+
+  size = (size + LOGGER_RECORDER_ALIGNMENT - 1) & ~(size_t)(LOGGER_RECORDER_ALIGNMENT - 1);
+
+  record->magic = LOGGER_RECORDER_MAGIC;
+  record->size  = (uint32_t)size;
+  record->time  = (int64_t)time(NULL);
+  record->line  = line;
+  record->level = level;
+
+  return(size);
 }
 
 
 /***************************************************************************//**
- * \brief  Disable the global output stream color setting.
+ * \brief  Write the strings of a flight recorder record.
  *
- * Disable the color setting for a given output stream.
+ * Copy the strings behind the header and set the checksum of the header, the
+ * header itself is left to the caller.
  *
- * \param[in]     stream  Opened file stream.
+ * \param[out]    data     Destination of strings.
+ * \param[in,out] record   Header of record.
+ * \param[in]     strings  ID name, file, function and message.
+ ******************************************************************************/
+LOGGER_INLINE void logger_recorder_record_write(uint8_t                  *data,
+                                                logger_recorder_record_t *record,
+                                                const char               **strings)
+{
+  uint8_t *write_ptr = data;
+  size_t  index;
+
+  for (index = 0 ; index < LOGGER_RECORDER_STRINGS ; index++) {
+    write_ptr = logger_recorder_string_put(write_ptr, strings[index], record->lengths[index]);
+  }
+
+  record->checksum = logger_recorder_checksum(record, data);
+}
+
+
+/***************************************************************************//**
+ * \brief  Format message that is not printed right away.
+ *
+ * Like logger_format_message() but without changing the continuation state of
+ * the ID, the message is not printed.
+ *
+ * \param[out]    message       Formatted message.
+ * \param[in]     message_size  Size of message storage.
+ * \param[in]     format        \c printf() like format string.
+ * \param[in]     argp          variable argument list pointer
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_output_color_disable(FILE *stream)
+LOGGER_INLINE logger_return_t logger_format_message_quiet(char       *message,
+                                                          size_t     message_size,
+                                                          const char *format,
+                                                          va_list    argp)
 {
-  /* set stream output level to global outputs */
-  return(logger_output_common_color(logger_outputs,
-                                    LOGGER_ELEMENTS(logger_outputs),
-                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                    stream,
-                                    (logger_output_function_t)NULL,
-                                    logger_false));
+  char *message_end;
+
+  (void)vsnprintf(message, message_size, format, argp);
+
+  /* make sure message is '\0' terminated */
+  message[message_size - 1] = '\0';
+
+  /* remove trailing '\n' like for printed messages */
+  message_end = strrchr(message, '\n');
+  if (message_end != NULL && message_end[1] == '\0') {
+    *message_end = '\0';
+  }
+
+  return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Query the global output stream color setting.
+ * \brief  Format message that is not printed.
  *
- * Query the color setting for a given output stream.
+ * \param[out]    message       Formatted message.
+ * \param[in]     message_size  Size of message storage.
+ * \param[in,out] kv            Structured message used instead of format and
+ *                              argp, NULL for \c printf() like messages.
+ * \param[in]     format        \c printf() like format string.
+ * \param[in]     argp          variable argument list pointer
+ ******************************************************************************/
+LOGGER_INLINE void logger_format_quiet(char             *message,
+                                       size_t           message_size,
+                                       logger_kv_list_t *kv,
+                                       const char       *format,
+                                       va_list          argp)
+{
+  if (kv != NULL) {
+    logger_kv_render(message, message_size, kv, LOGGER_KV_FORMAT_TEXT);
+  }
+  else {
+    (void)logger_format_message_quiet(message, message_size, format, argp);
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Keep message that is not printed in flight recorder.
  *
- * \param[in]     stream    Opened file stream.
+ * The message is formatted on the stack of the calling thread, so no lock is
+ * needed.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happened.
+ * \param[in]     function  Name of function where this call happened.
+ * \param[in]     line      Line where this call happened.
+ * \param[in,out] kv        Structured message used instead of format and
+ *                          argp, NULL for \c printf() like messages.
+ * \param[in]     format    \c printf() like format string.
+ * \param[in]     argp      variable argument list pointer
  ******************************************************************************/
-logger_bool_t logger_output_color_is_enabled(FILE *stream)
+LOGGER_INLINE void logger_recorder_message(logger_id_t      id,
+                                           logger_level_t   level,
+                                           const char       *file,
+                                           const char       *function,
+                                           uint32_t         line,
+                                           logger_kv_list_t *kv,
+                                           const char       *format,
+                                           va_list          argp)
 {
-  /* check if color for this stream is enabled */
-  return(logger_output_common_color_is_enabled(logger_outputs,
-                                               LOGGER_ELEMENTS(logger_outputs),
-                                               LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                               stream,
-                                               (logger_output_function_t)NULL));
+  char message[LOGGER_MESSAGE_STRING_MAX];
+
+  /* GUARD: level is not recorded */
+  if ((logger_recorder.level & level) == 0) {
+    return;
+  }
+
+  logger_format_quiet(message, sizeof(message), kv, format, argp);
+
+  logger_recorder_put(id, level, file, function, line, message);
 }
 
 
 /***************************************************************************//**
- * \brief  Flush all output streams.
+ * \brief  Store a message in the flight recorder.
  *
- * Force a flush of all output streams.
+ * Strings are truncated so a single record never uses more than a quarter of
+ * the ring. Space is reserved by moving the cursor without locking, oldest
+ * records are overwritten. Position and sequence number share the cursor, so
+ * records follow each other in the ring in the order of their numbers. A
+ * thread stalled while the ring goes round once may have its record torn by
+ * another thread, the record then fails its checksum and is skipped.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happened.
+ * \param[in]     function  Name of function where this call happened.
+ * \param[in]     line      Line where this call happened.
+ * \param[in]     message   Formatted message.
  ******************************************************************************/
-logger_return_t logger_output_flush(void)
+LOGGER_INLINE void logger_recorder_put(logger_id_t    id,
+                                       logger_level_t level,
+                                       const char     *file,
+                                       const char     *function,
+                                       uint32_t       line,
+                                       const char     *message)
 {
-  size_t index;
-  size_t id;
+  const char               *strings[LOGGER_RECORDER_STRINGS];
+  logger_recorder_record_t record;
+  uint64_t                 cursor;
+  uint64_t                 next;
+  size_t                   size;
+  size_t                   head;
+  size_t                   start;
 
-  /* outputs will change, print repeat message */
-  logger_repeat_message();
+  strings[0] = logger_control[id].name;
+  strings[1] = logger_strip_path(file);
+  strings[2] = function;
+  strings[3] = message;
 
-  /* outputs will change, print rate limit message */
-  logger_rate_limit_message(logger_true);
+  size = logger_recorder_record_init(&record, strings, logger_recorder.size / 4 - sizeof(logger_recorder_record_t), level, line);
 
-  /* search for used global outputs */
-  for (index = 0 ; index < LOGGER_ELEMENTS(logger_outputs) ; index++) {
-    if (logger_outputs[index].count > 0) {
-      (void)fflush(logger_outputs[index].stream);
-    }
+  cursor = LOGGER_ATOMIC_LOAD(&logger_recorder.cursor);
+
+  do {
+    head = (size_t)(cursor >> 32);
+
+    /* wrap to the start of the ring if the record doesn't fit at the end */
+    start = (head + size > logger_recorder.size) ? 0 : head;
+
+    /* keep the next position valid for readers */
+    next = ((start + size + sizeof(logger_recorder_record_t) > logger_recorder.size) ? 0 : (uint64_t)(start + size) << 32) |
+           (uint32_t)(cursor + 1);
+  } while (LOGGER_ATOMIC_SWAP(&logger_recorder.cursor, &cursor, next) == 0);
+
+  /* mark the unused end of the ring */
+  if ((start != head) &&
+      (head + sizeof(logger_recorder_record_t) <= logger_recorder.size)) {
+    ((logger_recorder_record_t *)&logger_recorder.buffer[head])->size = 0;
   }
 
-  /* search for used id specific outputs */
-  for (id = 0 ; id < LOGGER_ELEMENTS(logger_control) ; id++) {
-    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control[id].outputs) ; index++) {
-      if (logger_control[id].outputs[index].count > 0) {
-        (void)fflush(logger_control[id].outputs[index].stream);
-      }
+  record.sequence = (uint32_t)next;
+
+  /* write strings before header, an interrupted record never looks valid */
+  logger_recorder_record_write(&logger_recorder.buffer[start + sizeof(record)], &record, strings);
+  (void)memcpy(&logger_recorder.buffer[start], &record, sizeof(record));
+}
+
+
+/***************************************************************************//**
+ * \brief  Write buffered dump output.
+ *
+ * \param[in,out] dump    Dump buffer.
+ ******************************************************************************/
+LOGGER_INLINE void logger_recorder_dump_flush(logger_recorder_dump_t *dump)
+{
+  size_t  written = 0;
+  ssize_t ret;
+
+  while (written < dump->used) {
+    ret = write(dump->fd, &dump->data[written], dump->used - written);
+
+    if (ret <= 0) {
+      break;
     }
+
+    written += (size_t)ret;
   }
 
-  return(LOGGER_OK);
+  dump->used = 0;
 }
 
 
 /***************************************************************************//**
- * \brief  Register a global output function.
+ * \brief  Add a string to dump output.
  *
- * The user provided function must take a single string argument. The default
- * logging level is set to \c LOGGER_UNKNOWN thus this function will not be
- * called for any message.
+ * \param[in,out] dump    Dump buffer.
+ * \param[in]     string  String to add.
+ * \param[in]     length  Maximum number of characters to add.
+ ******************************************************************************/
+LOGGER_INLINE void logger_recorder_dump_string(logger_recorder_dump_t *dump,
+                                               const char             *string,
+                                               size_t                 length)
+{
+  for ( ; length > 0 && *string != '\0' ; length--, string++) {
+    if (dump->used >= sizeof(dump->data)) {
+      logger_recorder_dump_flush(dump);
+    }
+
+    dump->data[dump->used++] = *string;
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Add a decimal number to dump output.
  *
- * \param[in]     function  User provided output function.
+ * \param[in,out] dump    Dump buffer.
+ * \param[in]     number  Number to add.
+ ******************************************************************************/
+LOGGER_INLINE void logger_recorder_dump_number(logger_recorder_dump_t *dump,
+                                               uint64_t               number)
+{
+  char digits[21];
+  char *ptr = &digits[LOGGER_ELEMENTS(digits) - 1];
+
+  /* convert number to string, starting with the lowest digit at the end of the string */
+  *ptr = '\0';
+  do {
+    *(--ptr) = logger_int_to_char[number % 10];
+    number  /= 10;
+  } while (number > 0);
+
+  logger_recorder_dump_string(dump, ptr, sizeof(digits));
+}
+
+
+/***************************************************************************//**
+ * \brief  Add a record to dump output.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * Each line starts with sequence number and time followed by ID name, level,
+ * file, function, line and message.
+ *
+ * \param[in,out] dump    Dump buffer.
+ * \param[in]     record  Valid record.
  ******************************************************************************/
-logger_return_t logger_output_function_register(logger_output_function_t function)
+LOGGER_INLINE void logger_recorder_dump_record(logger_recorder_dump_t         *dump,
+                                               const logger_recorder_record_t *record)
 {
-  logger_return_t ret = LOGGER_OK;
+  const char *string = (const char *)(record + 1);
+  size_t     index;
 
-  /* add function to global outputs */
-  ret = logger_output_common_register(logger_outputs,
-                                      LOGGER_ELEMENTS(logger_outputs),
-                                      LOGGER_OUTPUT_TYPE_FUNCTION,
-                                      (FILE *)NULL,
-                                      function);
+  logger_recorder_dump_number(dump, record->sequence);
+  logger_recorder_dump_string(dump, " ", 1);
+  logger_recorder_dump_number(dump, (uint64_t)record->time);
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+  for (index = 0 ; index < LOGGER_RECORDER_STRINGS ; index++) {
+    logger_recorder_dump_string(dump, ":", 1);
 
-  return(ret);
+    /* level and line are placed like in the standard prefix */
+    if (index == 1) {
+      logger_recorder_dump_string(dump, logger_level_names[logger_level_to_index(record->level)], strlen(logger_level_names[logger_level_to_index(record->level)]));
+      logger_recorder_dump_string(dump, ":", 1);
+    }
+    if (index == 3) {
+      logger_recorder_dump_number(dump, record->line);
+      logger_recorder_dump_string(dump, ": ", 2);
+    }
+
+    logger_recorder_dump_string(dump, string, record->lengths[index]);
+    string += record->lengths[index];
+  }
+
+  logger_recorder_dump_string(dump, "\n", 1);
 }
 
 
 /***************************************************************************//**
- * \brief  Deregister a global output function:
+ * \brief  Add a record to dump output if it is newer than the dumped ones.
  *
- * Remove given output function from list of outputs.
+ * \param[in,out] dump      Dump buffer.
+ * \param[in]     record    Valid record.
+ * \param[in,out] sequence  Sequence number of last dumped record.
+ ******************************************************************************/
+LOGGER_INLINE void logger_recorder_dump_newer(logger_recorder_dump_t         *dump,
+                                              const logger_recorder_record_t *record,
+                                              uint32_t                       *sequence)
+{
+  /* GUARD: the ring may still hold records of earlier rounds or registrations */
+  if ((int32_t)(record->sequence - *sequence) <= 0) {
+    return;
+  }
+
+  *sequence = record->sequence;
+
+  logger_recorder_dump_record(dump, record);
+}
+
+
+/***************************************************************************//**
+ * \brief  Write flight recorder contents to a file descriptor.
  *
- * \param[in]     function  User provided output function.
+ * Only uses async signal safe functions, so it may be called from a signal
+ * handler. The oldest records follow the cursor, the ring is read from there
+ * to its end and from its start up to the cursor. Records being written by
+ * other threads don't pass their check and are skipped.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     fd      File descriptor to write to.
  ******************************************************************************/
-logger_return_t logger_output_function_deregister(logger_output_function_t function)
+LOGGER_INLINE void logger_recorder_dump(int fd)
 {
-  logger_return_t ret = LOGGER_OK;
+  logger_recorder_dump_t dump;
+  size_t                 head     = (size_t)(LOGGER_ATOMIC_LOAD(&logger_recorder.cursor) >> 32);
+  uint32_t               sequence = logger_recorder.first;
+  size_t                 position;
 
-  /* delete function from global outputs */
-  ret = logger_output_common_deregister(logger_outputs,
-                                        LOGGER_ELEMENTS(logger_outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function);
+  dump.fd   = fd;
+  dump.used = 0;
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+  for (position = logger_recorder_scan(logger_recorder.buffer, logger_recorder.size, head) ;
+       position < logger_recorder.size ;
+       position = logger_recorder_scan(logger_recorder.buffer, logger_recorder.size, position + ((const logger_recorder_record_t *)&logger_recorder.buffer[position])->size)) {
+    logger_recorder_dump_newer(&dump, (const logger_recorder_record_t *)&logger_recorder.buffer[position], &sequence);
+  }
 
-  return(ret);
+  for (position = logger_recorder_scan(logger_recorder.buffer, head, 0) ;
+       position < head ;
+       position = logger_recorder_scan(logger_recorder.buffer, head, position + ((const logger_recorder_record_t *)&logger_recorder.buffer[position])->size)) {
+    logger_recorder_dump_newer(&dump, (const logger_recorder_record_t *)&logger_recorder.buffer[position], &sequence);
+  }
+
+  logger_recorder_dump_flush(&dump);
 }
 
 
 /***************************************************************************//**
- * \brief  Search a global output function in a list of global outputs.
- *
- * The given file function is searched in the list of global outputs.
+ * \brief  Signal handler dumping the flight recorder.
  *
- * \param[in]     function  User provided output function.
+ * The handler is installed with \c SA_RESETHAND, raising the signal again
+ * runs the default action afterwards.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \param[in]     signal  Received signal.
  ******************************************************************************/
-logger_bool_t logger_output_function_is_registered(logger_output_function_t function)
+static void logger_recorder_crash_handler(int signal)
 {
-  /* search function in global outputs */
-  return(logger_output_common_is_registered(logger_outputs,
-                                            LOGGER_ELEMENTS(logger_outputs),
-                                            LOGGER_OUTPUT_TYPE_FUNCTION,
-                                            (FILE *)NULL,
-                                            function));
+  logger_recorder_dump_t dump;
+  int                    fd = STDERR_FILENO;
+
+  if (logger_recorder.crash_path[0] != '\0') {
+    fd = open(logger_recorder.crash_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  }
+
+  if (fd >= 0) {
+    dump.fd   = fd;
+    dump.used = 0;
+    logger_recorder_dump_string(&dump, LOGGER_RECORDER_CRASH_MESSAGE, strlen(LOGGER_RECORDER_CRASH_MESSAGE));
+    logger_recorder_dump_number(&dump, (uint64_t)signal);
+    logger_recorder_dump_string(&dump, "\n", 1);
+    logger_recorder_dump_flush(&dump);
+
+    logger_recorder_dump(fd);
+
+    if (fd != STDERR_FILENO) {
+      (void)close(fd);
+    }
+  }
+
+  (void)raise(signal);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level for global output function.
+ * \brief  Format log message.
  *
- * Set the minimum logging level for given output function. Only for log
- * messages equal or above the given level the function will be called.
+ * Print message into provides memory.
  *
- * \param[in]     function  User provided output function.
- * \param[in]     level     Level to set.
+ * \param[out]    message       Formatted message.
+ * \param[in]     message_size  String length of formatted message.
+ * \param[out]    append        Message has no '\n' and is continued by the next
+ *                              message.
+ * \param[in]     format        \c printf() like format string.
+ * \param[in]     argp          Argument list.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c LOGGER_OK if no error occurred, \c LOGGER_ERR_STRING_TOO_LONG
+ *                if the message was shortened.
  ******************************************************************************/
-logger_return_t logger_output_function_level_set(logger_output_function_t function,
-                                                 const logger_level_t     level)
+LOGGER_INLINE logger_return_t logger_format_message(char          *message,
+                                                    uint16_t      message_size,
+                                                    logger_bool_t *append,
+                                                    const char    *format,
+                                                    va_list       argp)
 {
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0 &&
-      (level & (level - 1)) == 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  logger_return_t ret        = LOGGER_OK;
+  int16_t         characters = 0;
+  size_t          rev_idx;
+  char            *message_end;
+
+  /* format message */
+  characters = vsnprintf(message, message_size, format, argp);
+
+  /* set rev_idx to the last valid character in string */
+  rev_idx = message_size - 1;
+
+  /* make sure message is '\0' terminated */
+  message[rev_idx--] = '\0';
+
+  /* check if there was enough space in storage */
+  if ((characters < 0) || (characters >= message_size)) {
+    if (strrchr(format, '\n') != NULL) {
+      message[rev_idx--] = '\n';
+    }
+    message[rev_idx--] = ' ';
+    message[rev_idx--] = '.';
+    message[rev_idx--] = '.';
+    message[rev_idx--] = '.';
+
+    ret = LOGGER_ERR_STRING_TOO_LONG;
+  }
+
+  /* check for multi line message */
+  message_end = strrchr(message, '\n');
+
+  if (message_end != NULL) {
+    /* '\n' -> will not be continued */
+    *append = logger_false;
+
+    /* remove '\n', needed for correct color display (see below) */
+    *message_end = '\0';
+  }
+  else {
+    /* no '\n' -> will be continued */
+    *append = logger_true;
   }
 
-  /* set function output level from global outputs */
-  return(logger_output_common_level_set(logger_outputs,
-                                        LOGGER_ELEMENTS(logger_outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function,
-                                        LOGGER_ALL ^ (level - 1)));
+  return(ret);
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level for global output function.
+ * \brief  Format binary record.
  *
- * Query the currently set minimum level for the given logging output function.
+ * Print a message as a flight recorder record which can be read back by
+ * \c logger_output_recorder_recover(). Strings which don't fit are shortened.
  *
- * \param[in]     function  User provided output function.
+ * \param[out]    line       Formatted record.
+ * \param[in]     line_size  Size of formatted record.
+ * \param[in]     id         ID outputting this message.
+ * \param[in]     level      Level of this message.
+ * \param[in]     origin     Origin of message, NULL for messages of the logger
+ *                           itself.
+ * \param[in]     message    Formatted message.
  *
- * \return        Currently set logging level.
+ * \return     Size of formatted record.
  ******************************************************************************/
-logger_level_t logger_output_function_level_get(logger_output_function_t function)
+LOGGER_INLINE size_t logger_binary_format(char                  *line,
+                                          size_t                line_size,
+                                          logger_id_t           id,
+                                          logger_level_t        level,
+                                          const logger_origin_t *origin,
+                                          const char            *message)
 {
-  logger_level_t level;
+  const char               *strings[LOGGER_RECORDER_STRINGS];
+  logger_recorder_record_t record;
+  size_t                   size;
 
-  /* get function output level to global outputs */
-  level = logger_output_common_level_get(logger_outputs,
-                                         LOGGER_ELEMENTS(logger_outputs),
-                                         LOGGER_OUTPUT_TYPE_FUNCTION,
-                                         (FILE *)NULL,
-                                         function);
+  /* GUARD: lines too short for header and padding */
+  if (line_size < sizeof(record) + LOGGER_RECORDER_ALIGNMENT + LOGGER_RECORDER_STRINGS) {
+    return(0);
+  }
 
-  /* return only lowest set bit */
-  return(LOGGER_ALL ^ (level - 1));
+  strings[0] = logger_control[id].name;
+  strings[1] = ((origin != NULL) && (origin->file != NULL)) ? logger_strip_path(origin->file) : "";
+  strings[2] = ((origin != NULL) && (origin->function != NULL)) ? origin->function : "";
+  strings[3] = message;
+
+  size = logger_recorder_record_init(&record, strings, line_size - sizeof(record) - (LOGGER_RECORDER_ALIGNMENT - 1), level, (origin != NULL) ? origin->line : 0);
+  record.sequence = LOGGER_COUNTER_NEXT(&logger_binary_sequence);
+
+  /* padding is part of the record */
+  (void)memset(line, 0, size);
+  logger_recorder_record_write((uint8_t *)line + sizeof(record), &record, strings);
+  (void)memcpy(line, &record, sizeof(record));
+
+  return(size);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level mask for global output function.
+ * \brief  Write a line to a file stream output.
  *
- * Set a logging level mask for given output function. Only for log messages
- * with a level set in the given level mask the function will be called.
- *
- * \param[in]     function  User provided output function.
- * \param[in]     level     Level mask to set.
+ * Managed files may rotate first. Lines not written completely are counted as
+ * errors of the output.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     context  Registered output.
+ * \param[in]     record   Message of line.
+ * \param[in]     line     Line to write.
+ * \param[in]     length   Length of line.
  ******************************************************************************/
-logger_return_t logger_output_function_level_mask_set(logger_output_function_t function,
-                                                      const logger_level_t     level)
+static void logger_output_stream_write(void                  *context,
+                                       const logger_record_t *record LOGGER_UNUSED,
+                                       const char            *line,
+                                       size_t                length)
 {
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  const logger_output_t *output = (const logger_output_t *)context;
+  size_t                written;
+
+  if (output->file != NULL) {
+    written = logger_file_write(output->file, line, length, (output->format == LOGGER_OUTPUT_FORMAT_BINARY) ? logger_true : logger_false);
+  }
+  else {
+    written = fwrite(line, 1, length, output->stream);
   }
 
-  /* set function output level to global outputs */
-  return(logger_output_common_level_set(logger_outputs,
-                                        LOGGER_ELEMENTS(logger_outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function,
-                                        level));
+  if (written < length) {
+    LOGGER_COUNTER_ADD(&output->counters->errors, 1);
+  }
+
+#ifdef LOGGER_FORCE_FLUSH
+  (void)fflush(output->stream);
+#endif  /* LOGGER_FORCE_FLUSH */
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level mask for global output function.
- *
- * Query the currently set level mask for the given logging output function.
+ * \brief  Flush a file stream output.
  *
- * \param[in]     function  User provided output function.
+ * Managed files finish a queued rotation first.
  *
- * \return        Currently set logging level mask.
+ * \param[in]     context  Registered output.
  ******************************************************************************/
-logger_level_t logger_output_function_level_mask_get(logger_output_function_t function)
+static void logger_output_stream_flush(void *context)
 {
-  logger_level_t level;
+  const logger_output_t *output = (const logger_output_t *)context;
 
-  /* get function output level from global outputs */
-  level = logger_output_common_level_get(logger_outputs,
-                                         LOGGER_ELEMENTS(logger_outputs),
-                                         LOGGER_OUTPUT_TYPE_FUNCTION,
-                                         (FILE *)NULL,
-                                         function);
+  if (output->file != NULL) {
+    logger_compress_rotate_wait(output->file);
+  }
 
-  return(level);
+  (void)fflush(output->stream);
 }
 
 
 /***************************************************************************//**
- * \brief  Enable the global output function color setting.
- *
- * Enable the color setting for a given output function.
+ * \brief  Write a line to a user function output.
  *
- * \param[in]     function  User provided output function.
+ * \param[in]     context  Registered output.
+ * \param[in]     record   Message of line.
+ * \param[in]     line     Line to write.
+ * \param[in]     length   Length of line.
+ ******************************************************************************/
+static void logger_output_function_write(void                  *context,
+                                         const logger_record_t *record LOGGER_UNUSED,
+                                         const char            *line,
+                                         size_t                length LOGGER_UNUSED)
+{
+  (*((const logger_output_t *)context)->function)(line);
+}
+
+
+/***************************************************************************//**
+ * \brief  Pass a message to a user record function output.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     context  Registered output.
+ * \param[in]     record   Message.
+ * \param[in]     line     Empty line.
+ * \param[in]     length   Length of empty line.
  ******************************************************************************/
-logger_return_t logger_output_function_color_enable(logger_output_function_t function)
+static void logger_output_record_write(void                  *context,
+                                       const logger_record_t *record,
+                                       const char            *line LOGGER_UNUSED,
+                                       size_t                length LOGGER_UNUSED)
 {
-  /* set function output level to global outputs */
-  return(logger_output_common_color(logger_outputs,
-                                    LOGGER_ELEMENTS(logger_outputs),
-                                    LOGGER_OUTPUT_TYPE_FUNCTION,
-                                    (FILE *)NULL,
-                                    function,
-                                    logger_true));
+  (*((const logger_output_t *)context)->record_function)(record);
 }
 
 
 /***************************************************************************//**
- * \brief  Enable the global output function color setting.
+ * \brief  Get the encoding of a message for an output.
  *
- * Enable the color setting for a given output function.
+ * Outputs with the same encoding get the same line, so it is rendered only
+ * once per message.
  *
- * \param[in]     function  User provided output function.
+ * \param[in]     output  Logger output.
+ * \param[in]     kv      Structured message, NULL for other messages.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return     Index of encoding below \c LOGGER_OUTPUT_ENCODINGS.
  ******************************************************************************/
-logger_return_t logger_output_function_color_disable(logger_output_function_t function)
+LOGGER_INLINE size_t logger_output_encoding(const logger_output_t  *output,
+                                            const logger_kv_list_t *kv)
 {
-  /* set function output level to global outputs */
-  return(logger_output_common_color(logger_outputs,
-                                    LOGGER_ELEMENTS(logger_outputs),
-                                    LOGGER_OUTPUT_TYPE_FUNCTION,
-                                    (FILE *)NULL,
-                                    function,
-                                    logger_false));
+  size_t kv_format = 0;
+
+  if (output->format == LOGGER_OUTPUT_FORMAT_JSON) {
+    return(0);
+  }
+
+  if (output->format == LOGGER_OUTPUT_FORMAT_BINARY) {
+    return(1);
+  }
+
+  if (output->format == LOGGER_OUTPUT_FORMAT_RECORD) {
+    return(2);
+  }
+
+  /* rendering of structured messages only matters for those */
+  if (kv != NULL) {
+    kv_format = (size_t)output->kv_format;
+  }
+
+  return(3 + 2 * kv_format + ((output->use_color == logger_true) ? 1 : 0));
 }
 
 
 /***************************************************************************//**
- * \brief  Query the global output function color setting.
- *
- * Query the color setting for a given output function.
+ * \brief  Add a string to the parts of a text line.
  *
- * \param[in]     function  User provided output function.
+ * \param[out]    parts   Parts of line.
+ * \param[in]     count   Number of parts so far.
+ * \param[in]     string  String to add, empty strings are left out.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \return     Number of parts.
  ******************************************************************************/
-logger_bool_t logger_output_function_color_is_enabled(logger_output_function_t function)
+LOGGER_INLINE size_t logger_text_part(logger_iovec_t *parts,
+                                      size_t         count,
+                                      const char     *string)
 {
-  /* check if color for this function is enabled */
-  return(logger_output_common_color_is_enabled(logger_outputs,
-                                               LOGGER_ELEMENTS(logger_outputs),
-                                               LOGGER_OUTPUT_TYPE_FUNCTION,
-                                               (FILE *)NULL,
-                                               function));
+  size_t length = strlen(string);
+
+  if (length > 0) {
+    parts[count].base   = string;
+    parts[count].length = length;
+    count++;
+  }
+
+  return(count);
 }
 
 
 /***************************************************************************//**
- * \brief  Request a logging ID.
+ * \brief  Split text line into parts.
  *
- * Request a ID for later use with calls to \c logger(). If an ID with the same
- * symbolic name has already been requested that ID is returned otherwise a new
- * ID is allocated. Each logging ID is disabled by default.
+ * Prefix and message surrounded by the color strings of the ID and level if
+ * colors are used. Continued messages get neither '\n' nor color reset.
  *
- * \param[in]     name    Symbolic name for the ID.
+ * \param[out]    parts      Parts of line, at least \c LOGGER_TEXT_PARTS_MAX.
+ * \param[in]     id         ID outputting this message.
+ * \param[in]     plan       Output plan of the ID.
+ * \param[in]     level      Level of this message.
+ * \param[in]     use_color  Use color strings.
+ * \param[in]     append     Message is continued by the next message.
+ * \param[in]     prefix     Formatted message prefix.
+ * \param[in]     message    Formatted message.
  *
- * \return        ID number if ID is available, error code otherwise.
+ * \return     Number of parts.
  ******************************************************************************/
-logger_id_t logger_id_request(const char *name)
+LOGGER_INLINE size_t logger_text_parts(logger_iovec_t      *parts,
+                                       logger_id_t         id,
+                                       const logger_plan_t *plan,
+                                       logger_level_t      level,
+                                       logger_bool_t       use_color,
+                                       logger_bool_t       append,
+                                       const char          *prefix,
+                                       const char          *message)
 {
-  logger_id_t   id = logger_id_unknown;
-  size_t        index;
-  logger_bool_t found;
+  logger_bool_t               prefix_color_print_begin;
+  logger_bool_t               prefix_color_print_end;
+  const logger_color_string_t *prefix_color;
+  logger_bool_t               message_color_print_begin;
+  logger_bool_t               message_color_print_end;
+  const logger_color_string_t *message_color;
+  size_t                      count = 0;
+
+  /* set colors */
+  if (use_color == logger_true) {
+    /* message color */
+    if ((plan->color_prefix == logger_false) &&
+        (plan->color_message == logger_false)) {
+      prefix_color_print_begin  = logger_false;
+      prefix_color_print_end    = logger_false;
+
+      message_color_print_begin = logger_false;
+      message_color_print_end   = logger_false;
+    }
+    else {
+      if ((plan->color_prefix == logger_true) &&
+          (plan->color_message == logger_false)) {
+        prefix_color_print_begin = logger_true;
+        prefix_color_print_end   = logger_true;
+        prefix_color             = &plan->level_colors[logger_level_to_index(level)];
 
-  /* GUARD: check for valid name */
-  if (name == NULL) {
-    return(logger_id_unknown);
-  }
+        message_color_print_begin = logger_false;
+        message_color_print_end   = logger_false;
+      }
+      else {
+        if ((plan->color_prefix == logger_false) &&
+            (plan->color_message == logger_true)) {
+          prefix_color_print_begin = logger_true;
+          prefix_color_print_end   = logger_false;
+          prefix_color             = &plan->color_string;
 
-  /* start search */
-  found = logger_false;
+          message_color_print_begin = logger_false;
+          message_color_print_end   = logger_true;
+          message_color             = &plan->color_string;
+        }
+        else {
+          if ((plan->color_prefix == logger_true) &&
+              (plan->color_message == logger_true)) {
+            prefix_color_print_begin = logger_true;
+            prefix_color_print_end   = logger_true;
+            prefix_color             = &plan->level_colors[logger_level_to_index(level)];
 
-  /* search for an already existing ID with the same name */
-  for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
-    if (logger_control[index].used == logger_true) {
-      if (strncmp(logger_control[index].name, name, LOGGER_ELEMENTS(logger_control[index].name)) == 0) {
-        logger_control[index].count++;
-        found = logger_true;
-        break;
+            message_color_print_begin = logger_true;
+            message_color_print_end   = logger_true;
+            message_color             = &plan->color_string;
+          }
+          else {
+            prefix_color_print_begin = logger_false;
+            prefix_color_print_end   = logger_false;
+
+            message_color_print_begin = logger_false;
+            message_color_print_end   = logger_false;
+          }
+        }
       }
     }
-  }
-
-  /* search for an available ID */
-  if (found == logger_false) {
-    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control) ; index++) {
-      if (logger_control[index].used == logger_false) {
-        found = logger_true;
-        /* reset the ID */
-        (void)memset(&logger_control[index], 0, sizeof(logger_control[index]));
 
-        /* initialize the ID */
-        logger_control[index].used                  = logger_true;
-        logger_control[index].count                 = 1;
-        logger_control[index].enabled               = logger_false;
-        logger_control[index].level                 = LOGGER_UNKNOWN;
-        logger_control[index].prefix                = LOGGER_PFX_UNSET;
-        logger_control[index].color                 = logger_false;
-        logger_control[index].color_string.begin[0] = '\0';
-        logger_control[index].color_string.end[0]   = '\0';
-        logger_control[index].color_string_changed  = logger_false;
+    /* modify color printing for continued messages if color setting had not been changed since the last call */
+    if (LOGGER_ATOMIC_LOAD(&logger_control[id].color_string_changed) == logger_false) {
+      if (append == logger_true &&
+          prefix[0] != '\0') {
+        /* first message in a continued message */
+        /* prefix_color_print_begin unchanged */
+        /* prefix_color_print_end unchanged */
 
-        /* copy the name */
-        (void)strncpy(logger_control[index].name, name, LOGGER_ELEMENTS(logger_control[index].name));
-        logger_control[index].name[LOGGER_ELEMENTS(logger_control[index].name) - 1] = '\0';
+        /* message_color_print_begin unchanged */
+        message_color_print_end   = logger_false;
+      }
+      else {
+        if (append == logger_true &&
+            prefix[0] == '\0') {
+          /* inner message in a continued message */
+          prefix_color_print_begin = logger_false;
+          prefix_color_print_end   = logger_false;
 
-        /* update unified output lists of each ID */
-        (void)logger_output_common_unify();
+          message_color_print_begin = logger_false;
+          message_color_print_end   = logger_false;
+        }
+        else {
+          if (append == logger_false &&
+              prefix[0] == '\0') {
+            /* last message in a continued message */
+            prefix_color_print_begin = logger_false;
+            prefix_color_print_end   = logger_false;
 
-        break;
+            message_color_print_begin = logger_false;
+            /* message_color_print_end unchanged */
+          }
+          else {
+          }
+        }
       }
     }
   }
-
-  /* found an empty slot */
-  if (found == logger_true) {
-    id = (logger_id_t)index;
-  }
   else {
-    id = logger_id_unknown;
-  }
-
-  return(id);
-}
+    prefix_color_print_begin = logger_false;
+    prefix_color_print_end   = logger_false;
 
-
-/***************************************************************************//**
- * \brief  Release a logging ID.
- *
- * Release a ID. After this call logging to this ID is not possible anymore.
- *
- * \param[in]     id      Logger ID.
- *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
- ******************************************************************************/
-logger_return_t logger_id_release(const logger_id_t id)
-{
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+    message_color_print_begin = logger_false;
+    message_color_print_end   = logger_false;
   }
 
-  logger_control[id].count--;
+  if (prefix_color_print_begin == logger_true) {
+    count = logger_text_part(parts, count, prefix_color->begin);
+  }
 
-  /* if this was the last ID */
-  if (logger_control[id].count <= 0) {
-    /* outputs will change, print repeat message */
-    logger_repeat_message();
+  count = logger_text_part(parts, count, prefix);
 
-    /* outputs will change, print rate limit message */
-    logger_rate_limit_message(logger_true);
+  if (prefix_color_print_end == logger_true) {
+    count = logger_text_part(parts, count, prefix_color->end);
+  }
 
-    /* reset the ID */
-    (void)memset(&logger_control[id], 0, sizeof(logger_control[id]));
+  if (message_color_print_begin == logger_true) {
+    count = logger_text_part(parts, count, message_color->begin);
+  }
 
-    /* reset all ID dependent values to defaults */
-    logger_control[id].used                  = logger_false;
-    logger_control[id].count                 = 0;
-    logger_control[id].enabled               = logger_false;
-    logger_control[id].level                 = LOGGER_UNKNOWN;
-    logger_control[id].prefix                = LOGGER_PFX_UNSET;
-    logger_control[id].color                 = logger_false;
-    logger_control[id].color_string.begin[0] = '\0';
-    logger_control[id].color_string.end[0]   = '\0';
-    logger_control[id].color_string_changed  = logger_false;
-    logger_control[id].name[0]               = '\0';
+  count = logger_text_part(parts, count, message);
 
-    /* reset outputs */
-    (void)memset(logger_control[id].outputs, 0, sizeof(logger_control[id].outputs));
+  if (message_color_print_end == logger_true) {
+    count = logger_text_part(parts, count, message_color->end);
+  }
+
+  /* print '\n' if needed. color reset needs to be printed before '\n', otherwise some terminals show wrong colors in next line */
+  if (append == logger_false) {
+    count = logger_text_part(parts, count, "\n");
   }
 
-  return(LOGGER_OK);
+  return(count);
 }
 
 
 /***************************************************************************//**
- * \brief  Enable a logging ID for output.
+ * \brief  Format text line.
  *
- * Enable given logging ID for all outputs.
+ * Join the parts of a text line, parts which don't fit are cut.
  *
- * \param[in]     id      Logger ID.
+ * \param[out]    line       Formatted line.
+ * \param[in]     line_size  Size of formatted line.
+ * \param[in]     parts      Parts of line.
+ * \param[in]     count      Number of parts.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return     Length of formatted line.
  ******************************************************************************/
-logger_return_t logger_id_enable(const logger_id_t id)
+LOGGER_INLINE size_t logger_text_format(char                 *line,
+                                        size_t               line_size,
+                                        const logger_iovec_t *parts,
+                                        size_t               count)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  size_t length = 0;
+  size_t part_length;
+  size_t index;
+
+  for (index = 0 ; index < count ; index++) {
+    part_length = LOGGER_NUMERIC_MIN(parts[index].length, line_size - 1 - length);
+    (void)memcpy(&line[length], parts[index].base, part_length);
+    length += part_length;
   }
 
-  /* enable given ID */
-  logger_control[id].enabled = logger_true;
+  /* make sure line is '\0' terminated */
+  line[length] = '\0';
 
-  return(LOGGER_OK);
+  return(length);
 }
 
 
 /***************************************************************************//**
- * \brief  Disable a logger ID for output.
+ * \brief  Output log messages to streams
  *
- * Disable given logging ID for all outputs.
+ * Print the log message to all outputs registered. It is possible to do
+ * repeated prints to the same line by omitting '\n' in the log message format
+ * sting. In this case a subsequent call will be appended without prefix. Each
+ * distinct encoding of the message is rendered only once, no matter how many
+ * outputs use it. Only print the message if
  *
- * \param[in]     id      Logger ID.
+ *   - logging is globally enabled.
+ *   - logging ID is enabled.
+ *   - logging level is enabled.
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     plan      Output plan of the ID.
+ * \param[in]     append    Message is continued by the next message.
+ * \param[in]     origin    Origin of message used by JSON lines, NULL for
+ *                          messages of the logger itself.
+ * \param[in]     prefix    Formatted message prefix.
+ * \param[in]     message   Formatted message.
+ * \param[in,out] kv        Structured message rendered differently per
+ *                          output, NULL for other messages.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_disable(const logger_id_t id)
+LOGGER_INLINE logger_return_t logger_output(logger_id_t           id,
+                                            logger_level_t        level,
+                                            const logger_plan_t   *plan,
+                                            logger_bool_t         append,
+                                            const logger_origin_t *origin,
+                                            const char            *prefix,
+                                            const char            *message,
+                                            logger_kv_list_t      *kv)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+  logger_bool_t         rendered[LOGGER_OUTPUT_ENCODINGS];
+  logger_iovec_t        parts[LOGGER_TEXT_PARTS_MAX];
+  logger_record_t       record;
+  logger_bool_t         record_set = logger_false;
+  logger_encoding_t     *line;
+  const logger_output_t *output;
+  size_t                encoding;
+  size_t                count;
+  size_t                part;
+  size_t                index;
+  size_t                length;
+  uint64_t              start;
 
-  /* outputs will change, print repeat message */
-  logger_repeat_message();
+  for (encoding = 0 ; encoding < LOGGER_ELEMENTS(rendered) ; encoding++) {
+    rendered[encoding] = logger_false;
+  }
 
-  /* outputs will change, print rate limit message */
-  logger_rate_limit_message(logger_true);
+  /* loop over all possible outputs */
+  for (index = 0 ; index < LOGGER_ELEMENTS(plan->outputs) ; index++) {
+    output = &plan->outputs[index];
+
+    if ((output->count > 0) &&
+        ((output->level & level) != 0)) {
+      /* the record is the same for every output */
+      if (record_set == logger_false) {
+        record_set            = logger_true;
+        record.id             = id;
+        record.level          = level;
+        record.time           = (origin != NULL) ? origin->time : (int64_t)time(NULL);
+        record.file           = (origin != NULL) ? origin->file : NULL;
+        record.function       = (origin != NULL) ? origin->function : NULL;
+        record.line           = (origin != NULL) ? origin->line : 0;
+        record.message        = message;
+        record.message_length = strlen(message);
+      }
 
-  /* disable given ID */
-  logger_control[id].enabled = logger_false;
+      if ((output->format == LOGGER_OUTPUT_FORMAT_TEXT) &&
+          (output->driver->writev != NULL)) {
+        /* drivers taking parts get text without copying it together */
+        count = logger_text_parts(parts, id, plan, level, output->use_color, append, prefix,
+                                  ((kv != NULL) && (output->kv_format != LOGGER_KV_FORMAT_TEXT)) ? logger_kv_rendered(kv, output->kv_format) : message);
+        start = logger_latency_now();
+        output->driver->writev(output->context, &record, parts, count);
+        logger_latency_record(output->latency, start);
+
+        length = 0;
+        for (part = 0 ; part < count ; part++) {
+          length += parts[part].length;
+        }
+      }
+      else {
+        encoding = logger_output_encoding(output, kv);
+        line     = &logger_encodings[encoding];
 
-  return(LOGGER_OK);
-}
+        /* render each encoding only once, outputs sharing it reuse the line */
+        if (rendered[encoding] == logger_false) {
+          rendered[encoding] = logger_true;
 
+          switch (output->format) {
+            case LOGGER_OUTPUT_FORMAT_JSON:
+              /* JSON lines use neither prefix nor colors */
+              line->length = logger_json_format(line->line, sizeof(line->line), id, level, origin, message, kv);
+              break;
 
-/***************************************************************************//**
- * \brief  Query the current enable state of ID.
- *
- * Query the current enable state of given logging ID.
- *
- * \param[in]     id      Logger ID.
- *
- * \return        \c logger_true if id is enabled, \c logger_false otherwise.
- ******************************************************************************/
-logger_bool_t logger_id_is_enabled(const logger_id_t id)
-{
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+            case LOGGER_OUTPUT_FORMAT_BINARY:
+              line->length = logger_binary_format(line->line, sizeof(line->line), id, level, origin, message);
+              break;
 
-  /* ID enable state */
-  return(logger_control[id].enabled);
-}
+            case LOGGER_OUTPUT_FORMAT_RECORD:
+              /* the record is all these outputs need */
+              line->length  = 0;
+              line->line[0] = '\0';
+              break;
 
+            default:
+              /* structured messages are rendered as the output wants them */
+              count        = logger_text_parts(parts, id, plan, level, output->use_color, append, prefix,
+                                               ((kv != NULL) && (output->kv_format != LOGGER_KV_FORMAT_TEXT)) ? logger_kv_rendered(kv, output->kv_format) : message);
+              line->length = logger_text_format(line->line, sizeof(line->line), parts, count);
+              break;
+          }
+        }
 
-/***************************************************************************//**
- * \brief  Query if a given level for a given ID would generate any output
- *
- * Query if a call to logger() for the given ID and level would generate any
- * output. This is useful to to avoid expensive calculations when subsequent
- * calls to logger() would never output the results.
- *
- * \param[in]     id      Logger ID.
- * \param[in]     level   Level.
- *
- * \return        \c logger_true if output would be generated, \c logger_false otherwise.
- ******************************************************************************/
-logger_bool_t logger_id_generates_output(const logger_id_t    id,
-                                         const logger_level_t level)
-{
-  logger_bool_t generates_output = logger_false;
-  size_t        index;
+        start = logger_latency_now();
+        output->driver->write(output->context, &record, line->line, line->length);
+        logger_latency_record(output->latency, start);
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(logger_false);
-  }
+        length = line->length;
+      }
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(logger_false);
-  }
+      LOGGER_COUNTER_ADD(&output->counters->lines, 1);
+      LOGGER_COUNTER_ADD(&output->counters->bytes, length);
 
-  /* check if ID is enabled and level is enabled */
-  if ((logger_enabled == logger_true) &&
-      (logger_control[id].enabled == logger_true) &&
-      ((logger_control[id].level & level) != 0)) {
-    /* loop over all possible outputs */
-    for (index = 0 ; index < LOGGER_ELEMENTS(logger_control[id].unified_outputs) ; index++) {
-      /* heck if output is enabled and level is enabled */
-      if ((logger_control[id].unified_outputs[index].count > 0) &&
-          ((logger_control[id].unified_outputs[index].level & level) != 0)) {
-        generates_output = logger_true;
-        break;
+      if (logger_profile_current != NULL) {
+        LOGGER_COUNTER_ADD(&logger_profile_current->bytes, length);
       }
+      LOGGER_PROBE5(emit, id, level, output->type, output->context, length);
     }
   }
 
-  return(generates_output);
+  /* reset the color string changed flag */
+  LOGGER_ATOMIC_STORE(&logger_control[id].color_string_changed, logger_false);
+
+  return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level for ID.
+ * \brief  Output log messages to the outputs of an ID
  *
- * Set the minimum logging level for given ID. Only log messages equal or above
- * the given level will be printed to outputs.
+ * Print the log message to the published output plan of the ID, see
+ * \c logger_output(). The plan stays valid until all outputs are written.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     level   Level to set.
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     origin    Origin of message used by JSON lines, NULL for
+ *                          messages of the logger itself.
+ * \param[in]     prefix    Formatted message prefix.
+ * \param[in]     message   Formatted message.
+ * \param[in,out] kv        Structured message rendered differently per
+ *                          output, NULL for other messages.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_level_set(const logger_id_t    id,
-                                    const logger_level_t level)
+LOGGER_INLINE logger_return_t logger_output_id(logger_id_t           id,
+                                               logger_level_t        level,
+                                               const logger_origin_t *origin,
+                                               const char            *prefix,
+                                               const char            *message,
+                                               logger_kv_list_t      *kv)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
-
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0 &&
-      (level & (level - 1)) == 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
-  }
-
-  /* outputs will change, print repeat message */
-  logger_repeat_message();
+  const logger_plan_t *plan;
+  logger_return_t     ret;
 
-  /* outputs will change, print rate limit message */
-  logger_rate_limit_message(logger_true);
+  logger_plan_read_lock();
+  plan  = LOGGER_ATOMIC_LOAD(&logger_control[id].plan);
+  ret   = logger_output(id, level, plan, LOGGER_ATOMIC_LOAD(&logger_control[id].append), origin, prefix, message, kv);
+  logger_plan_read_unlock();
 
-  /* set ID level */
-  logger_control[id].level = LOGGER_ALL ^ (level - 1);
-
-  return(LOGGER_OK);
+  return(ret);
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level for ID.
+ * \brief  Prepare a change of configuration.
  *
- * Query the currently set minimum level for the given logging ID.
- *
- * \param[in]     id      Logger ID.
- *
- * \return        Currently set level.
+ * Print pending repeat and rate limit messages with the outputs in effect
+ * before the change. While configuration is batched this has been done once by
+ * \c logger_config_begin().
  ******************************************************************************/
-logger_level_t logger_id_level_get(const logger_id_t id)
+LOGGER_INLINE void logger_config_change(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_UNKNOWN);
-  }
+  if ((logger_config_depth == 0) &&
+      (logger_print_lock(&logger_repeat_mutex) == logger_true)) {
+    logger_repeat_message();
 
-  /* get ID level, return only lowest set bit */
-  return(LOGGER_ALL ^ (logger_control[id].level - 1));
+    (void)pthread_mutex_lock(&logger_limit_mutex);
+    logger_rate_limit_message(logger_true);
+    (void)pthread_mutex_unlock(&logger_limit_mutex);
+
+    logger_print_unlock(&logger_repeat_mutex);
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level mask for ID.
- *
- * Set a logging level mask for given ID. Only log messages with a level set in
- * the given level mask will be printed to outputs.
- *
- * \param[in]     id      Logger ID.
- * \param[in]     level   Level to set.
+ * \brief  Print repeat message.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * When a message repeats several times the message is only printed once by
+ * logger_implementation_common(). When a different message should be printed
+ * or outputs change this function will print the number of repeats.
  ******************************************************************************/
-logger_return_t logger_id_level_mask_set(const logger_id_t    id,
-                                         const logger_level_t level)
+LOGGER_INLINE void logger_repeat_message(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
-
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
-  }
+  if (logger_repeat.count > 0) {
+    char repeat_prefix[LOGGER_PREFIX_STRING_MAX];
+    char repeat_message[LOGGER_MESSAGE_STRING_MAX];
 
-  /* outputs will change, print repeat message */
-  logger_repeat_message();
+    /* generate an empty prefix */
+    memset(repeat_prefix, ' ', logger_repeat.prefix_length);
+    repeat_prefix[logger_repeat.prefix_length] = '\0';
 
-  /* outputs will change, print rate limit message */
-  logger_rate_limit_message(logger_true);
+    /* generate string that contains number of repeats */
+    if (logger_repeat.count == 1) {
+      (void)snprintf(repeat_message, sizeof(repeat_message), "  -> previous message repeated %" PRIu16 " more time", logger_repeat.count);
+    }
+    else {
+      (void)snprintf(repeat_message, sizeof(repeat_message), "  -> previous message repeated %" PRIu16 " more times", logger_repeat.count);
+    }
 
-  /* set ID level */
-  logger_control[id].level = level;
+    /* output message */
+    (void)logger_output_id(logger_repeat.id, logger_repeat.level, NULL, repeat_prefix, repeat_message, NULL);
 
-  return(LOGGER_OK);
+    /* reset repeat members */
+    logger_repeat.count = 0;
+    logger_repeat.id    = logger_id_unknown;
+    logger_repeat.level = LOGGER_UNKNOWN;
+    logger_repeat.generation++;
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level for ID.
- *
- * Query the currently set minimum level for the given logging ID.
+ * \brief  Hash a formatted message.
  *
- * \param[in]     id      Logger ID.
+ * \param[in]     message Formatted message.
  *
- * \return        Currently set level.
+ * \return        FNV-1a hash of message.
  ******************************************************************************/
-logger_level_t logger_id_level_mask_get(const logger_id_t id)
+LOGGER_INLINE uint32_t logger_fingerprint_hash(const char *message)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_UNKNOWN);
+  uint32_t hash = 2166136261U;
+
+  while (*message != '\0') {
+    hash ^= (uint8_t)*message++;
+    hash *= 16777619U;
   }
 
-  return(logger_control[id].level);
+  return(hash);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging prefix for ID.
- *
- * Set the prefix for given ID. All messages for this ID will get this prefix
- * from now on.
+ * \brief  Print number of suppressed repeats of a fingerprint.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     prefix  Prefix to set.
- *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in,out] fingerprint  Message fingerprint.
  ******************************************************************************/
-logger_return_t logger_id_prefix_set(const logger_id_t     id,
-                                     const logger_prefix_t prefix)
+LOGGER_INLINE void logger_fingerprint_message(logger_fingerprint_t *fingerprint)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+  if (fingerprint->count > 0) {
+    char repeat_prefix[LOGGER_PREFIX_STRING_MAX];
+    char repeat_message[LOGGER_MESSAGE_STRING_MAX];
 
-  /* GUARD: check for valid prefix */
-  if ((prefix < LOGGER_PFX_EMPTY) ||
-      (prefix > LOGGER_PFX_UNSET)) {
-    return(LOGGER_ERR_PREFIX_UNKNOWN);
-  }
+    /* consecutive repeats belong before this message */
+    logger_repeat_message();
+
+    /* generate an empty prefix */
+    memset(repeat_prefix, ' ', fingerprint->prefix_length);
+    repeat_prefix[fingerprint->prefix_length] = '\0';
+
+    /* generate string that contains number of repeats */
+    if (fingerprint->count == 1) {
+      (void)snprintf(repeat_message, sizeof(repeat_message), "  -> message at %s:%" PRIu32 " repeated %" PRIu32 " more time", logger_strip_path(fingerprint->file), fingerprint->line, fingerprint->count);
+    }
+    else {
+      (void)snprintf(repeat_message, sizeof(repeat_message), "  -> message at %s:%" PRIu32 " repeated %" PRIu32 " more times", logger_strip_path(fingerprint->file), fingerprint->line, fingerprint->count);
+    }
 
-  /* set ID prefix */
-  logger_control[id].prefix = prefix;
+    /* output message */
+    (void)logger_output_id(fingerprint->id, fingerprint->level, NULL, repeat_prefix, repeat_message, NULL);
 
-  return(LOGGER_OK);
+    fingerprint->count = 0;
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging prefix for ID.
+ * \brief  Check if a message repeats a recently printed message.
  *
- * Query the currently set prefix for the given logging ID.
+ * A message seen within the repeat window is counted and suppressed. Otherwise
+ * its fingerprint is stored, replacing the oldest one of its slots, and the
+ * message has to be printed. Suppressed repeats of a replaced or expired
+ * fingerprint are printed first.
  *
- * \param[in]     id      Logger ID.
+ * \param[in]     id             ID outputting this message.
+ * \param[in]     level          Level of this message.
+ * \param[in]     file           Name of file where this call happened.
+ * \param[in]     line           Line where this call happened.
+ * \param[in]     message        Formatted message.
+ * \param[in]     prefix_length  Length of formatted prefix.
  *
- * \return        Currently set prefix.
+ * \return        \c logger_true if message is suppressed.
  ******************************************************************************/
-logger_prefix_t logger_id_prefix_get(const logger_id_t id)
+LOGGER_INLINE logger_bool_t logger_fingerprint_check(logger_id_t    id,
+                                                     logger_level_t level,
+                                                     const char     *file,
+                                                     uint32_t       line,
+                                                     const char     *message,
+                                                     size_t         prefix_length)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_PFX_EMPTY);
+  logger_fingerprint_t *fingerprint;
+  logger_fingerprint_t *slot = NULL;
+  uint32_t             hash;
+  uint64_t             now;
+  size_t               index;
+  size_t               probe;
+
+  hash  = logger_fingerprint_hash(message);
+  now   = logger_time_ms();
+  index = (hash ^ line) % LOGGER_ELEMENTS(logger_fingerprints);
+
+  for (probe = 0 ; probe < LOGGER_REPEAT_PROBES ; probe++) {
+    fingerprint = &logger_fingerprints[(index + probe) % LOGGER_ELEMENTS(logger_fingerprints)];
+
+    if ((fingerprint->file != NULL) &&
+        (fingerprint->hash == hash) &&
+        (fingerprint->id == id) &&
+        (fingerprint->level == level) &&
+        (fingerprint->line == line) &&
+        ((fingerprint->file == file) || (strcmp(fingerprint->file, file) == 0))) {
+      if ((now - fingerprint->printed) < logger_repeat_window) {
+        fingerprint->count++;
+        return(logger_true);
+      }
+
+      /* window expired, print the message again */
+      slot = fingerprint;
+      break;
+    }
+
+    /* remember a free or the oldest slot */
+    if ((slot == NULL) ||
+        ((slot->file != NULL) &&
+         ((fingerprint->file == NULL) || (fingerprint->printed < slot->printed)))) {
+      slot = fingerprint;
+    }
   }
 
-  /* get ID prefix */
-  return(logger_control[id].prefix);
+  if (slot->file != NULL) {
+    logger_fingerprint_message(slot);
+  }
+
+  slot->file          = file;
+  slot->line          = line;
+  slot->id            = id;
+  slot->level         = level;
+  slot->hash          = hash;
+  slot->prefix_length = (uint16_t)prefix_length;
+  slot->count         = 0;
+  slot->printed       = now;
+  slot->reported      = now;
+
+  return(logger_false);
 }
 
 
 /***************************************************************************//**
- * \brief  Query name for id.
+ * \brief  Forget fingerprints of an ID.
  *
- * Query the name for the given logging ID.
- *
- * \param[in]     id      Logger ID.
+ * Suppressed repeats are printed first.
  *
- * \return        Symbolic name of the ID.
+ * \param[in]     id      ID whose fingerprints are dropped, \c logger_id_unknown
+ *                        for all IDs.
  ******************************************************************************/
-const char *logger_id_name_get(const logger_id_t id)
+LOGGER_INLINE void logger_fingerprint_drop(logger_id_t id)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(NULL);
-  }
+  size_t index;
 
-  /* get ID name */
-  return(logger_control[id].name);
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_fingerprints) ; index++) {
+    if ((logger_fingerprints[index].file != NULL) &&
+        ((id == logger_id_unknown) || (logger_fingerprints[index].id == id))) {
+      logger_fingerprint_message(&logger_fingerprints[index]);
+      logger_fingerprints[index].file = NULL;
+    }
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Register an id specific output stream.
- *
- * The given file stream may be on of \c stdout, \c stderr or a file stream
- * opened by the user. The default logging level is set to \c LOGGER_UNKNOWN thus
- * no messages will appear on this stream.
- *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Opened file stream.
+ * \brief  Print rate limit message message.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * When a message is not printed because of a rate limit print the number of
+ * skipped messages.
  ******************************************************************************/
-logger_return_t logger_id_output_register(const logger_id_t id,
-                                          FILE              *stream)
+LOGGER_INLINE void logger_rate_limit_message(logger_bool_t force)
 {
-  logger_return_t ret = LOGGER_OK;
+  /* check if message should be printed */
+  if ((logger_limit.message_request == logger_true) ||
+      ((force == logger_true) && (logger_limit.skipped > 0))) {
+    char limit_prefix[LOGGER_PREFIX_STRING_MAX];
+    char limit_message[LOGGER_MESSAGE_STRING_MAX];
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+    /* generate system empty prefix */
+    strncpy(limit_prefix, "LOGGER SYSTEM MESSAGE: ", LOGGER_ELEMENTS(limit_prefix));
 
-  /* add stream to system outputs */
-  (void)logger_output_common_register(logger_control[logger_system_id].outputs,
-                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
-                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                      stream,
-                                      (logger_output_function_t)NULL);
-  (void)logger_output_common_level_set(logger_control[logger_system_id].outputs,
-                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
-                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                      stream,
-                                      (logger_output_function_t)NULL,
-                                      LOGGER_ALL);
+    /* generate string that contains number of repeats */
+    if (logger_limit.skipped == 1) {
+      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " message skipped because of rate limit (%" PRIu16 " messages per second)", logger_limit.skipped, logger_limit.limit);
+    }
+    else {
+      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " messages skipped because of rate limit (%" PRIu16 " messages per second)", logger_limit.skipped, logger_limit.limit);
+    }
 
-  /* add stream to global outputs */
-  ret = logger_output_common_register(logger_control[id].outputs,
-                                      LOGGER_ELEMENTS(logger_control[id].outputs),
-                                      LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                      stream,
-                                      (logger_output_function_t)NULL);
+    /* output message */
+    (void)logger_output_id(logger_system_id, LOGGER_EMERG, NULL, limit_prefix, limit_message, NULL);
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+    /* reset message request */
+    logger_limit.message_request = logger_false;
 
-  return(ret);
+    /* reset skip counter */
+    logger_limit.skipped = 0;
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Deregister an id specific output stream.
- *
- * Remove given file stream from list of outputs.
+ * \brief  Check if rate limit is exceeded.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Previous registered file stream.
+ * Check if rate limit is exceeded and return `logger_true` in that case.
+ * Additionally request a rate limit message.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c logger_true if rate limit is exceeded.
  ******************************************************************************/
-logger_return_t logger_id_output_deregister(const logger_id_t id,
-                                            FILE              *stream)
+LOGGER_INLINE logger_bool_t logger_check_rate_limit(void)
 {
-  logger_return_t ret = LOGGER_OK;
+  static time_t previous_time = 0;
+  time_t        current_time;
+  time_t        diff_time;
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  /* get current time */
+  current_time = time(NULL);
+
+  /* time difference */
+  diff_time = current_time - previous_time;
+
+  /* check if time has changed */
+  if (diff_time != 0) {
+    if (logger_limit.exceeded == logger_true) {
+      /* request message printing */
+      logger_limit.message_request = logger_true;
+
+      /* reset counter */
+      logger_limit.counter = 0;
+    }
+
+    /* update previous time */
+    previous_time = current_time;
   }
 
-  /* delete stream from global outputs */
-  ret = logger_output_common_deregister(logger_control[id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL);
+  /* increment counter */
+  logger_limit.counter++;
 
-  /* delete stream from system outputs */
-  (void)logger_output_common_deregister(logger_control[logger_system_id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL);
+  /* check if limit is exceeded */
+  if ((logger_limit.limit > 0) &&
+      ((logger_limit.counter / (diff_time + 1)) > logger_limit.limit)) {
+    logger_limit.exceeded = logger_true;
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+      /* add number of skipped messages */
+      logger_limit.skipped++;
 
-  return(ret);
+  }
+  else {
+    logger_limit.exceeded = logger_false;
+  }
+
+  return(logger_limit.exceeded);
 }
 
 
 /***************************************************************************//**
- * \brief  Search an output stream in id specific outputs.
- *
- * The given file stream is searched in of id specific outputs.
+ * \brief  Current time for rate limits.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  File stream.
- *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \return        Monotonic time in milliseconds.
  ******************************************************************************/
-logger_bool_t logger_id_output_is_registered(const logger_id_t id,
-                                             FILE              *stream)
+LOGGER_INLINE uint64_t logger_time_ms(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+  struct timespec now;
 
-  /* search stream in id specific outputs */
-  return(logger_output_common_is_registered(logger_control[id].outputs,
-                                            LOGGER_ELEMENTS(logger_control[id].outputs),
-                                            LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                            stream,
-                                            (logger_output_function_t)NULL));
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return((uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level for id specific output stream.
- *
- * Set the minimum logging level for given output stream. Only log messages
- * equal or above the given level will be printed to the given stream.
- *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Previous registered file stream.
- * \param[in]     level   Level to set.
+ * \brief  Current time for latency histograms.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Monotonic time in nanoseconds, 0 if not built with
+ *                \c LOGGER_LATENCY.
  ******************************************************************************/
-logger_return_t logger_id_output_level_set(const logger_id_t    id,
-                                           FILE                 *stream,
-                                           const logger_level_t level)
+LOGGER_INLINE uint64_t logger_latency_now(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+#ifdef LOGGER_LATENCY
+  struct timespec now;
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0 &&
-      (level & (level - 1)) == 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
-  }
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
 
-  /* set stream output level to id specific outputs */
-  return(logger_output_common_level_set(logger_control[id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL,
-                                        LOGGER_ALL ^ (level - 1)));
+  return((uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec);
+#else  /* LOGGER_LATENCY */
+  return(0);
+#endif /* LOGGER_LATENCY */
 }
 
 
+#ifdef LOGGER_LATENCY
 /***************************************************************************//**
- * \brief  Query logging level for id specific output stream.
+ * \brief  Get the bucket of a time in a latency histogram.
  *
- * Query the currently set minimum level for the given logging output stream.
+ * Times below \c LOGGER_HISTOGRAM_SUB_COUNT have a bucket each, each following
+ * power of two is split into \c LOGGER_HISTOGRAM_SUB_COUNT buckets.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Previous registered file stream.
+ * \param[in]     value  Time in nanoseconds.
  *
- * \return        Currently set logging level.
+ * \return        Index of bucket.
  ******************************************************************************/
-logger_level_t logger_id_output_level_get(const logger_id_t id,
-                                          FILE              *stream)
+LOGGER_INLINE size_t logger_histogram_index(uint64_t value)
 {
-  logger_level_t level;
+  size_t shift = 0;
+  size_t index;
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_UNKNOWN);
+  /* short times are exact */
+  if (value < LOGGER_HISTOGRAM_SUB_COUNT) {
+    return((size_t)value);
+  }
+
+  while ((value >> shift) >= (2 * LOGGER_HISTOGRAM_SUB_COUNT)) {
+    shift++;
+  }
+
+  index = (shift + 1) * LOGGER_HISTOGRAM_SUB_COUNT + (size_t)((value >> shift) - LOGGER_HISTOGRAM_SUB_COUNT);
+
+  return((index < LOGGER_HISTOGRAM_BUCKETS) ? index : LOGGER_HISTOGRAM_BUCKETS - 1);
+}
+
+
+/***************************************************************************//**
+ * \brief  Get the highest time of a bucket in a latency histogram.
+ *
+ * \param[in]     index  Index of bucket.
+ *
+ * \return        Time in nanoseconds.
+ ******************************************************************************/
+LOGGER_INLINE uint64_t logger_histogram_value(size_t index)
+{
+  size_t shift;
+
+  if (index < LOGGER_HISTOGRAM_SUB_COUNT) {
+    return((uint64_t)index);
   }
 
-  /* get stream output level from id specific outputs */
-  level = logger_output_common_level_get(logger_control[id].outputs,
-                                         LOGGER_ELEMENTS(logger_control[id].outputs),
-                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                         stream,
-                                         (logger_output_function_t)NULL);
+  shift = index / LOGGER_HISTOGRAM_SUB_COUNT - 1;
 
-  /* return only lowest set bit */
-  return(LOGGER_ALL ^ (level - 1));
+  return((((uint64_t)(LOGGER_HISTOGRAM_SUB_COUNT + index % LOGGER_HISTOGRAM_SUB_COUNT) + 1) << shift) - 1);
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level mask for id specific output stream.
- *
- * Set a logging level mask for given output stream. Only log messages
- * with a level set in the given level mask will be printed to the given stream.
+ * \brief  Get a percentile of a latency histogram.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Previous registered file stream.
- * \param[in]     level   Level mask to set.
+ * \param[in]     histogram  Latency histogram with at least one measurement.
+ * \param[in]     permille   Percentile in thousandths.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Time in nanoseconds.
  ******************************************************************************/
-logger_return_t logger_id_output_level_mask_set(const logger_id_t    id,
-                                                FILE                 *stream,
-                                                const logger_level_t level)
+LOGGER_INLINE uint64_t logger_histogram_percentile(const logger_histogram_t *histogram,
+                                                   uint32_t                 permille)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  uint64_t rank;
+  uint64_t seen = 0;
+  uint64_t value;
+  size_t   index;
+
+  rank = (LOGGER_COUNTER_GET(&histogram->count) * permille + 999) / 1000;
+  if (rank == 0) {
+    rank = 1;
   }
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  for (index = 0 ; index < LOGGER_HISTOGRAM_BUCKETS ; index++) {
+    seen += LOGGER_COUNTER_GET(&histogram->buckets[index]);
+
+    if (seen >= rank) {
+      break;
+    }
   }
 
-  /* set stream output level to id specific outputs */
-  return(logger_output_common_level_set(logger_control[id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                        stream,
-                                        (logger_output_function_t)NULL,
-                                        level));
+  /* the bucket may reach beyond the longest time */
+  value = logger_histogram_value(index);
+
+  return((value < LOGGER_COUNTER_GET(&histogram->max)) ? value : LOGGER_COUNTER_GET(&histogram->max));
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level mask for id specific output stream.
- *
- * Query the currently set level mask for the given logging output stream.
+ * \brief  Summarize a latency histogram.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Previous registered file stream.
- *
- * \return        Currently set logging level mask.
+ * \param[in]     histogram  Latency histogram.
+ * \param[out]    latency    Summary.
  ******************************************************************************/
-logger_level_t logger_id_output_level_mask_get(const logger_id_t id,
-                                               FILE              *stream)
+LOGGER_INLINE void logger_histogram_summary(const logger_histogram_t *histogram,
+                                            logger_latency_t         *latency)
 {
-  logger_level_t level;
+  (void)memset(latency, 0, sizeof(*latency));
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_UNKNOWN);
+  latency->count = LOGGER_COUNTER_GET(&histogram->count);
+
+  if (latency->count > 0) {
+    latency->min   = LOGGER_COUNTER_GET(&histogram->min);
+    latency->mean  = LOGGER_COUNTER_GET(&histogram->total) / latency->count;
+    latency->p50   = logger_histogram_percentile(histogram, 500);
+    latency->p90   = logger_histogram_percentile(histogram, 900);
+    latency->p99   = logger_histogram_percentile(histogram, 990);
+    latency->p999  = logger_histogram_percentile(histogram, 999);
+    latency->max   = LOGGER_COUNTER_GET(&histogram->max);
   }
+}
 
-  /* get stream output level from id specific outputs */
-  level = logger_output_common_level_get(logger_control[id].outputs,
-                                         LOGGER_ELEMENTS(logger_control[id].outputs),
-                                         LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                         stream,
-                                         (logger_output_function_t)NULL);
 
-  return(level);
+/***************************************************************************//**
+ * \brief  Clear a latency histogram.
+ *
+ * \param[out]    histogram  Latency histogram.
+ ******************************************************************************/
+LOGGER_INLINE void logger_histogram_clear(logger_histogram_t *histogram)
+{
+  size_t index;
+
+  LOGGER_COUNTER_SET(&histogram->count, 0);
+  LOGGER_COUNTER_SET(&histogram->total, 0);
+  LOGGER_COUNTER_SET(&histogram->min, 0);
+  LOGGER_COUNTER_SET(&histogram->max, 0);
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(histogram->buckets) ; index++) {
+    LOGGER_COUNTER_SET(&histogram->buckets[index], 0);
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Enable the id specific output stream color setting.
- *
- * Enable the color setting for a given output stream.
+ * \brief  Find the write latency of an output.
  *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Opened file stream.
+ * \param[in]     type             Type of output, \c LOGGER_OUTPUT_TYPE_UNKNOWN
+ *                                 for a free slot.
+ * \param[in]     stream           Opened file stream.
+ * \param[in]     function         User provided output function.
+ * \param[in]     record_function  User provided record function.
+ * \param[in]     driver           Driver writing the lines.
+ * \param[in]     context          Context of driver.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Write latency, \c NULL if not found.
  ******************************************************************************/
-logger_return_t logger_id_output_color_enable(const logger_id_t id,
-                                              FILE              *stream)
+LOGGER_INLINE logger_output_latency_t *logger_latency_find(logger_output_type_t            type,
+                                                           FILE                            *stream,
+                                                           logger_output_function_t        function,
+                                                           logger_output_record_function_t record_function,
+                                                           const logger_output_driver_t    *driver,
+                                                           void                            *context)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  logger_output_latency_t *latency;
+  size_t                  index;
+
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_latency_outputs) ; index++) {
+    latency = &logger_latency_outputs[index];
+
+    if ((latency->type == type) &&
+        ((type == LOGGER_OUTPUT_TYPE_UNKNOWN) ||
+         ((type == LOGGER_OUTPUT_TYPE_FILESTREAM) && (latency->stream == stream)) ||
+         ((type == LOGGER_OUTPUT_TYPE_FUNCTION) && (latency->function == function)) ||
+         ((type == LOGGER_OUTPUT_TYPE_RECORD) && (latency->record_function == record_function)) ||
+         ((type == LOGGER_OUTPUT_TYPE_DRIVER) && (latency->driver == driver) && (latency->context == context)))) {
+      return(latency);
+    }
   }
 
-  /* enable stream output color in id specific outputs */
-  return(logger_output_common_color(logger_control[id].outputs,
-                                    LOGGER_ELEMENTS(logger_control[id].outputs),
-                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                    stream,
-                                    (logger_output_function_t)NULL,
-                                    logger_true));
+  return((logger_output_latency_t *)NULL);
 }
+#endif /* LOGGER_LATENCY */
 
 
 /***************************************************************************//**
- * \brief  Disable the id specific output stream color setting.
- *
- * Disable the color setting for a given output stream.
- *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Opened file stream.
+ * \brief  Add a measured time to a latency histogram.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in,out] histogram  Latency histogram, NULL if not measured.
+ * \param[in]     start      Time the measurement started.
  ******************************************************************************/
-logger_return_t logger_id_output_color_disable(const logger_id_t id,
-                                               FILE              *stream)
+LOGGER_INLINE void logger_latency_record(logger_histogram_t *histogram LOGGER_UNUSED,
+                                         uint64_t           start LOGGER_UNUSED)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+#ifdef LOGGER_LATENCY
+  uint64_t elapsed;
+  uint64_t minimum;
+  uint64_t maximum;
+
+  /* GUARD: output is not measured */
+  if (histogram == NULL) {
+    return;
   }
 
-  /* disable stream output color in id specific outputs */
-  return(logger_output_common_color(logger_control[id].outputs,
-                                    LOGGER_ELEMENTS(logger_control[id].outputs),
-                                    LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                    stream,
-                                    (logger_output_function_t)NULL,
-                                    logger_false));
+  elapsed = logger_latency_now() - start;
+
+  /* calls of all threads share a histogram, 0 is no minimum yet */
+  minimum = LOGGER_COUNTER_GET(&histogram->min);
+  while (((minimum == 0) || (elapsed < minimum)) &&
+         (LOGGER_COUNTER_SWAP(&histogram->min, &minimum, elapsed) == 0)) {
+  }
+
+  maximum = LOGGER_COUNTER_GET(&histogram->max);
+  while ((elapsed > maximum) &&
+         (LOGGER_COUNTER_SWAP(&histogram->max, &maximum, elapsed) == 0)) {
+  }
+
+  LOGGER_COUNTER_ADD(&histogram->count, 1);
+  LOGGER_COUNTER_ADD(&histogram->total, elapsed);
+  LOGGER_COUNTER_ADD(&histogram->buckets[logger_histogram_index(elapsed)], 1);
+#endif /* LOGGER_LATENCY */
 }
 
 
 /***************************************************************************//**
- * \brief  Query the id specific output stream color setting.
- *
- * Query the color setting for a given output stream.
- *
- * \param[in]     id      Logger ID.
- * \param[in]     stream  Opened file stream.
+ * \brief  Add the time of a logger() call to its latency histogram.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \param[in]     start  Time the call started.
  ******************************************************************************/
-logger_bool_t logger_id_output_color_is_enabled(const logger_id_t id,
-                                                FILE              *stream)
+LOGGER_INLINE void logger_latency_call(uint64_t start LOGGER_UNUSED)
 {
-  /* check if color for this stream is enabled */
-  return(logger_output_common_color_is_enabled(logger_control[id].outputs,
-                                               LOGGER_ELEMENTS(logger_control[id].outputs),
-                                               LOGGER_OUTPUT_TYPE_FILESTREAM,
-                                               stream,
-                                               (logger_output_function_t)NULL));
+#ifdef LOGGER_LATENCY
+  logger_latency_record(&logger_latency_calls, start);
+#endif /* LOGGER_LATENCY */
 }
 
 
 /***************************************************************************//**
- * \brief  Register an id specific output stream.
+ * \brief  Get the write latency histogram of an output.
  *
- * The user provided function must take a single string argument. The default
- * logging level is set to \c LOGGER_UNKNOWN thus this function will not be
- * called for any message.
+ * Outputs are measured by what they write to, so ID specific and global
+ * registrations of the same output share a histogram. Histograms are kept
+ * after an output is deregistered, when all \c LOGGER_LATENCY_OUTPUTS_MAX are
+ * used further outputs are not measured.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * \param[in]     output  Registered output.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Latency histogram, \c NULL if not measured.
  ******************************************************************************/
-logger_return_t logger_id_output_function_register(const logger_id_t        id,
-                                                   logger_output_function_t function)
+LOGGER_INLINE logger_histogram_t *logger_latency_output(const logger_output_t *output LOGGER_UNUSED)
 {
-  logger_return_t ret = LOGGER_OK;
+#ifdef LOGGER_LATENCY
+  logger_output_latency_t *latency;
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+  latency = logger_latency_find(output->type, output->stream, output->function, output->record_function, output->driver, output->context);
 
-  /* add function to system outputs */
-  (void)logger_output_common_register(logger_control[logger_system_id].outputs,
-                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
-                                      LOGGER_OUTPUT_TYPE_FUNCTION,
-                                      (FILE *)NULL,
-                                      function);
-  (void)logger_output_common_level_set(logger_control[logger_system_id].outputs,
-                                      LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
-                                      LOGGER_OUTPUT_TYPE_FUNCTION,
-                                      (FILE *)NULL,
-                                      function,
-                                      LOGGER_ALL);
+  if (latency == NULL) {
+    latency = logger_latency_find(LOGGER_OUTPUT_TYPE_UNKNOWN, NULL, NULL, NULL, NULL, NULL);
 
-  /* add function to global outputs */
-  ret = logger_output_common_register(logger_control[id].outputs,
-                                      LOGGER_ELEMENTS(logger_control[id].outputs),
-                                      LOGGER_OUTPUT_TYPE_FUNCTION,
-                                      (FILE *)NULL,
-                                      function);
+    /* GUARD: no free histogram */
+    if (latency == NULL) {
+      return((logger_histogram_t *)NULL);
+    }
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+    latency->type            = output->type;
+    latency->stream          = output->stream;
+    latency->function        = output->function;
+    latency->record_function = output->record_function;
+    latency->driver          = output->driver;
+    latency->context         = output->context;
+  }
 
-  return(ret);
+  return(&latency->histogram);
+#else  /* LOGGER_LATENCY */
+  return((logger_histogram_t *)NULL);
+#endif /* LOGGER_LATENCY */
 }
 
 
 /***************************************************************************//**
- * \brief  Deregister an id specific output function.
- *
- * Remove given file function from list of outputs.
+ * \brief  Query output write latency.
  *
- * \param[in]     id        Logger ID.
+ * \param[in]     type      Type of output.
+ * \param[in]     stream    Opened file stream.
  * \param[in]     function  User provided output function.
+ * \param[in]     driver    Driver writing the lines.
+ * \param[in]     context   Context of driver.
+ * \param[out]    latency   Summary of write latency.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c LOGGER_OK if no error occurred, \c LOGGER_ERR_NOT_SUPPORTED
+ *                if not built with \c LOGGER_LATENCY, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_output_function_deregister(const logger_id_t        id,
-                                                     logger_output_function_t function)
+LOGGER_INLINE logger_return_t logger_output_common_latency_get(logger_output_type_t         type LOGGER_UNUSED,
+                                                               FILE                         *stream LOGGER_UNUSED,
+                                                               logger_output_function_t     function LOGGER_UNUSED,
+                                                               const logger_output_driver_t *driver LOGGER_UNUSED,
+                                                               void                         *context LOGGER_UNUSED,
+                                                               logger_latency_t             *latency)
 {
-  logger_return_t ret = LOGGER_OK;
-
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  /* GUARD: check for valid latency */
+  if (latency == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
   }
 
-  /* delete function from global outputs */
-  ret = logger_output_common_deregister(logger_control[id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function);
+#ifdef LOGGER_LATENCY
+  {
+    const logger_output_latency_t *output;
 
-  /* delete function from system outputs */
-  (void)logger_output_common_deregister(logger_control[logger_system_id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[logger_system_id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function);
+    output = logger_latency_find(type, stream, function, (logger_output_record_function_t)NULL, driver, context);
 
-  /* update unified output lists of each ID */
-  (void)logger_output_common_unify();
+    /* GUARD: output must have been measured */
+    if (output == NULL) {
+      return(LOGGER_ERR_OUTPUT_NOT_FOUND);
+    }
 
-  return(ret);
+    logger_histogram_summary(&output->histogram, latency);
+
+    return(LOGGER_OK);
+  }
+#else  /* LOGGER_LATENCY */
+  return(LOGGER_ERR_NOT_SUPPORTED);
+#endif /* LOGGER_LATENCY */
 }
 
 
 /***************************************************************************//**
- * \brief  Search an output function in id specific outputs.
+ * \brief  Query latency of logger() calls.
  *
- * The given output function is searched in of id specific outputs.
+ * Time spent by callers in \c logger(), \c logger_va(), \c logger_every_n(),
+ * \c logger_every_ms(), \c logger_sample() and \c logger_kv() since the last
+ * reset. Needs a build with \c LOGGER_LATENCY.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * \param[out]    latency  Summary of call latency.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise.
+ * \return        \c LOGGER_OK if no error occurred, \c LOGGER_ERR_NOT_SUPPORTED
+ *                if not built with \c LOGGER_LATENCY, error code otherwise.
  ******************************************************************************/
-logger_bool_t logger_id_output_function_is_registered(const logger_id_t        id,
-                                                      logger_output_function_t function)
+logger_return_t logger_latency_get(logger_latency_t *latency)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  /* GUARD: check for valid latency */
+  if (latency == NULL) {
+    return(LOGGER_ERR_OUTPUT_INVALID);
   }
 
-  /* search function in global outputs */
-  return(logger_output_common_is_registered(logger_control[id].outputs,
-                                            LOGGER_ELEMENTS(logger_control[id].outputs),
-                                            LOGGER_OUTPUT_TYPE_FUNCTION,
-                                            (FILE *)NULL,
-                                            function));
+#ifdef LOGGER_LATENCY
+  logger_histogram_summary(&logger_latency_calls, latency);
+
+  return(LOGGER_OK);
+#else  /* LOGGER_LATENCY */
+  return(LOGGER_ERR_NOT_SUPPORTED);
+#endif /* LOGGER_LATENCY */
+}
+
+
+/***************************************************************************//**
+ * \brief  Query write latency of an output stream.
+ *
+ * Needs a build with \c LOGGER_LATENCY.
+ *
+ * \param[in]     stream   Measured file stream.
+ * \param[out]    latency  Summary of write latency.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_latency_get(FILE             *stream,
+                                          logger_latency_t *latency)
+{
+  return(logger_output_common_latency_get(LOGGER_OUTPUT_TYPE_FILESTREAM,
+                                          stream,
+                                          (logger_output_function_t)NULL,
+                                          (const logger_output_driver_t *)NULL,
+                                          NULL,
+                                          latency));
+}
+
+
+/***************************************************************************//**
+ * \brief  Query write latency of an output function.
+ *
+ * Needs a build with \c LOGGER_LATENCY.
+ *
+ * \param[in]     function  Measured output function.
+ * \param[out]    latency   Summary of write latency.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_output_function_latency_get(logger_output_function_t function,
+                                                   logger_latency_t         *latency)
+{
+  return(logger_output_common_latency_get(LOGGER_OUTPUT_TYPE_FUNCTION,
+                                          (FILE *)NULL,
+                                          function,
+                                          (const logger_output_driver_t *)NULL,
+                                          NULL,
+                                          latency));
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level for id specific output function.
+ * \brief  Query write latency of an output driver.
  *
- * Set the minimum logging level for given output function. Only log messages
- * equal or above the given level will be printed to the given function.
+ * Needs a build with \c LOGGER_LATENCY.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
- * \param[in]     level     Level to set.
+ * \param[in]     driver   Measured driver.
+ * \param[in]     context  Context given during registration.
+ * \param[out]    latency  Summary of write latency.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_output_function_level_set(const logger_id_t        id,
-                                                    logger_output_function_t function,
-                                                    const logger_level_t     level)
+logger_return_t logger_output_driver_latency_get(const logger_output_driver_t *driver,
+                                                 void                         *context,
+                                                 logger_latency_t             *latency)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+  return(logger_output_common_latency_get(LOGGER_OUTPUT_TYPE_DRIVER,
+                                          (FILE *)NULL,
+                                          (logger_output_function_t)NULL,
+                                          driver,
+                                          context,
+                                          latency));
+}
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0 &&
-      (level & (level - 1)) == 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
-  }
 
-  /* set function output level to id specific outputs */
-  return(logger_output_common_level_set(logger_control[id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function,
-                                        LOGGER_ALL ^ (level - 1)));
+#ifdef LOGGER_LATENCY
+/***************************************************************************//**
+ * \brief  Print a latency summary as system message.
+ *
+ * \param[in]     level      Level of system message.
+ * \param[in]     name       What was measured.
+ * \param[in]     histogram  Latency histogram.
+ ******************************************************************************/
+LOGGER_INLINE void logger_latency_message(logger_level_t           level,
+                                          const char               *name,
+                                          const logger_histogram_t *histogram)
+{
+  char             latency_prefix[LOGGER_PREFIX_STRING_MAX];
+  char             latency_message[LOGGER_MESSAGE_STRING_MAX];
+  logger_latency_t latency;
+
+  logger_histogram_summary(histogram, &latency);
+
+  /* generate system empty prefix */
+  strncpy(latency_prefix, "LOGGER SYSTEM MESSAGE: ", LOGGER_ELEMENTS(latency_prefix));
+
+  (void)snprintf(latency_message, sizeof(latency_message),
+                 "latency of %s: count %" PRIu64 " min %" PRIu64 " mean %" PRIu64 " p50 %" PRIu64 " p90 %" PRIu64 " p99 %" PRIu64 " p99.9 %" PRIu64 " max %" PRIu64 " ns",
+                 name, latency.count, latency.min, latency.mean, latency.p50, latency.p90, latency.p99, latency.p999, latency.max);
+
+  (void)logger_output_id(logger_system_id, level, NULL, latency_prefix, latency_message, NULL);
 }
+#endif /* LOGGER_LATENCY */
 
 
 /***************************************************************************//**
- * \brief  Query logging level for id specific output function.
+ * \brief  Print latency histograms.
  *
- * Query the currently set minimum level for the given logging output function.
+ * Print a summary of the latency of logger() calls and of the write latency
+ * of each measured output as messages of the \c LOGGER_SYSTEM ID. Needs a
+ * build with \c LOGGER_LATENCY.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * \param[in]     level  Level of printed messages.
  *
- * \return        Currently set logging level.
+ * \return        \c LOGGER_OK if no error occurred, \c LOGGER_ERR_NOT_SUPPORTED
+ *                if not built with \c LOGGER_LATENCY, error code otherwise.
  ******************************************************************************/
-logger_level_t logger_id_output_function_level_get(const logger_id_t        id,
-                                                   logger_output_function_t function)
+logger_return_t logger_latency_dump(const logger_level_t level)
 {
-  logger_level_t level;
-
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_UNKNOWN);
+  /* GUARD: check for valid level, a single level is needed */
+  if ((level == 0) ||
+      ((level & ~LOGGER_ALL) != 0) ||
+      ((level & (level - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
   }
 
-  /* get function output level from id specific outputs */
-  level = logger_output_common_level_get(logger_control[id].outputs,
-                                         LOGGER_ELEMENTS(logger_control[id].outputs),
-                                         LOGGER_OUTPUT_TYPE_FUNCTION,
-                                         (FILE *)NULL,
-                                         function);
+#ifdef LOGGER_LATENCY
+  {
+    const logger_output_latency_t *latency;
+    char                          name[64];
+    size_t                        index;
 
-  /* return only lowest set bit */
-  return(LOGGER_ALL ^ (level - 1));
+    /* GUARD: called by an output */
+    if (logger_print_lock(&logger_repeat_mutex) == logger_false) {
+      return(LOGGER_ERR_REENTRANT);
+    }
+
+    /* outputs will be used, print repeat message */
+    logger_repeat_message();
+
+    logger_latency_message(level, "logger() calls", &logger_latency_calls);
+
+    for (index = 0 ; index < LOGGER_ELEMENTS(logger_latency_outputs) ; index++) {
+      latency = &logger_latency_outputs[index];
+
+      switch (latency->type) {
+        case LOGGER_OUTPUT_TYPE_FILESTREAM:
+          (void)snprintf(name, sizeof(name), "output %zu (stream %d) writes", index, fileno(latency->stream));
+          break;
+
+        case LOGGER_OUTPUT_TYPE_FUNCTION:
+          (void)snprintf(name, sizeof(name), "output %zu (function) writes", index);
+          break;
+
+        case LOGGER_OUTPUT_TYPE_DRIVER:
+          (void)snprintf(name, sizeof(name), "output %zu (driver) writes", index);
+          break;
+
+        case LOGGER_OUTPUT_TYPE_RECORD:
+          (void)snprintf(name, sizeof(name), "output %zu (record function) writes", index);
+          break;
+
+        default:
+          continue;
+      }
+
+      logger_latency_message(level, name, &latency->histogram);
+    }
+
+    logger_print_unlock(&logger_repeat_mutex);
+
+    return(LOGGER_OK);
+  }
+#else  /* LOGGER_LATENCY */
+  return(LOGGER_ERR_NOT_SUPPORTED);
+#endif /* LOGGER_LATENCY */
 }
 
 
 /***************************************************************************//**
- * \brief  Set logging level mask for id specific output function.
- *
- * Set a logging level mask for given output function. Only for log messages
- * with a level set in the given level mask the function will be called.
+ * \brief  Reset latency histograms.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
- * \param[in]     level     Level mask to set.
+ * Needs a build with \c LOGGER_LATENCY.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c LOGGER_OK if no error occurred, \c LOGGER_ERR_NOT_SUPPORTED
+ *                if not built with \c LOGGER_LATENCY.
  ******************************************************************************/
-logger_return_t logger_id_output_function_level_mask_set(const logger_id_t        id,
-                                                         logger_output_function_t function,
-                                                         const logger_level_t     level)
+logger_return_t logger_latency_reset(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
+#ifdef LOGGER_LATENCY
+  size_t index;
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  logger_histogram_clear(&logger_latency_calls);
+
+  /* measured outputs are kept, registered outputs point to them */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_latency_outputs) ; index++) {
+    logger_histogram_clear(&logger_latency_outputs[index].histogram);
   }
 
-  /* set function output level to id specific outputs */
-  return(logger_output_common_level_set(logger_control[id].outputs,
-                                        LOGGER_ELEMENTS(logger_control[id].outputs),
-                                        LOGGER_OUTPUT_TYPE_FUNCTION,
-                                        (FILE *)NULL,
-                                        function,
-                                        level));
+  return(LOGGER_OK);
+#else  /* LOGGER_LATENCY */
+  return(LOGGER_ERR_NOT_SUPPORTED);
+#endif /* LOGGER_LATENCY */
 }
 
 
 /***************************************************************************//**
- * \brief  Query logging level mask for id specific output function.
+ * \brief  Check if a slot of a call site table belongs to a call site.
  *
- * Query the currently set minimum level for the given logging output function.
+ * A free slot is claimed for the call site by the first thread swapping its
+ * file from \c NULL, so call site tables are searched without locking. Until
+ * the claiming thread has stored line and function the file is
+ * \c logger_site_claiming and other threads wait for it.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * \param[in,out] slot_file      File of slot, NULL if slot is free.
+ * \param[in,out] slot_function  Function of slot, NULL if not stored.
+ * \param[in,out] slot_line      Line of slot.
+ * \param[in]     file           Name of file of call site.
+ * \param[in]     function       Name of function of call site.
+ * \param[in]     line           Line of call site.
  *
- * \return        Currently set logging level mask.
+ * \return        \c logger_true if the slot belongs to the call site.
  ******************************************************************************/
-logger_level_t logger_id_output_function_level_mask_get(const logger_id_t        id,
-                                                   logger_output_function_t function)
+LOGGER_INLINE logger_bool_t logger_site_claim(const char **slot_file,
+                                              const char **slot_function,
+                                              uint32_t   *slot_line,
+                                              const char *file,
+                                              const char *function,
+                                              uint32_t   line)
 {
-  logger_level_t level;
+  const char *current;
 
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_UNKNOWN);
-  }
+  do {
+    current = LOGGER_ATOMIC_LOAD(slot_file);
 
-  /* get function output level from id specific outputs */
-  level = logger_output_common_level_get(logger_control[id].outputs,
-                                         LOGGER_ELEMENTS(logger_control[id].outputs),
-                                         LOGGER_OUTPUT_TYPE_FUNCTION,
-                                         (FILE *)NULL,
-                                         function);
+    if ((current == NULL) &&
+        (LOGGER_ATOMIC_SWAP(slot_file, &current, logger_site_claiming) != 0)) {
+      LOGGER_COUNTER_SET(slot_line, line);
+      if (slot_function != NULL) {
+        LOGGER_COUNTER_SET(slot_function, function);
+      }
 
-  return(level);
+      /* line and function are visible with the file */
+      LOGGER_ATOMIC_STORE(slot_file, file);
+
+      return(logger_true);
+    }
+  } while ((current == NULL) || (current == logger_site_claiming));
+
+  /* the same file name may be stored more than once */
+  return(((LOGGER_COUNTER_GET(slot_line) == line) &&
+          ((current == file) || (strcmp(current, file) == 0))) ? logger_true : logger_false);
 }
 
 
 /***************************************************************************//**
- * \brief  Enable the id specific output function color setting.
+ * \brief  Find profile of a call site.
  *
- * Enable the color setting for a given output function.
+ * Call sites are identified by file and line. A new call site gets a free slot,
+ * see \c logger_site_claim(). Counters are updated without locking.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * \param[in]     file      Name of file of call site.
+ * \param[in]     function  Name of function of call site.
+ * \param[in]     line      Line of call site.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Call site profile, NULL if all slots are used.
  ******************************************************************************/
-logger_return_t logger_id_output_function_color_enable(const logger_id_t        id,
-                                                       logger_output_function_t function)
+LOGGER_INLINE logger_profile_site_t *logger_profile_find(const char *file,
+                                                         const char *function,
+                                                         uint32_t   line)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  size_t index;
+  size_t probe;
+
+  index = line % LOGGER_ELEMENTS(logger_profile_sites);
+
+  for (probe = 0 ; probe < LOGGER_ELEMENTS(logger_profile_sites) ; probe++) {
+    logger_profile_site_t *site = &logger_profile_sites[index];
+
+    if (logger_site_claim(&site->file, &site->function, &site->line, file, function, line) == logger_true) {
+      return(site);
+    }
+
+    index = (index + 1) % LOGGER_ELEMENTS(logger_profile_sites);
   }
 
-  /* enable function output enable to id specific outputs */
-  return(logger_output_common_color(logger_control[id].outputs,
-                                    LOGGER_ELEMENTS(logger_control[id].outputs),
-                                    LOGGER_OUTPUT_TYPE_FUNCTION,
-                                    (FILE *)NULL,
-                                    function,
-                                    logger_true));
+  return(NULL);
 }
 
 
 /***************************************************************************//**
- * \brief  Disable the id specific output function color setting.
+ * \brief  Compare call site profiles for sorting.
  *
- * Disable the color setting for a given output function.
+ * Call sites writing more bytes come first, then those printing more lines,
+ * then those called more often. Free slots come last.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * \param[in]     first   First call site profile.
+ * \param[in]     second  Second call site profile.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        Negative if first comes first, positive if second comes first.
  ******************************************************************************/
-logger_return_t logger_id_output_function_color_disable(const logger_id_t        id,
-                                                        logger_output_function_t function)
+static int logger_profile_compare(const void *first,
+                                  const void *second)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  const logger_profile_site_t *a = *(const logger_profile_site_t * const *)first;
+  const logger_profile_site_t *b = *(const logger_profile_site_t * const *)second;
+
+  if ((a->file == NULL) || (b->file == NULL)) {
+    return((a->file == NULL) - (b->file == NULL));
   }
 
-  /* disable function output color in id specific outputs */
-  return(logger_output_common_color(logger_control[id].outputs,
-                                    LOGGER_ELEMENTS(logger_control[id].outputs),
-                                    LOGGER_OUTPUT_TYPE_FUNCTION,
-                                    (FILE *)NULL,
-                                    function,
-                                    logger_false));
+  if (a->bytes != b->bytes) {
+    return((a->bytes > b->bytes) ? -1 : 1);
+  }
+
+  if (a->lines != b->lines) {
+    return((a->lines > b->lines) ? -1 : 1);
+  }
+
+  if (a->calls != b->calls) {
+    return((a->calls > b->calls) ? -1 : 1);
+  }
+
+  /* equal call sites keep their order */
+  return((a < b) ? -1 : 1);
 }
 
 
 /***************************************************************************//**
- * \brief  Query the id specific output function color setting.
- *
- * Query the color setting for a given output function.
+ * \brief  Print call site profile at exit.
+ ******************************************************************************/
+static void logger_profile_exit(void)
+{
+  if ((logger_initialized == logger_true) &&
+      (logger_profile_exit_level != LOGGER_UNKNOWN)) {
+    (void)logger_profile_dump(logger_profile_exit_level, 0);
+  }
+}
+
+
+/***************************************************************************//**
+ * \brief  Enable call site profile.
  *
- * \param[in]     id        Logger ID.
- * \param[in]     function  User provided output function.
+ * Count calls, printed lines and bytes written to all outputs for each call
+ * site of \c logger() and its variants. Call sites are kept in
+ * \c LOGGER_PROFILE_SITES_MAX slots, calls of further call sites are only
+ * counted as a whole.
  *
- * \return        \c logger_true if logger is found, logger_false otherwise
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_bool_t logger_id_output_function_color_is_enabled(const logger_id_t        id,
-                                                         logger_output_function_t function)
+logger_return_t logger_profile_enable(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(logger_false);
-  }
+  LOGGER_ATOMIC_STORE(&logger_profile_enabled, logger_true);
 
-  /* check if color for this function is enabled */
-  return(logger_output_common_color_is_enabled(logger_control[id].outputs,
-                                               LOGGER_ELEMENTS(logger_control[id].outputs),
-                                               LOGGER_OUTPUT_TYPE_FUNCTION,
-                                               (FILE *)NULL,
-                                               function));
+  return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Change terminal text color and attributes.
- *
- * Change text color and attributes for all messages of given ID when they are
- * printed to \c stdout or \c stdin. Outputs to other streams including files
- * will have no color unless explicit enabled. This function uses escape
- * sequences of unix consoles. Attributes can be combined using `|`. To set any
- * other markup strings use logger_id_color_string_set().
+ * \brief  Disable call site profile.
  *
- * \param[in]     id      ID for setting level.
- * \param[in]     fg      Text foreground.
- * \param[in]     bg      Text background.
- * \param[in]     attr    Text attribute.
+ * Counted call sites are kept until logger_profile_reset().
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_color_console_set(const logger_id_t        id,
-                                            const logger_text_fg_t   fg,
-                                            const logger_text_bg_t   bg,
-                                            const logger_text_attr_t attr)
+logger_return_t logger_profile_disable(void)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
-  }
-
-  logger_control[id].color = logger_true;
-  (void)logger_color_console_format(logger_control[id].color_string.begin, LOGGER_ELEMENTS(logger_control[id].color_string.begin), fg, bg, attr);
-  (void)logger_color_console_format(logger_control[id].color_string.end, LOGGER_ELEMENTS(logger_control[id].color_string.end), LOGGER_FG_UNCHANGED, LOGGER_BG_UNCHANGED, LOGGER_ATTR_RESET);
-  logger_control[id].color_string_changed = logger_true;
+  LOGGER_ATOMIC_STORE(&logger_profile_enabled, logger_false);
 
   return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Change terminal text color and attributes.
+ * \brief  Query call site profile state.
+ *
+ * \return        \c logger_true if call site profile is enabled.
+ ******************************************************************************/
+logger_bool_t logger_profile_is_enabled(void)
+{
+  return(logger_profile_enabled);
+}
+
+
+/***************************************************************************//**
+ * \brief  Print call site profile.
  *
- * Change text color and attributes for all messages of given ID when they are
- * printed to \c stdout or \c stdin. Outputs to other streams including files
- * will have no color unless explicit enabled. To set colors for unix consoles
- * use logger_color_prefix_set().
+ * Print the call sites sorted by bytes written, lines printed and calls as
+ * messages of the \c LOGGER_SYSTEM ID.
  *
- * \param[in]     id      ID for setting level.
- * \param[in]     begin   Text color begin markup.
- * \param[in]     end     Text color end markup.
+ * \param[in]     level  Level of printed messages.
+ * \param[in]     count  Number of call sites to print, 0 for all.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_color_string_set(const logger_id_t id,
-                                           const char        *begin,
-                                           const char        *end)
+logger_return_t logger_profile_dump(const logger_level_t level,
+                                    const uint16_t       count)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  logger_profile_site_t       copy[LOGGER_PROFILE_SITES_MAX];
+  const logger_profile_site_t *order[LOGGER_PROFILE_SITES_MAX];
+  char                        profile_prefix[LOGGER_PREFIX_STRING_MAX];
+  char                        profile_message[LOGGER_MESSAGE_STRING_MAX];
+  size_t                      sites = 0;
+  size_t                      index;
+
+  /* GUARD: check for valid level, a single level is needed */
+  if ((level == 0) ||
+      ((level & ~LOGGER_ALL) != 0) ||
+      ((level & (level - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
   }
 
-  /* GUARD: check for too long color strings */
-  if ((strlen(begin) >= LOGGER_ELEMENTS(logger_control[id].color_string.begin)) ||
-      (strlen(end)   >= LOGGER_ELEMENTS(logger_control[id].color_string.end))) {
-    return(LOGGER_ERR_STRING_TOO_LONG);
+  /* GUARD: called by an output */
+  if (logger_print_lock(&logger_repeat_mutex) == logger_false) {
+    return(LOGGER_ERR_REENTRANT);
   }
 
-  logger_control[id].color = logger_true;
-  (void)strncpy(logger_control[id].color_string.begin, begin, LOGGER_ELEMENTS(logger_control[id].color_string.begin));
-  (void)strncpy(logger_control[id].color_string.end, end, LOGGER_ELEMENTS(logger_control[id].color_string.end));
-  logger_control[id].color_string.begin[LOGGER_ELEMENTS(logger_control[id].color_string.begin) - 1] = '\0';
-  logger_control[id].color_string.end[LOGGER_ELEMENTS(logger_control[id].color_string.end) - 1]   = '\0';
-  logger_control[id].color_string_changed = logger_true;
+  /* sort a snapshot, the call sites are counted while sorting */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_profile_sites) ; index++) {
+    const char *file = LOGGER_ATOMIC_LOAD(&logger_profile_sites[index].file);
+
+    copy[index].file     = (file == logger_site_claiming) ? NULL : file;
+    copy[index].function = LOGGER_COUNTER_GET(&logger_profile_sites[index].function);
+    copy[index].line     = LOGGER_COUNTER_GET(&logger_profile_sites[index].line);
+    copy[index].calls    = LOGGER_COUNTER_GET(&logger_profile_sites[index].calls);
+    copy[index].lines    = LOGGER_COUNTER_GET(&logger_profile_sites[index].lines);
+    copy[index].bytes    = LOGGER_COUNTER_GET(&logger_profile_sites[index].bytes);
+    order[index]         = &copy[index];
+
+    if (copy[index].file != NULL) {
+      sites++;
+    }
+  }
+
+  qsort(order, LOGGER_ELEMENTS(order), sizeof(order[0]), logger_profile_compare);
+
+  /* outputs will be used, print repeat message */
+  logger_repeat_message();
+
+  /* generate system empty prefix */
+  strncpy(profile_prefix, "LOGGER SYSTEM MESSAGE: ", LOGGER_ELEMENTS(profile_prefix));
+
+  (void)snprintf(profile_message, sizeof(profile_message), "call site profile of %zu call sites, %" PRIu64 " calls of further call sites", sites, LOGGER_COUNTER_GET(&logger_profile_untracked));
+  (void)logger_output_id(logger_system_id, level, NULL, profile_prefix, profile_message, NULL);
+
+  for (index = 0 ; (index < sites) && ((count == 0) || (index < count)) ; index++) {
+    (void)snprintf(profile_message, sizeof(profile_message), "%" PRIu64 " bytes %" PRIu64 " lines %" PRIu64 " calls %s:%" PRIu32 " %s()",
+                   order[index]->bytes, order[index]->lines, order[index]->calls, logger_strip_path(order[index]->file), order[index]->line, order[index]->function);
+    (void)logger_output_id(logger_system_id, level, NULL, profile_prefix, profile_message, NULL);
+  }
+
+  logger_print_unlock(&logger_repeat_mutex);
 
   return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Reset terminal text color and attributes.
+ * \brief  Print call site profile at exit.
  *
- * Reset text color and attributes of given ID back to defaults.
+ * The profile is printed by an \c atexit() handler registered on first use.
  *
- * \param[in]     id      ID for setting level.
+ * \param[in]     level  Level of printed messages, \c LOGGER_UNKNOWN to print
+ *                       nothing at exit.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_id_color_reset(const logger_id_t id)
+logger_return_t logger_profile_dump_at_exit(const logger_level_t level)
 {
-  /* GUARD: check for valid ID */
-  if ((id < 0) ||
-      (id == logger_system_id) ||
-      (id >= LOGGER_ELEMENTS(logger_control)) ||
-      (logger_control[id].used == logger_false)) {
-    return(LOGGER_ERR_ID_UNKNOWN);
+  /* GUARD: check for valid level, a single level is needed */
+  if (((level & ~LOGGER_ALL) != 0) ||
+      ((level & (level - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
   }
 
-  logger_control[id].color                 = logger_false;
-  logger_control[id].color_string.begin[0] = '\0';
-  logger_control[id].color_string.end[0]   = '\0';
-  logger_control[id].color_string_changed  = logger_true;
+  if ((level != LOGGER_UNKNOWN) &&
+      (logger_profile_exit_registered == logger_false)) {
+    /* GUARD: exit handler can't be registered */
+    if (atexit(logger_profile_exit) != 0) {
+      return(LOGGER_ERR_UNKNOWN);
+    }
+
+    logger_profile_exit_registered = logger_true;
+  }
+
+  logger_profile_exit_level = level;
 
   return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Enable logger prefix colors.
+ * \brief  Reset call site profile.
  *
- * Enable logger prefix color output.
+ * Calls counted while resetting may be lost.
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-logger_return_t logger_color_prefix_enable(void)
+logger_return_t logger_profile_reset(void)
 {
-  logger_color_prefix_enabled = logger_true;
+  size_t index;
 
-  return(LOGGER_OK);
-}
+  LOGGER_COUNTER_SET(&logger_profile_untracked, 0);
 
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_profile_sites) ; index++) {
+    logger_profile_site_t *site = &logger_profile_sites[index];
 
-/***************************************************************************//**
- * \brief  Disable logger prefix colors.
- *
- * Disable logger prefix color output.
- *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
- ******************************************************************************/
-logger_return_t logger_color_prefix_disable(void)
-{
-  logger_color_prefix_enabled = logger_false;
+    LOGGER_COUNTER_SET(&site->calls, 0);
+    LOGGER_COUNTER_SET(&site->lines, 0);
+    LOGGER_COUNTER_SET(&site->bytes, 0);
+    LOGGER_ATOMIC_STORE(&site->file, NULL);
+  }
 
   return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  Query the current enable state of logger prefix colors.
+ * \brief  Configure a token bucket.
  *
- * Query the current prefix color enable state of logger.
+ * The bucket starts full. Called with \c logger_limit_mutex locked, the rate
+ * is read without it to skip the lock if no limit is set.
  *
- * \return        \c logger_true if logger prefix color is enabled, logger_false otherwise.
+ * \param[out]    bucket  Token bucket.
+ * \param[in]     rate    Tokens added per second, 0 if unlimited.
+ * \param[in]     burst   Maximum number of tokens.
  ******************************************************************************/
-logger_bool_t logger_color_prefix_is_enabled(void)
+LOGGER_INLINE void logger_bucket_set(logger_bucket_t           *bucket,
+                                     const logger_rate_limit_t rate,
+                                     const logger_rate_limit_t burst)
 {
-  return(logger_color_prefix_enabled);
+  bucket->burst   = burst;
+  bucket->tokens  = (uint64_t)burst * 1000;
+  bucket->updated = logger_time_ms();
+  LOGGER_ATOMIC_STORE(&bucket->rate, rate);
 }
 
 
 /***************************************************************************//**
- * \brief  Change terminal text color and attributes for prefix.
- *
- * Change text color and attributes for message prefix with given level when
- * they are printed to \c stdout or \c stdin. Outputs to other streams
- * including files will have no color unless explicit enabled. This function
- * uses escape sequences of unix consoles. Attributes can be combined using
- * `|`. To set any other markup strings use logger_color_prefix_string_set().
+ * \brief  Refill a token bucket and check for a token.
  *
- * \param[in]     level   Level to set.
- * \param[in]     fg      Text foreground.
- * \param[in]     bg      Text background.
- * \param[in]     attr    Text attribute.
+ * \param[in,out] bucket  Token bucket.
+ * \param[in]     now     Current time in milliseconds.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c logger_true if no token is available.
  ******************************************************************************/
-logger_return_t logger_color_prefix_console_set(const logger_level_t     level,
-                                                const logger_text_fg_t   fg,
-                                                const logger_text_bg_t   bg,
-                                                const logger_text_attr_t attr)
+LOGGER_INLINE logger_bool_t logger_bucket_empty(logger_bucket_t *bucket,
+                                                uint64_t        now)
 {
-  size_t   index;
+  uint64_t tokens;
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  if (bucket->rate == 0) {
+    return(logger_false);
   }
 
-  /* get index for level */
-  index = logger_level_to_index(level);
-
-  (void)logger_color_console_format(logger_level_colors[index].begin, LOGGER_ELEMENTS(logger_level_colors[index].begin), fg, bg, attr);
-  (void)logger_color_console_format(logger_level_colors[index].end, LOGGER_ELEMENTS(logger_level_colors[index].end), LOGGER_FG_UNCHANGED, LOGGER_BG_UNCHANGED, LOGGER_ATTR_RESET);
+  /* rate is in tokens per second, so milliseconds times rate are thousandths */
+  tokens = bucket->tokens + (now - bucket->updated) * bucket->rate;
+  bucket->tokens  = LOGGER_NUMERIC_MIN(tokens, (uint64_t)bucket->burst * 1000);
+  bucket->updated = now;
 
-  return(LOGGER_OK);
+  return(bucket->tokens < 1000 ? logger_true : logger_false);
 }
 
 
 /***************************************************************************//**
- * \brief  Change text color and attributes for prefix.
+ * \brief  Check if rate limits of ID and level are exceeded.
  *
- * Change text color and attributes for message prefix with given level when
- * they are printed to \c stdout or \c stdin. Outputs to other streams
- * including files will have no color unless explicit enabled. To set colors
- * for unix consoles use logger_color_prefix_set().
+ * No token is taken, logger_bucket_take() does so once the message is printed.
+ * This way a skipped message or a suppressed repeat doesn't use up the budget
+ * of the other bucket or of the global rate limit.
  *
- * \param[in]     level   Level for setting color string.
- * \param[in]     begin   Text color begin markup.
- * \param[in]     end     Text color end markup.
+ * \param[in]     id      ID outputting this message.
+ * \param[in]     level   Level of this message.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c logger_true if a rate limit is exceeded.
  ******************************************************************************/
-logger_return_t logger_color_prefix_string_set(const logger_level_t level,
-                                               const char           *begin,
-                                               const char           *end)
+LOGGER_INLINE logger_bool_t logger_check_bucket_limit(logger_id_t    id,
+                                                      logger_level_t level)
 {
-  size_t   index;
-
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  logger_bucket_t *id_bucket    = &logger_control[id].bucket;
+  logger_bucket_t *level_bucket = &logger_level_buckets[logger_level_to_index(level)];
+  logger_bool_t   id_empty;
+  logger_bool_t   level_empty;
+  uint64_t        now;
+
+  /* avoid reading the clock if there are no limits */
+  if ((id_bucket->rate == 0) &&
+      (level_bucket->rate == 0)) {
+    return(logger_false);
   }
 
-  /* GUARD: check for too long color strings */
-  if ((strlen(begin) >= LOGGER_ELEMENTS(logger_level_colors[index].begin)) ||
-      (strlen(end)   >= LOGGER_ELEMENTS(logger_level_colors[index].end))) {
-    return(LOGGER_ERR_STRING_TOO_LONG);
-  }
+  now         = logger_time_ms();
+  id_empty    = logger_bucket_empty(id_bucket, now);
+  level_empty = logger_bucket_empty(level_bucket, now);
 
-  /* get index for level */
-  index = logger_level_to_index(level);
+  if ((id_empty == logger_true) ||
+      (level_empty == logger_true)) {
+    if (id_empty == logger_true) {
+      id_bucket->skipped++;
+    }
+    if (level_empty == logger_true) {
+      level_bucket->skipped++;
+    }
 
-  (void)strncpy(logger_level_colors[index].begin, begin, LOGGER_ELEMENTS(logger_level_colors[index].begin));
-  (void)strncpy(logger_level_colors[index].end, end, LOGGER_ELEMENTS(logger_level_colors[index].end));
-  logger_level_colors[index].begin[LOGGER_ELEMENTS(logger_level_colors[index].begin) - 1] = '\0';
-  logger_level_colors[index].end[LOGGER_ELEMENTS(logger_level_colors[index].end) - 1]   = '\0';
+    return(logger_true);
+  }
 
-  return(LOGGER_OK);
+  return(logger_false);
 }
 
 
 /***************************************************************************//**
- * \brief  Change terminal text color and attributes for prefix.
+ * \brief  Take a token from the rate limits of ID and level.
  *
- * Reset text color and attributes for message prefix to console default escape
- * sequences.
+ * Called once a message is printed, suppressed repeats don't use up tokens.
+ * Other threads may have taken the token found by logger_check_bucket_limit()
+ * meanwhile, buckets never go below empty.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     id      ID outputting this message.
+ * \param[in]     level   Level of this message.
  ******************************************************************************/
-logger_return_t logger_color_prefix_reset(void)
+LOGGER_INLINE void logger_bucket_take(logger_id_t    id,
+                                      logger_level_t level)
 {
-  memcpy(logger_level_colors, logger_level_colors_console, sizeof(logger_level_colors));
+  logger_bucket_t *id_bucket    = &logger_control[id].bucket;
+  logger_bucket_t *level_bucket = &logger_level_buckets[logger_level_to_index(level)];
 
-  return(LOGGER_OK);
+  if (id_bucket->rate > 0) {
+    id_bucket->tokens -= LOGGER_NUMERIC_MIN(id_bucket->tokens, 1000);
+  }
+  if (level_bucket->rate > 0) {
+    level_bucket->tokens -= LOGGER_NUMERIC_MIN(level_bucket->tokens, 1000);
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Enable logger message colors.
- *
- * Enable logger message color output.
+ * \brief  Print number of messages skipped by a token bucket.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in,out] bucket  Token bucket.
+ * \param[in]     kind    Kind of limit, "ID" or "level".
+ * \param[in]     name    Name of ID or level.
  ******************************************************************************/
-logger_return_t logger_color_message_enable(void)
+LOGGER_INLINE void logger_bucket_message(logger_bucket_t *bucket,
+                                         const char      *kind,
+                                         const char      *name)
 {
-  logger_color_message_enabled = logger_true;
+  if (bucket->skipped > 0) {
+    char limit_prefix[LOGGER_PREFIX_STRING_MAX];
+    char limit_message[LOGGER_MESSAGE_STRING_MAX];
 
-  return(LOGGER_OK);
+    /* generate system empty prefix */
+    strncpy(limit_prefix, "LOGGER SYSTEM MESSAGE: ", LOGGER_ELEMENTS(limit_prefix));
+
+    /* generate string that contains number of skipped messages */
+    if (bucket->skipped == 1) {
+      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " message of %s %s skipped because of rate limit (%" PRIu16 " messages per second)", bucket->skipped, kind, name, bucket->rate);
+    }
+    else {
+      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " messages of %s %s skipped because of rate limit (%" PRIu16 " messages per second)", bucket->skipped, kind, name, bucket->rate);
+    }
+
+    /* output message */
+    (void)logger_output_id(logger_system_id, LOGGER_EMERG, NULL, limit_prefix, limit_message, NULL);
+
+    /* reset skip counter */
+    bucket->skipped = 0;
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Disable logger message colors.
+ * \brief  Find state of a call site.
  *
- * Disable logger message color output.
+ * Call sites are identified by file and line. A new call site gets a free slot,
+ * see \c logger_site_claim().
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \param[in]     file    Name of file of call site.
+ * \param[in]     line    Line of call site.
+ *
+ * \return        Call site state, NULL if all slots are used.
  ******************************************************************************/
-logger_return_t logger_color_message_disable(void)
+LOGGER_INLINE logger_site_t *logger_site_find(const char *file,
+                                              uint32_t   line)
 {
-  logger_color_message_enabled = logger_false;
+  size_t index;
+  size_t probe;
 
-  return(LOGGER_OK);
+  index = line % LOGGER_ELEMENTS(logger_sites);
+
+  for (probe = 0 ; probe < LOGGER_ELEMENTS(logger_sites) ; probe++) {
+    logger_site_t *site = &logger_sites[index];
+
+    if (logger_site_claim(&site->file, (const char **)NULL, &site->line, file, NULL, line) == logger_true) {
+      return(site);
+    }
+
+    index = (index + 1) % LOGGER_ELEMENTS(logger_sites);
+  }
+
+  return(NULL);
 }
 
 
 /***************************************************************************//**
- * \brief  Query the current enable state of logger message colors.
+ * \brief  Check if call site limit skips a message.
  *
- * Query the current color message enable state of logger.
+ * \param[in,out] site    Call site state.
+ * \param[in]     kind    Kind of call site limit.
+ * \param[in]     value   Number of messages, interval in milliseconds or
+ *                        probability scaled to \c UINT32_MAX.
  *
- * \return        \c logger_true if logger color is enabled, logger_false otherwise.
+ * \return        \c logger_true if message is skipped.
  ******************************************************************************/
-logger_bool_t logger_color_message_is_enabled(void)
+LOGGER_INLINE logger_bool_t logger_check_site_limit(logger_site_t      *site,
+                                                    logger_site_kind_t kind,
+                                                    uint32_t           value)
 {
-  return(logger_color_message_enabled);
+  logger_bool_t skip = logger_false;
+  uint64_t      now;
+
+  switch (kind) {
+    case LOGGER_SITE_NONE:
+      break;
+
+    case LOGGER_SITE_EVERY_N:
+      /* print first message, then every n-th */
+      if ((value > 1) &&
+          ((site->count % value) != 0)) {
+        skip = logger_true;
+      }
+      site->count++;
+      break;
+
+    case LOGGER_SITE_EVERY_MS:
+      now = logger_time_ms();
+      if ((site->printed == logger_true) &&
+          ((now - site->last) < value)) {
+        skip = logger_true;
+      }
+      else {
+        site->last = now;
+      }
+      break;
+
+    case LOGGER_SITE_SAMPLE:
+      /* xorshift32 */
+      logger_site_random ^= logger_site_random << 13;
+      logger_site_random ^= logger_site_random >> 17;
+      logger_site_random ^= logger_site_random << 5;
+      if ((value != UINT32_MAX) &&
+          (logger_site_random >= value)) {
+        skip = logger_true;
+      }
+      break;
+  }
+
+  if (skip == logger_true) {
+    site->skipped++;
+  }
+  else {
+    site->printed = logger_true;
+  }
+
+  return(skip);
 }
 
 
 /***************************************************************************//**
- * \brief  Query name for level.
- *
- * Query the name for the given logging level.
- *
- * \param[in]     level   Level for querying name
+ * \brief  Print number of messages skipped at a call site.
  *
- * \return        Symbolic name of the level.
+ * \param[in,out] site    Call site state.
  ******************************************************************************/
-const char *logger_level_name_get(const logger_level_t level)
+LOGGER_INLINE void logger_site_message(logger_site_t *site)
 {
-  size_t   index;
+  if (site->skipped > 0) {
+    char limit_prefix[LOGGER_PREFIX_STRING_MAX];
+    char limit_message[LOGGER_MESSAGE_STRING_MAX];
 
-  /* GUARD: check for valid level */
-  if ((level & ~LOGGER_ALL) != 0) {
-    return(logger_level_names[logger_level_to_index(LOGGER_UNKNOWN)]);
-  }
+    /* generate system empty prefix */
+    strncpy(limit_prefix, "LOGGER SYSTEM MESSAGE: ", LOGGER_ELEMENTS(limit_prefix));
 
-  /* get index for level */
-  index = logger_level_to_index(level);
+    /* generate string that contains number of skipped messages */
+    if (site->skipped == 1) {
+      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " message skipped at %s:%" PRIu32 " because of call site limit", site->skipped, logger_strip_path(site->file), site->line);
+    }
+    else {
+      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " messages skipped at %s:%" PRIu32 " because of call site limit", site->skipped, logger_strip_path(site->file), site->line);
+    }
 
-  /* get level name */
-  return(logger_level_names[index]);
+    /* output message */
+    (void)logger_output_id(logger_system_id, LOGGER_EMERG, NULL, limit_prefix, limit_message, NULL);
+
+    /* reset skip counter */
+    site->skipped = 0;
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  strip path from file name.
- *
- * Strip path from a fully qualified file name. Returns pointer to string part
- * after last separator.
+ * \brief  Drop the plan reader slot of an exiting thread.
  *
- * \param[in]     file    File name containing path
+ * Destructor of logger_thread_key.
  *
- * \return        Pointer to file name.
+ * \param[in]     value   Unused.
  ******************************************************************************/
-LOGGER_INLINE const char *logger_strip_path(const char *file)
+static void logger_thread_exit(void *value)
 {
-  const char *basename;
+  (void)value;
 
-  /* find last separator */
-  basename = strrchr(file, '/');
-  if (basename != NULL) {
-    /* eat last separator */
-    basename++;
-  }
-  else {
-    /* unable to find separator, use whole file name */
-    basename = file;
+  /* give the reader slot to the next thread */
+  if ((logger_plan_reader != NULL) &&
+      (logger_plan_reader != &logger_plan_overflow)) {
+    LOGGER_ATOMIC_STORE(&logger_plan_reader->used, 0);
   }
+  logger_plan_reader = NULL;
+}
+
 
-  return(basename);
+/***************************************************************************//**
+ * \brief  Create key to notice exiting threads.
+ ******************************************************************************/
+static void logger_thread_key_create(void)
+{
+  (void)pthread_key_create(&logger_thread_key, logger_thread_exit);
+  (void)pthread_key_create(&logger_builder_key, logger_builder_exit);
 }
 
 
 /***************************************************************************//**
- * \brief  Format date string
+ * \brief  Check if the calling thread is printing a message.
  *
- * Print date string into provided memory.
- * \param[out]    date       Formatted date string.
- * \param[in]     date_size  String length of formatted date string.
+ * Outputs and drivers are called while their thread prints a message and reads
+ * output plans. Publishing new plans from there would wait for the thread
+ * itself, so configuration changes are refused.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c logger_true if the calling thread is printing a message,
+ *                \c logger_false otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_format_date(char   *date,
-                                                 size_t date_size)
+LOGGER_INLINE logger_bool_t logger_print_active(void)
 {
-  time_t        current_time;
-  static time_t previous_time = 0;
-
-  /* get current time */
-  current_time = time(NULL);
-
-  /* do the expensive stuff only if needed */
-  if (current_time != previous_time) {
-    size_t    index;
-    struct tm *tmp;
+  return(logger_printing);
+}
 
-    /* update previous time */
-    previous_time = current_time;
 
-    /* convert to local time */
-    tmp = localtime(&current_time);
+/***************************************************************************//**
+ * \brief  Get the shard of message counters of the calling thread.
+ *
+ * Threads get shards round robin with their first message, so a few busy
+ * threads don't increment counters on the same cache line.
+ *
+ * \return        Index of shard below \c LOGGER_STATS_SHARDS.
+ ******************************************************************************/
+LOGGER_INLINE size_t logger_stats_shard(void)
+{
+  static LOGGER_THREAD_LOCAL uint32_t shard = 0;
 
-    /* if localtime returned a valid time */
-    if (tmp != NULL) {
-      if (strftime(date, date_size, LOGGER_FORMAT_STRFTIME, tmp) == 0) {
-        for (index = 0 ; index < 8 && index < date_size - 2 ; index++) {
-          date[index] = '#';
-        }
-        date[index] = '\0';
-      }
-    }
-    else {
-      for (index = 0 ; index < 8 && index < date_size - 2 ; index++) {
-        date[index] = '#';
-      }
-      date[index] = '\0';
-    }
+  if (shard == 0) {
+    shard = LOGGER_COUNTER_NEXT(&logger_stats_threads);
   }
 
-  return(LOGGER_OK);
+  return((size_t)(shard % LOGGER_STATS_SHARDS));
 }
 
 
 /***************************************************************************//**
- * \brief  Format message prefix
+ * \brief  Start printing a message.
  *
- * Print the prefix into provided memory.
+ * Messages are formatted in storage of the calling thread, so threads print
+ * at the same time. Only shared state is locked by the mutex protecting it:
+ * \c logger_lazy_mutex, \c logger_repeat_mutex and \c logger_limit_mutex, in
+ * this order. A thread that prints a message and logs again from an output
+ * would use the state it is changing, so this is refused.
  *
- * \param[in]     id           ID outputting this message.
- * \param[out]    prefix       Formatted message prefix.
- * \param[in]     prefix_size  String length of formatted message prefix.
- * \param[in]     level        Level of this message.
- * \param[in]     file         Name of file where this call happened.
- * \param[in]     function     Name of function where this call happened.
- * \param[in]     line         Line where this call happened.
+ * \param[in]     mutex   Mutex of shared state used, NULL if none.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c logger_true if started, \c logger_false if the calling
+ *                thread is printing a message already.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_format_prefix(logger_id_t    id,
-                                                   char           *prefix,
-                                                   uint16_t       prefix_size,
-                                                   logger_level_t level,
-                                                   const char     *file,
-                                                   const char     *function,
-                                                   uint32_t       line)
+LOGGER_INLINE logger_bool_t logger_print_lock(pthread_mutex_t *mutex)
 {
-  /* do prefix stuff only if needed */
-  if ((logger_control[id].append == logger_false) &&
-      (logger_control[id].prefix != LOGGER_PFX_EMPTY)) {
-    logger_prefix_t local_prefix;
-    char * write_ptr = prefix;
-    char * end_ptr   = prefix + prefix_size;
-
-    if (logger_control[id].prefix & LOGGER_PFX_UNSET) {
-      local_prefix = logger_prefix_standard;
-    }
-    else {
-      local_prefix = logger_control[id].prefix;
-    }
-
-    /* prefix date */
-    if ((write_ptr < end_ptr) &&
-        ((local_prefix & LOGGER_PFX_DATE) != 0)) {
-      write_ptr += logger_prefix_concatenate(write_ptr,
-                                             end_ptr,
-                                             logger_date,
-                                             LOGGER_FORMAT_STRING_DATE_WIDTH);
-    }
+  /* GUARD: an output of this thread is printing */
+  if (logger_printing == logger_true) {
+    return(logger_false);
+  }
 
-    /* prefix id name */
-    if ((write_ptr < end_ptr) &&
-        ((local_prefix & LOGGER_PFX_NAME) != 0)) {
-      write_ptr += logger_prefix_concatenate(write_ptr,
-                                             end_ptr,
-                                             logger_id_name_get(id),
-                                             LOGGER_FORMAT_STRING_NAME_WIDTH);
-    }
+  logger_printing = logger_true;
 
-    /* prefix level */
-    if ((write_ptr < end_ptr) &&
-        ((local_prefix & LOGGER_PFX_LEVEL) != 0)) {
-      write_ptr += logger_prefix_concatenate(write_ptr,
-                                             end_ptr,
-                                             logger_level_name_get(level),
-                                             LOGGER_FORMAT_STRING_LEVEL_WIDTH);
-    }
+  if (mutex != NULL) {
+    (void)pthread_mutex_lock(mutex);
+  }
 
-    /* prefix file name */
-    if ((write_ptr < end_ptr) &&
-        ((local_prefix & LOGGER_PFX_FILE) != 0)) {
-      write_ptr += logger_prefix_concatenate(write_ptr,
-                                             end_ptr,
-                                             logger_strip_path(file),
-                                             LOGGER_FORMAT_STRING_FILE_WIDTH);
-    }
+  return(logger_true);
+}
 
-    /* prefix function name */
-    if ((write_ptr < end_ptr) &&
-        ((local_prefix & LOGGER_PFX_FUNCTION) != 0)) {
-      write_ptr += logger_prefix_concatenate(write_ptr,
-                                             end_ptr,
-                                             function,
-                                             LOGGER_FORMAT_STRING_FUNCTION_WIDTH);
-    }
 
-    /* prefix line number */
-    if ((write_ptr < end_ptr) &&
-        ((local_prefix & LOGGER_PFX_LINE) != 0)) {
-      char linenumber[10];
-      char *ptr = &linenumber[LOGGER_ELEMENTS(linenumber) - 1];
+/***************************************************************************//**
+ * \brief  Stop printing a message.
+ *
+ * \param[in]     mutex   Mutex given to logger_print_lock().
+ ******************************************************************************/
+LOGGER_INLINE void logger_print_unlock(pthread_mutex_t *mutex)
+{
+  if (mutex != NULL) {
+    (void)pthread_mutex_unlock(mutex);
+  }
 
-      /* convert line number to string, starting with the lowest digit at the end of the string */
-      *ptr = '\0';
-      while (line > 0) {
-        int idx;
+  logger_printing = logger_false;
+}
 
-        idx  = line % 10;
-        line = line / 10;
-        *(--ptr) = logger_int_to_char[idx];
-      }
 
-      write_ptr += logger_prefix_concatenate(write_ptr,
-                                             end_ptr,
-                                             ptr,
-                                             LOGGER_FORMAT_STRING_LINE_WIDTH);
-    }
+/***************************************************************************//**
+ * \brief  Override logging level of an ID for the calling thread.
+ *
+ * The calling thread prints messages of the given ID with the given level or
+ * higher in addition to the levels of the ID, e.g. \c LOGGER_DEBUG while a
+ * single request is handled. Other threads are not affected. The ID still
+ * needs to be enabled and outputs print only their levels. Setting an
+ * override for the same ID again replaces it.
+ *
+ * \param[in]     id      Logger ID, \c logger_id_unknown for all IDs.
+ * \param[in]     level   Minimum level printed by the calling thread.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_thread_level_override(const logger_id_t    id,
+                                             const logger_level_t level)
+{
+  /* GUARD: check for valid ID */
+  if ((id != logger_id_unknown) &&
+      ((id < 0) ||
+       (id == logger_system_id) ||
+       (id >= LOGGER_ELEMENTS(logger_control)) ||
+       (logger_control[id].used == logger_false))) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
 
-    /* append ' ' to prefix string */
-    if (write_ptr < end_ptr) {
-      *(write_ptr++) = ' ';
-    }
-    if (write_ptr < end_ptr) {
-      *(write_ptr++) = '\0';
-    }
+  /* GUARD: check for valid level */
+  if ((level == LOGGER_UNKNOWN) ||
+      ((level & ~LOGGER_ALL) != 0) ||
+      ((level & (level - 1)) != 0)) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
 
-    /* terminate prefix string if it is too small */
-    if (write_ptr == end_ptr &&
-        *(write_ptr - 1) != '\0') {
-      *(--write_ptr) = '\0';
-      *(--write_ptr) = ' ';
-      *(--write_ptr) = '.';
-      *(--write_ptr) = '.';
-      *(--write_ptr) = '.';
-    }
+  /* only the calling thread reads its levels */
+  if (id == logger_id_unknown) {
+    logger_thread_level = LOGGER_ALL ^ (level - 1);
   }
   else {
-    /* clear prefix */
-    prefix[0] = '\0';
+    logger_thread_levels[id] = LOGGER_ALL ^ (level - 1);
   }
 
   return(LOGGER_OK);
@@ -3475,499 +12329,582 @@ LOGGER_INLINE logger_return_t logger_format_prefix(logger_id_t    id,
 
 
 /***************************************************************************//**
- * \brief  String copy
- *
- * Copies string from `src` to `dest` until end on `src` is reached or `n`
- * characters are copied. The string in `dest` is '\0' terminated if length of
- * string in `src` is less than `n`. Otherwise the string will *not* be
- * terminated. The function returns the number of characters copied to `dest`
- * not including the '\0'.
- *
- * \param[out]    dest  Destination string.
- * \param[in]     src   Source string. Needs to be '\0' terminated.
- * \param[in]     n     Maximum amount of characters available in destination
- *                      string.
+ * \brief  Remove all level overrides of the calling thread.
  *
- * \return     Number of characters written to destination string.
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE size_t logger_string_copy(char       *dest,
-                                        const char *src,
-                                        size_t     n)
+logger_return_t logger_thread_level_override_clear(void)
 {
-  size_t index;
-
-  for (index = 0 ; index < n && src[index] != '\0' ; index++) {
-    dest[index] = src[index];
-  }
-
-  if (index < n) {
-    dest[index] = '\0';
-  }
+  (void)memset(logger_thread_levels, 0, sizeof(logger_thread_levels));
+  logger_thread_level = LOGGER_UNKNOWN;
 
-  return(index);
+  return(LOGGER_OK);
 }
 
 
 /***************************************************************************//**
- * \brief  String copy
+ * \brief  Append the formatted message to a partial line.
  *
- * Copies string from `src` to `dest` until end on `src` is reached. Fill the
- * given width of string with spaces and append the prefix field separator. The
- * function returns the number of characters copied to `dest.
- *
- * This function is used to generate aligned prefixes of logger messages.
- *
- * @attention The returned string is not terminated with a '\0' character! This
- *            needs to be done externally
+ * A line not fitting is marked like a truncated message.
  *
- * \param[out]    dest       Destination string.
- * \param[in]     dest_end   Pointer to character after the absolute end of
- *                           destination string. Has nothing to do with width.
- * \param[in]     src        Source string. Needs to be '\0' terminated.
- * \param[in]     width      Width of field in destination string.
- *
- * \return     Number of characters written to destination string.
+ * \param[in,out] continuation  Partial line.
+ * \param[in,out] stats         Statistics of ID and level of the message.
  ******************************************************************************/
-LOGGER_INLINE size_t logger_prefix_concatenate(char       *dest,
-                                               const char *dest_end,
-                                               const char *src,
-                                               size_t     width)
+LOGGER_INLINE void logger_continuation_append(logger_continuation_t *continuation,
+                                              logger_stats_t        *stats)
 {
-  size_t characters = 0;
-
-  /* copy src to dest */
-  while (dest != dest_end &&
-         src != NULL &&
-         *src != '\0') {
-    *(dest++) = *(src++);
-    characters++;
-  }
+  size_t length;
+  size_t space;
 
-  /* fill string with spaces */
-  while (dest != dest_end &&
-         characters < width) {
-    *(dest++) = ' ';
-    characters++;
-  }
+  length = strlen(continuation->message);
+  space  = sizeof(continuation->message) - length;
 
-  /* append separator */
-  if (dest != dest_end) {
-    *(dest++) = LOGGER_FORMAT_STRING_SEPARATOR;
-    characters++;
+  /* GUARD: message fits */
+  if (logger_string_copy(continuation->message + length, logger_message, space) < space) {
+    return;
   }
 
-  return characters;
+  (void)memcpy(&continuation->message[sizeof(continuation->message) - 4], "...", 4);
+  LOGGER_COUNTER_ADD(&stats->truncated, 1);
 }
 
 
 /***************************************************************************//**
- * \brief  Format log message.
+ * \brief  Collect a part of a line of the calling thread.
  *
- * Print message into provides memory.
+ * A message without trailing '\n' is added to the partial line of the calling
+ * thread, which is started if needed. A message with '\n' completes the
+ * partial line, prefix, message and level are replaced by the whole line.
+ * Partial lines are kept in storage of the thread, lines of an ID whose line
+ * generation changed have been dropped.
  *
- * \param[in]     id            ID outputting this message.
- * \param[out]    message       Formatted message.
- * \param[in]     message_size  String length of formatted message.
- * \param[in]     format        \c printf() like format string.
- * \param[in]     argp          Argument list.
+ * \param[in]     id         ID outputting this message.
+ * \param[in]     append     Message is continued by the next message.
+ * \param[in,out] level      Level of this message, level of the whole line.
+ * \param[out]    completed  A partial line was completed.
+ * \param[in,out] stats      Statistics of ID and level of this message.
  *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ * \return        \c logger_true if the message is kept and must not be printed.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_format_message(logger_id_t id,
-                                                    char        *message,
-                                                    uint16_t    message_size,
-                                                    const char  *format,
-                                                    va_list     argp)
+LOGGER_INLINE logger_bool_t logger_continuation_collect(logger_id_t    id,
+                                                        logger_bool_t  append,
+                                                        logger_level_t *level,
+                                                        logger_bool_t  *completed,
+                                                        logger_stats_t *stats)
 {
-  int16_t  characters = 0;
-  size_t   rev_idx;
-  char     *message_end;
-
-  /* format message */
-  characters = vsnprintf(message, message_size, format, argp);
+  logger_continuation_t *continuation = NULL;
+  logger_continuation_t *slot         = NULL;
+  uint32_t              generation;
+  size_t                index;
 
-  /* set rev_idx to the last valid character in string */
-  rev_idx = message_size - 1;
+  generation = LOGGER_ATOMIC_LOAD(&logger_control[id].line_generation);
 
-  /* make sure message is '\0' terminated */
-  message[rev_idx--] = '\0';
+  /* search partial line of this thread and a free slot */
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_continuations) ; index++) {
+    if ((logger_continuations[index].used == logger_true) &&
+        (logger_continuations[index].generation != LOGGER_ATOMIC_LOAD(&logger_control[logger_continuations[index].id].line_generation))) {
+      logger_continuations[index].used = logger_false;
+    }
 
-  /* check if there was enough space in storage */
-  if ((characters < 0) || (characters >= message_size)) {
-    if (strrchr(format, '\n') != NULL) {
-      message[rev_idx--] = '\n';
+    if (logger_continuations[index].used == logger_false) {
+      if (slot == NULL) {
+        slot = &logger_continuations[index];
+      }
+    }
+    else if (logger_continuations[index].id == id) {
+      continuation = &logger_continuations[index];
     }
-    message[rev_idx--] = ' ';
-    message[rev_idx--] = '.';
-    message[rev_idx--] = '.';
-    message[rev_idx--] = '.';
   }
 
-  /* check for multi line message */
-  message_end = strrchr(message, '\n');
+  *completed = logger_false;
 
-  if (message_end != NULL) {
-    /* '\n' -> will not be continued */
-    logger_control[id].append = logger_false;
+  if (append == logger_true) {
+    /* start a new partial line */
+    if (continuation == NULL) {
+      /* no space left, print the part right away */
+      if (slot == NULL) {
+        return(logger_false);
+      }
 
-    /* remove '\n', needed for correct color display (see below) */
-    *message_end = '\0';
+      continuation             = slot;
+      continuation->used       = logger_true;
+      continuation->generation = generation;
+      continuation->id         = id;
+      continuation->level      = *level;
+      continuation->message[0] = '\0';
+      (void)logger_string_copy(continuation->prefix, logger_prefix, sizeof(continuation->prefix));
+      continuation->prefix[sizeof(continuation->prefix) - 1] = '\0';
+    }
+
+    logger_continuation_append(continuation, stats);
+
+    /* the next message of another thread starts a new line */
+    LOGGER_ATOMIC_STORE(&logger_control[id].append, logger_false);
+
+    return(logger_true);
   }
-  else {
-    /* no '\n' -> will be continued */
-    logger_control[id].append = logger_true;
+
+  /* complete the partial line */
+  if (continuation != NULL) {
+    logger_continuation_append(continuation, stats);
+
+    (void)logger_string_copy(logger_message, continuation->message, sizeof(logger_message));
+    (void)logger_string_copy(logger_prefix, continuation->prefix, sizeof(logger_prefix));
+    *level     = continuation->level;
+    *completed = logger_true;
+
+    continuation->used = logger_false;
   }
 
-  return(LOGGER_OK);
+  return(logger_false);
 }
 
 
 /***************************************************************************//**
- * \brief  Output log messages to streams
+ * \brief  Drop partial lines of an ID.
  *
- * Print the log message to all outputs registered. It is possible to do
- * repeated prints to the same line by omitting '\n' in the log message format
- * sting. In this case a subsequent call will be appended without prefix. Only
- * print the message if
+ * Threads notice the changed line generation of the ID the next time they
+ * collect a partial line.
  *
- *   - logging is globally enabled.
- *   - logging ID is enabled.
- *   - logging level is enabled.
+ * \param[in]     id      ID whose partial lines are dropped.
+ ******************************************************************************/
+LOGGER_INLINE void logger_continuation_drop(logger_id_t id)
+{
+  LOGGER_ATOMIC_ADD(&logger_control[id].line_generation, 1);
+}
+
+
+/***************************************************************************//**
+ * \brief  Keep a message that is not printed.
+ *
+ * The prefix is formatted now so the kept message shows the time it was
+ * logged. If the ID already keeps its maximum number of messages its oldest
+ * one is replaced. Otherwise a free slot is used or, if there is none, the
+ * oldest message of all IDs. Called with \c logger_lazy_mutex locked.
  *
  * \param[in]     id        ID outputting this message.
+ * \param[in]     plan      Output plan of the ID.
  * \param[in]     level     Level of this message.
- * \param[in]     outputs   List of logger outputs.
- * \param[in]     size      Number of elements in output list.
- * \param[in]     prefix    Formatted message prefix.
+ * \param[in]     file      Name of file where this call happened.
+ * \param[in]     function  Name of function where this call happened.
+ * \param[in]     line      Line where this call happened.
  * \param[in]     message   Formatted message.
- *
- * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_output(logger_id_t     id,
-                                            logger_level_t  level,
-                                            logger_output_t *outputs,
-                                            size_t          size,
-                                            const char      *prefix,
-                                            const char      *message)
+LOGGER_INLINE void logger_lazy_put(logger_id_t         id,
+                                   const logger_plan_t *plan,
+                                   logger_level_t      level,
+                                   const char          *file,
+                                   const char          *function,
+                                   uint32_t            line,
+                                   const char          *message)
 {
-  size_t                index;
-  logger_bool_t         prefix_color_print_begin;
-  logger_bool_t         prefix_color_print_end;
-  logger_color_string_t *prefix_color;
-  logger_bool_t         message_color_print_begin;
-  logger_bool_t         message_color_print_end;
-  logger_color_string_t *message_color;
-  size_t                line_characters;
-  char                  *line;
-  size_t                line_size;
+  logger_lazy_t *slot      = NULL;
+  logger_lazy_t *oldest    = NULL;
+  logger_lazy_t *oldest_id = NULL;
+  uint16_t      count      = 0;
+  size_t        index;
 
-  /* loop over all possible outputs */
-  for (index = 0 ; index < size ; index++) {
-    if ((outputs[index].count > 0) &&
-        ((outputs[index].level & level) != 0)) {
-      /* set colors */
-      if (outputs[index].use_color == logger_true) {
-        /* message color */
-        if ((logger_color_prefix_enabled == logger_false) &&
-            (logger_color_message_enabled == logger_false)) {
-          prefix_color_print_begin  = logger_false;
-          prefix_color_print_end    = logger_false;
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_lazy) ; index++) {
+    if (logger_lazy[index].used == logger_false) {
+      if (slot == NULL) {
+        slot = &logger_lazy[index];
+      }
+    }
+    else {
+      /* sequence numbers may wrap, compare their distance */
+      if ((oldest == NULL) ||
+          ((int32_t)(logger_lazy[index].sequence - oldest->sequence) < 0)) {
+        oldest = &logger_lazy[index];
+      }
 
-          message_color_print_begin = logger_false;
-          message_color_print_end   = logger_false;
-        }
-        else {
-          if ((logger_color_prefix_enabled == logger_true) &&
-              (logger_color_message_enabled == logger_false)) {
-            prefix_color_print_begin = logger_true;
-            prefix_color_print_end   = logger_true;
-            prefix_color             = &logger_level_colors[logger_level_to_index(level)];
+      if (logger_lazy[index].id == id) {
+        count++;
 
-            message_color_print_begin = logger_false;
-            message_color_print_end   = logger_false;
-          }
-          else {
-            if ((logger_color_prefix_enabled == logger_false) &&
-                (logger_color_message_enabled == logger_true)) {
-              prefix_color_print_begin = logger_true;
-              prefix_color_print_end   = logger_false;
-              prefix_color             = &logger_control[id].color_string;
-
-              message_color_print_begin = logger_false;
-              message_color_print_end   = logger_true;
-              message_color             = &logger_control[id].color_string;
-            }
-            else {
-              if ((logger_color_prefix_enabled == logger_true) &&
-                  (logger_color_message_enabled == logger_true)) {
-                prefix_color_print_begin = logger_true;
-                prefix_color_print_end   = logger_true;
-                prefix_color             = &logger_level_colors[logger_level_to_index(level)];
-
-                message_color_print_begin = logger_true;
-                message_color_print_end   = logger_true;
-                message_color             = &logger_control[id].color_string;
-              }
-              else {
-                prefix_color_print_begin = logger_false;
-                prefix_color_print_end   = logger_false;
-
-                message_color_print_begin = logger_false;
-                message_color_print_end   = logger_false;
-              }
-            }
-          }
+        if ((oldest_id == NULL) ||
+            ((int32_t)(logger_lazy[index].sequence - oldest_id->sequence) < 0)) {
+          oldest_id = &logger_lazy[index];
         }
+      }
+    }
+  }
 
-        /* modify color printing for continued messages if color setting had not been changed since the last call */
-        if (logger_control[id].color_string_changed == logger_false) {
-          if (logger_control[id].append == logger_true &&
-              prefix[0] != '\0') {
-            /* first message in a continued message */
-            /* prefix_color_print_begin unchanged */
-            /* prefix_color_print_end unchanged */
+  if (count >= logger_control[id].lazy_count) {
+    slot = oldest_id;
+  }
+  else if (slot == NULL) {
+    slot = oldest;
+  }
 
-            /* message_color_print_begin unchanged */
-            message_color_print_end   = logger_false;
-          }
-          else {
-            if (logger_control[id].append == logger_true &&
-                prefix[0] == '\0') {
-              /* inner message in a continued message */
-              prefix_color_print_begin = logger_false;
-              prefix_color_print_end   = logger_false;
-
-              message_color_print_begin = logger_false;
-              message_color_print_end   = logger_false;
-            }
-            else {
-              if (logger_control[id].append == logger_false &&
-                  prefix[0] == '\0') {
-                /* last message in a continued message */
-                prefix_color_print_begin = logger_false;
-                prefix_color_print_end   = logger_false;
-
-                message_color_print_begin = logger_false;
-                /* message_color_print_end unchanged */
-              }
-              else {
-              }
-            }
-          }
-        }
-      }
-      else {
-        prefix_color_print_begin = logger_false;
-        prefix_color_print_end   = logger_false;
+  slot->used     = logger_true;
+  slot->id       = id;
+  slot->level    = level;
+  slot->sequence = ++logger_lazy_sequence;
 
-        message_color_print_begin = logger_false;
-        message_color_print_end   = logger_false;
-      }
+  /* a kept message always starts a new line */
+  (void)logger_format_date(logger_date, sizeof(logger_date));
+  (void)logger_format_prefix(id, plan, slot->prefix, sizeof(slot->prefix), level, file, function, line, logger_false);
 
-      /* initialize variables */
-      line      = logger_line;
-      line_size = sizeof(logger_line);
+  slot->file     = file;
+  slot->function = function;
+  slot->line     = line;
+  slot->time     = (int64_t)time(NULL);
+  (void)logger_string_copy(slot->date, logger_date, sizeof(slot->date));
 
-      if (prefix_color_print_begin == logger_true) {
-        line_characters = logger_string_copy(line, prefix_color->begin, line_size);
-        line           += line_characters;
-        line_size      -= line_characters;
-      }
+  (void)logger_string_copy(slot->message, message, sizeof(slot->message));
+  slot->message[sizeof(slot->message) - 1] = '\0';
+}
 
-      /* actually output prefix */
-      line_characters = logger_string_copy(line, prefix, line_size);
-      line           += line_characters;
-      line_size      -= line_characters;
 
-      if (prefix_color_print_end == logger_true) {
-        line_characters = logger_string_copy(line, prefix_color->end, line_size);
-        line           += line_characters;
-        line_size      -= line_characters;
-      }
+/***************************************************************************//**
+ * \brief  Print kept messages of an ID.
+ *
+ * Messages are printed oldest first and are dropped afterwards. Called with
+ * \c logger_lazy_mutex locked.
+ *
+ * \param[in]     id      ID whose kept messages are printed.
+ * \param[in]     plan    Output plan of the ID.
+ ******************************************************************************/
+LOGGER_INLINE void logger_lazy_flush(logger_id_t         id,
+                                     const logger_plan_t *plan)
+{
+  logger_lazy_t   *oldest;
+  logger_origin_t origin;
+  logger_bool_t   printed = logger_false;
+  char            *message_part;
+  char            *message_end;
+  size_t          index;
+
+  do {
+    oldest = NULL;
 
-      if (message_color_print_begin == logger_true) {
-        line_characters = logger_string_copy(line, message_color->begin, line_size);
-        line           += line_characters;
-        line_size      -= line_characters;
+    for (index = 0 ; index < LOGGER_ELEMENTS(logger_lazy) ; index++) {
+      if ((logger_lazy[index].used == logger_true) &&
+          (logger_lazy[index].id == id) &&
+          ((oldest == NULL) ||
+           ((int32_t)(logger_lazy[index].sequence - oldest->sequence) < 0))) {
+        oldest = &logger_lazy[index];
       }
+    }
 
-      /* actually output message */
-      line_characters = logger_string_copy(line, message, line_size);
-      line           += line_characters;
-      line_size      -= line_characters;
+    if (oldest != NULL) {
+      if (printed == logger_false) {
+        /* output repeat message */
+        (void)pthread_mutex_lock(&logger_repeat_mutex);
+        logger_repeat_message();
+        (void)pthread_mutex_unlock(&logger_repeat_mutex);
 
-      if (message_color_print_end == logger_true) {
-        line_characters = logger_string_copy(line, message_color->end, line_size);
-        line           += line_characters;
-        line_size      -= line_characters;
+        printed = logger_true;
       }
 
-      /* print '\n' if needed. color reset needs to be printed before '\n', otherwise some terminals show wrong colors in next line */
-      if (logger_control[id].append == logger_false) {
-        line_characters = logger_string_copy(line, "\n", line_size);
-        line           += line_characters;
-        line_size      -= line_characters;
-      }
+      LOGGER_COUNTER_ADD(&logger_control[id].stats[logger_stats_shard()][logger_level_to_index(oldest->level)].emitted, 1);
 
-      /* make sure line is '\0' terminated */
-      logger_line[sizeof(logger_line) - 1] = '\0';
+      /* JSON lines show the time the message was logged */
+      origin.date     = oldest->date;
+      origin.time     = oldest->time;
+      origin.file     = oldest->file;
+      origin.function = oldest->function;
+      origin.line     = oldest->line;
 
-      switch(outputs[index].type) {
-        case LOGGER_OUTPUT_TYPE_UNKNOWN:
-          /* nothing */
-          break;
+      /* initialize message pointer */
+      message_part = oldest->message;
 
-        case LOGGER_OUTPUT_TYPE_FILESTREAM:
-          /* put the message to stream */
-          (void)fputs(logger_line, outputs[index].stream);
-#ifdef LOGGER_FORCE_FLUSH
-          (void)fflush(outputs[index].stream);
-#endif  /* LOGGER_FORCE_FLUSH */
-          break;
+      /* loop over all message parts */
+      do {
+        /* search for the next linefeed */
+        message_end = strchr(message_part, '\n');
 
-        case LOGGER_OUTPUT_TYPE_FUNCTION:
-          /* call user provided function */
-          (*outputs[index].function)(logger_line);
-          break;
+        if (message_end != NULL) {
+          /* replace linefeed with string end */
+          *message_end = '\0';
 
-        case LOGGER_OUTPUT_TYPE_MAX:
-          /* nothing */
-          break;
+          /* make message_end point to the next message part */
+          message_end++;
+        }
+
+        /* output message to id unified outputs, kept messages are complete lines */
+        (void)logger_output(id, oldest->level, plan, logger_false, &origin, oldest->prefix, message_part, NULL);
+
+        /* update message part for next loop */
+        message_part = message_end;
       }
+      while (message_part != NULL);
+
+      oldest->used = logger_false;
     }
   }
+  while (oldest != NULL);
 
-  /* reset the color string changed flag */
-  logger_control[id].color_string_changed = logger_false;
-
-  return(LOGGER_OK);
+  if (printed == logger_true) {
+    /* printed messages interrupt a repeated message */
+    (void)pthread_mutex_lock(&logger_repeat_mutex);
+    logger_repeat.id = logger_id_unknown;
+    (void)pthread_mutex_unlock(&logger_repeat_mutex);
+  }
 }
 
 
 /***************************************************************************//**
- * \brief  Print repeat message.
+ * \brief  Drop kept messages of an ID.
  *
- * When a message repeats several times the message is only printed once by
- * logger_implementation_common(). When a different message should be printed
- * or outputs change this function will print the number of repeats.
+ * Called with \c logger_lazy_mutex locked.
+ *
+ * \param[in]     id      ID whose kept messages are dropped.
  ******************************************************************************/
-LOGGER_INLINE void logger_repeat_message(void)
+LOGGER_INLINE void logger_lazy_drop(logger_id_t id)
 {
-  if (logger_repeat.count > 0) {
-    char repeat_prefix[LOGGER_PREFIX_STRING_MAX];
-    char repeat_message[LOGGER_MESSAGE_STRING_MAX];
-
-    /* generate an empty prefix */
-    memset(repeat_prefix, ' ', logger_repeat.prefix_length);
-    repeat_prefix[logger_repeat.prefix_length] = '\0';
+  size_t index;
 
-    /* generate string that contains number of repeats */
-    if (logger_repeat.count == 1) {
-      (void)snprintf(repeat_message, sizeof(repeat_message), "  -> previous message repeated %" PRIu16 " more time", logger_repeat.count);
+  for (index = 0 ; index < LOGGER_ELEMENTS(logger_lazy) ; index++) {
+    if (logger_lazy[index].id == id) {
+      logger_lazy[index].used = logger_false;
     }
-    else {
-      (void)snprintf(repeat_message, sizeof(repeat_message), "  -> previous message repeated %" PRIu16 " more times", logger_repeat.count);
-    }
-
-    /* output message */
-    (void)logger_output(logger_repeat.id, logger_repeat.level, logger_control[logger_repeat.id].unified_outputs, LOGGER_ELEMENTS(logger_control[logger_repeat.id].unified_outputs), repeat_prefix, repeat_message);
-
-    /* reset repeat members */
-    logger_repeat.count = 0;
-    logger_repeat.id    = logger_id_unknown;
-    logger_repeat.level = LOGGER_UNKNOWN;
   }
 }
 
 
 /***************************************************************************//**
- * \brief  Print rate limit message message.
+ * \brief  Format and print an accepted log message.
  *
- * When a message is not printed because of a rate limit print the number of
- * skipped messages.
+ * Formats in storage of the calling thread, only limits, kept messages and
+ * repeat detection are locked. Called with the thread marked as printing, see
+ * \c logger_print_lock().
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happend.
+ * \param[in]     function  Name of function where this call happend.
+ * \param[in]     line      Line where this call happend.
+ * \param[in]     kind      Kind of call site limit.
+ * \param[in]     value     Parameter of call site limit.
+ * \param[in]     plan      Output plan of the ID.
+ * \param[in,out] stats     Statistics of ID and level of this message.
+ * \param[in,out] profile   Profiled call site, NULL if not profiled.
+ * \param[in,out] kv        Structured message used instead of format and
+ *                          argp, NULL for \c printf() like messages.
+ * \param[in]     format    \c printf() like format string.
+ * \param[in]     argp      variable argument list pointer
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE void logger_rate_limit_message(logger_bool_t force)
+LOGGER_INLINE logger_return_t logger_implementation_print(logger_id_t           id,
+                                                          logger_level_t        level,
+                                                          const char            *file,
+                                                          const char            *function,
+                                                          uint32_t              line,
+                                                          logger_site_kind_t    kind,
+                                                          uint32_t              value,
+                                                          const logger_plan_t   *plan,
+                                                          logger_stats_t        *stats,
+                                                          logger_profile_site_t *profile,
+                                                          logger_kv_list_t      *kv,
+                                                          const char            *format,
+                                                          va_list               argp)
 {
-  /* check if message should be printed */
-  if ((logger_limit.message_request == logger_true) ||
-      ((force == logger_true) && (logger_limit.skipped > 0))) {
-    char limit_prefix[LOGGER_PREFIX_STRING_MAX];
-    char limit_message[LOGGER_MESSAGE_STRING_MAX];
+  logger_site_t   *site    = NULL;
+  logger_bucket_t *level_bucket;
+  logger_bool_t   limited  = logger_false;
+  logger_bool_t   checked;
+  logger_bool_t   exempt;
+  logger_bool_t   append;
+  logger_bool_t   completed;
+  logger_bool_t   emit     = logger_false;
+
+  level_bucket = &logger_level_buckets[logger_level_to_index(level)];
+  exempt       = ((LOGGER_ATOMIC_LOAD(&logger_limit.exempt) & level) != 0) ? logger_true : logger_false;
+
+  /* check call site limit before anything else is spent on the message */
+  if (kind != LOGGER_SITE_NONE) {
+    site = logger_site_find(file, line);
+  }
+
+  /* limits are shared by all threads, lock them only if any is set */
+  checked = ((site != NULL) ||
+             (LOGGER_ATOMIC_LOAD(&logger_limit.limit) > 0) ||
+             (LOGGER_ATOMIC_LOAD(&logger_control[id].bucket.rate) > 0) ||
+             (LOGGER_ATOMIC_LOAD(&level_bucket->rate) > 0)) ? logger_true : logger_false;
+
+  if (checked == logger_true) {
+    (void)pthread_mutex_lock(&logger_limit_mutex);
+
+    if (site != NULL) {
+      limited = logger_check_site_limit(site, kind, value);
+    }
 
-    /* generate system empty prefix */
-    strncpy(limit_prefix, "LOGGER SYSTEM MESSAGE: ", LOGGER_ELEMENTS(limit_prefix));
+    /* check rate limits, only printed messages count, the global limit only sees messages passing the buckets */
+    if ((limited == logger_false) &&
+        (exempt == logger_false) &&
+        ((logger_check_bucket_limit(id, level) == logger_true) ||
+         (logger_check_rate_limit() == logger_true))) {
+      limited = logger_true;
+    }
 
-    /* generate string that contains number of repeats */
-    if (logger_limit.skipped == 1) {
-      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " message skipped because of rate limit (%" PRIu16 " messages per second)", logger_limit.skipped, logger_limit.limit);
+    (void)pthread_mutex_unlock(&logger_limit_mutex);
+  }
+
+  /* GUARD: limited messages are only kept in flight recorder */
+  if (limited == logger_true) {
+    logger_recorder_message(id, level, file, function, line, kv, format, argp);
+
+    LOGGER_COUNTER_ADD(&stats->rate_limited, 1);
+    LOGGER_PROBE3(rate_limited, id, level, logger_control[id].name);
+    return(LOGGER_ERR_RATE_LIMIT);
+  }
+
+  /* print kept messages before a message at trigger level */
+  if ((LOGGER_ATOMIC_LOAD(&logger_control[id].lazy_count) > 0) &&
+      ((LOGGER_ATOMIC_LOAD(&logger_control[id].lazy_trigger) & level) != 0)) {
+    (void)pthread_mutex_lock(&logger_lazy_mutex);
+    logger_lazy_flush(id, plan);
+    (void)pthread_mutex_unlock(&logger_lazy_mutex);
+  }
+
+  /* format date, record outputs don't need it */
+  if ((plan->line_level & level) != 0) {
+    (void)logger_format_date(logger_date, sizeof(logger_date));
+  }
+
+  /* format prefix, only text outputs print it */
+  if ((plan->text_level & level) != 0) {
+    (void)logger_format_prefix(id, plan, logger_prefix, sizeof(logger_prefix), level, file, function, line, LOGGER_ATOMIC_LOAD(&logger_control[id].append));
+  }
+  else {
+    logger_prefix[0] = '\0';
+  }
+
+  /* format message, structured messages are a single line of text */
+  if (kv != NULL) {
+    logger_kv_render(logger_message, sizeof(logger_message), kv, LOGGER_KV_FORMAT_TEXT);
+    append = logger_false;
+  }
+  else {
+    if (logger_format_message(logger_message, sizeof(logger_message), &append, format, argp) == LOGGER_ERR_STRING_TOO_LONG) {
+      LOGGER_COUNTER_ADD(&stats->truncated, 1);
     }
-    else {
-      (void)snprintf(limit_message, sizeof(limit_message), "%" PRIu16 " messages skipped because of rate limit (%" PRIu16 " messages per second)", logger_limit.skipped, logger_limit.limit);
+  }
+
+  LOGGER_ATOMIC_STORE(&logger_control[id].append, append);
+
+  /* keep message in flight recorder */
+  if ((logger_recorder.level & level) != 0) {
+    logger_recorder_put(id, level, file, function, line, logger_message);
+  }
+
+  /* collect partial lines per thread, print whole lines only */
+  if (LOGGER_ATOMIC_LOAD(&logger_control[id].line_buffer) == logger_true) {
+    if (logger_continuation_collect(id, append, &level, &completed, stats) == logger_true) {
+      return(LOGGER_OK);
     }
 
-    /* output message */
-    (void)logger_output(logger_system_id, LOGGER_EMERG, logger_control[logger_system_id].unified_outputs, LOGGER_ELEMENTS(logger_control[logger_system_id].unified_outputs), limit_prefix, limit_message);
+    /* a completed partial line is printed as text everywhere */
+    if (completed == logger_true) {
+      kv = NULL;
+    }
+  }
 
-    /* reset message request */
-    logger_limit.message_request = logger_false;
+  (void)pthread_mutex_lock(&logger_repeat_mutex);
 
-    /* reset skip counter */
-    logger_limit.skipped = 0;
+  /* check if message is the same as previous message */
+  if ((strncmp(logger_message, logger_repeat.message, sizeof(logger_message)) == 0) &&
+      (id == logger_repeat.id) &&
+      (level == logger_repeat.level)) {
+    /* increase repeat counter */
+    logger_repeat.count++;
+    LOGGER_COUNTER_ADD(&stats->repeat_suppressed, 1);
+    LOGGER_PROBE3(repeat_suppressed, id, level, logger_control[id].name);
+
+    /* don't output message */
   }
-}
+  else if ((LOGGER_ATOMIC_LOAD(&logger_repeat_window) > 0) &&
+           (logger_fingerprint_check(id, level, file, line, logger_message, strlen(logger_prefix)) == logger_true)) {
+    /* message was printed recently, don't output message */
+    LOGGER_COUNTER_ADD(&stats->repeat_suppressed, 1);
+    LOGGER_PROBE3(repeat_suppressed, id, level, logger_control[id].name);
+  }
+  else {
+    emit = logger_true;
 
+    /* store id and level */
+    logger_repeat.id = id;
+    logger_repeat.level = level;
 
-/***************************************************************************//**
- * \brief  Check if rate limit is exceeded.
- *
- * Check if rate limit is exceeded and return `logger_true` in that case.
- * Additionally request a rate limit message.
- *
- * \return        \c logger_true if rate limit is exceeded.
- ******************************************************************************/
-LOGGER_INLINE logger_bool_t logger_check_rate_limit(void)
-{
-  static time_t previous_time = 0;
-  time_t        current_time;
-  time_t        diff_time;
+    /* calculate length of prefix string */
+    logger_repeat.prefix_length = strlen(logger_prefix);
 
-  /* get current time */
-  current_time = time(NULL);
+    /* copy new message to storage */
+    (void)logger_string_copy(logger_repeat.message, logger_message, sizeof(logger_repeat.message));
 
-  /* time difference */
-  diff_time = current_time - previous_time;
+    /* output repeat message */
+    logger_repeat_message();
+  }
 
-  /* check if time has changed */
-  if (diff_time != 0) {
-    if (logger_limit.exceeded == logger_true) {
-      /* request message printing */
-      logger_limit.message_request = logger_true;
+  (void)pthread_mutex_unlock(&logger_repeat_mutex);
 
-      /* reset counter */
-      logger_limit.counter = 0;
+  if (emit == logger_true) {
+    logger_origin_t origin;
+    char            *message_part;
+    char            *message_end;
+
+    origin.date     = logger_date;
+    origin.time     = (int64_t)time(NULL);
+    origin.file     = file;
+    origin.function = function;
+    origin.line     = line;
+
+    LOGGER_COUNTER_ADD(&stats->emitted, 1);
+
+    if (checked == logger_true) {
+      (void)pthread_mutex_lock(&logger_limit_mutex);
+
+      /* only printed messages take a token */
+      if (exempt == logger_false) {
+        logger_bucket_take(id, level);
+      }
+
+      /* output rate limit message */
+      logger_rate_limit_message(logger_false);
+      logger_bucket_message(&logger_control[id].bucket, "ID", logger_control[id].name);
+      logger_bucket_message(level_bucket, "level", logger_level_name_get(level));
+      if (site != NULL) {
+        logger_site_message(site);
+      }
+      (void)pthread_mutex_unlock(&logger_limit_mutex);
     }
 
-    /* update previous time */
-    previous_time = current_time;
-  }
+    /* initialize message pointer */
+    message_part = logger_message;
 
-  /* increment counter */
-  logger_limit.counter++;
+    /* bytes written by logger_output() count for the call site */
+    logger_profile_current = profile;
 
-  /* check if limit is exceeded */
-  if ((logger_limit.limit > 0) &&
-      ((logger_limit.counter / (diff_time + 1)) > logger_limit.limit)) {
-    logger_limit.exceeded = logger_true;
+    /* loop over all message parts */
+    do {
+      /* search for the next linefeed */
+      message_end = strchr(message_part, '\n');
 
-      /* add number of skipped messages */
-      logger_limit.skipped++;
+      if (message_end != NULL) {
+        /* replace linefeed with string end */
+        *message_end = '\0';
+
+        /* make message_end point to the next message part */
+        message_end++;
+      }
+
+      /* output message to id unified outputs */
+      (void)logger_output(id, level, plan, append, &origin, logger_prefix, message_part, kv);
+
+      if (profile != NULL) {
+        LOGGER_COUNTER_ADD(&profile->lines, 1);
+      }
+
+      /* update message part for next loop */
+      message_part = message_end;
+    }
+    while (message_part != NULL);
 
-  }
-  else {
-    logger_limit.exceeded = logger_false;
+    logger_profile_current = NULL;
   }
 
-  return(logger_limit.exceeded);
+  return(LOGGER_OK);
 }
 
 
@@ -3989,19 +12926,31 @@ LOGGER_INLINE logger_bool_t logger_check_rate_limit(void)
  * \param[in]     file      Name of file where this call happend.
  * \param[in]     function  Name of function where this call happend.
  * \param[in]     line      Line where this call happend.
+ * \param[in]     kind      Kind of call site limit.
+ * \param[in]     value     Parameter of call site limit.
+ * \param[in,out] kv        Structured message used instead of format and
+ *                          argp, NULL for \c printf() like messages.
  * \param[in]     format    \c printf() like format string.
  * \param[in]     argp      variable argument list pointer
  *
  * \return        \c LOGGER_OK if no error occurred, error code otherwise.
  ******************************************************************************/
-LOGGER_INLINE logger_return_t logger_implementation_common(logger_id_t    id,
-                                                           logger_level_t level,
-                                                           const char     *file,
-                                                           const char     *function,
-                                                           uint32_t       line,
-                                                           const char     *format,
-                                                           va_list        argp)
+LOGGER_INLINE logger_return_t logger_implementation_message(logger_id_t        id,
+                                                            logger_level_t     level,
+                                                            const char         *file,
+                                                            const char         *function,
+                                                            uint32_t           line,
+                                                            logger_site_kind_t kind,
+                                                            uint32_t           value,
+                                                            logger_kv_list_t   *kv,
+                                                            const char         *format,
+                                                            va_list            argp)
 {
+  logger_profile_site_t *profile = NULL;
+  const logger_plan_t   *plan;
+  logger_stats_t        *stats;
+  logger_return_t       ret;
+
   /* GUARD: check for valid ID */
   if ((id < 0) ||
       (id == logger_system_id) ||
@@ -4030,77 +12979,60 @@ LOGGER_INLINE logger_return_t logger_implementation_common(logger_id_t    id,
     return(LOGGER_ERR_FORMAT_INVALID);
   }
 
-  /* GUARD: check rate limit */
-  if (logger_check_rate_limit() == logger_true) {
-    return(LOGGER_ERR_RATE_LIMIT);
-  }
-
-  /* check if ID is enabled and level is enabled */
-  if ((logger_enabled == logger_true) &&
-      (logger_control[id].enabled == logger_true) &&
-      ((logger_control[id].level & level) != 0)) {
-
-    /* format date */
-    (void)logger_format_date(logger_date, sizeof(logger_date));
-
-    /* format prefix */
-    (void)logger_format_prefix(id, logger_prefix, sizeof(logger_prefix), level, file, function, line);
+  stats = &logger_control[id].stats[logger_stats_shard()][logger_level_to_index(level)];
+  plan  = LOGGER_ATOMIC_LOAD(&logger_control[id].plan);
 
-    /* format message */
-    (void)logger_format_message(id, logger_message, sizeof(logger_message), format, argp);
+  /* count every call of a call site, printed or not */
+  if (LOGGER_ATOMIC_LOAD(&logger_profile_enabled) == logger_true) {
+    profile = logger_profile_find(file, function, line);
 
-    /* check if message is the same as previous message */
-    if ((strncmp(logger_message, logger_repeat.message, sizeof(logger_message)) == 0) &&
-        (id == logger_repeat.id) &&
-        (level == logger_repeat.level)) {
-      /* increase repeat counter */
-      logger_repeat.count++;
-
-      /* don't output message */
+    if (profile != NULL) {
+      LOGGER_COUNTER_ADD(&profile->calls, 1);
     }
     else {
-      char *message_part;
-      char *message_end;
-
-      /* store id and level */
-      logger_repeat.id = id;
-      logger_repeat.level = level;
+      LOGGER_COUNTER_ADD(&logger_profile_untracked, 1);
+    }
+  }
 
-      /* calculate length of prefix string */
-      logger_repeat.prefix_length = strlen(logger_prefix);
+  /* check if ID is enabled and level is enabled, for this thread at least */
+  if ((plan->enabled == logger_true) &&
+      (((plan->level | logger_thread_level | logger_thread_levels[id]) & level) != 0)) {
+    LOGGER_COUNTER_ADD(&stats->accepted, 1);
+    LOGGER_PROBE3(accepted, id, level, logger_control[id].name);
 
-      /* copy new message to storage */
-      logger_string_copy(logger_repeat.message, logger_message, sizeof(logger_repeat.message));
+    /* GUARD: an output of this thread logs, it would wait for itself */
+    if (logger_print_lock(NULL) == logger_false) {
+      return(LOGGER_ERR_REENTRANT);
+    }
 
-      /* output repeat message */
-      logger_repeat_message();
+    ret = logger_implementation_print(id, level, file, function, line, kind, value, plan, stats, profile, kv, format, argp);
 
-      /* output rate limit message */
-      logger_rate_limit_message(logger_false);
+    logger_print_unlock(NULL);
 
-      /* initialize message pointer */
-      message_part = logger_message;
+    return(ret);
+  }
 
-      /* loop over all message parts */
-      do {
-        /* search for the next linefeed */
-        message_end = strchr(message_part, '\n');
+  LOGGER_COUNTER_ADD(&stats->filtered, 1);
+  LOGGER_PROBE3(filtered, id, level, logger_control[id].name);
 
-        if (message_end != NULL) {
-          /* replace linefeed with string end */
-          *message_end = '\0';
+  /* messages not printed are still kept in flight recorder and for lazy output */
+  if (plan->enabled == logger_true) {
+    if (LOGGER_ATOMIC_LOAD(&logger_control[id].lazy_count) > 0) {
+      char message[LOGGER_MESSAGE_STRING_MAX];
 
-          /* make message_end point to the next message part */
-          message_end++;
-        }
+      logger_format_quiet(message, sizeof(message), kv, format, argp);
 
-        /* output message to id unified outputs */
-        (void)logger_output(id, level, logger_control[id].unified_outputs, LOGGER_ELEMENTS(logger_control[logger_system_id].unified_outputs), logger_prefix, message_part);
+      if ((logger_recorder.level & level) != 0) {
+        logger_recorder_put(id, level, file, function, line, message);
+      }
 
-        /* update message part for next loop */
-        message_part = message_end;
+      if (logger_print_lock(&logger_lazy_mutex) == logger_true) {
+        logger_lazy_put(id, plan, level, file, function, line, message);
+        logger_print_unlock(&logger_lazy_mutex);
       }
-      while (message_part != NULL);
+    }
+    else {
+      logger_recorder_message(id, level, file, function, line, kv, format, argp);
     }
   }
 
@@ -4108,6 +13040,47 @@ LOGGER_INLINE logger_return_t logger_implementation_common(logger_id_t    id,
 }
 
 
+/***************************************************************************//**
+ * \brief  Print log message with consistent outputs.
+ *
+ * Reads the output plans of IDs only inside a read section, so outputs can be
+ * changed by other threads while the message is printed without locking.
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happend.
+ * \param[in]     function  Name of function where this call happend.
+ * \param[in]     line      Line where this call happend.
+ * \param[in]     kind      Kind of call site limit.
+ * \param[in]     value     Parameter of call site limit.
+ * \param[in,out] kv        Structured message used instead of format and
+ *                          argp, NULL for \c printf() like messages.
+ * \param[in]     format    \c printf() like format string.
+ * \param[in]     argp      variable argument list pointer
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+LOGGER_INLINE logger_return_t logger_implementation_common(logger_id_t        id,
+                                                           logger_level_t     level,
+                                                           const char         *file,
+                                                           const char         *function,
+                                                           uint32_t           line,
+                                                           logger_site_kind_t kind,
+                                                           uint32_t           value,
+                                                           logger_kv_list_t   *kv,
+                                                           const char         *format,
+                                                           va_list            argp)
+{
+  logger_return_t ret;
+
+  logger_plan_read_lock();
+  ret   = logger_implementation_message(id, level, file, function, line, kind, value, kv, format, argp);
+  logger_plan_read_unlock();
+
+  return(ret);
+}
+
+
 /***************************************************************************//**
  * \brief  Print log message.
  *
@@ -4140,9 +13113,12 @@ logger_return_t logger_implementation(logger_id_t    id,
 {
   logger_return_t ret;
   va_list         argp;
+  uint64_t        start;
 
   va_start(argp, format);
-  ret = logger_implementation_common(id, level, file, function, line, format, argp);
+  start = logger_latency_now();
+  ret   = logger_implementation_common(id, level, file, function, line, LOGGER_SITE_NONE, 0, NULL, format, argp);
+  logger_latency_call(start);
   va_end(argp);
 
   return(ret);
@@ -4181,13 +13157,396 @@ logger_return_t logger_implementation_va(logger_id_t    id,
                                          va_list        argp)
 {
   logger_return_t ret;
+  uint64_t        start;
+
+  start = logger_latency_now();
+  ret   = logger_implementation_common(id, level, file, function, line, LOGGER_SITE_NONE, 0, NULL, format, argp);
+  logger_latency_call(start);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Print log message with call site limit.
+ *
+ * Like logger_implementation() but the message is only printed if the limit of
+ * the call site allows it. The limit is checked before the message is
+ * formatted. Use the macros logger_every_n(), logger_every_ms() and
+ * logger_sample() instead of calling this function directly. Call sites are
+ * kept in \c LOGGER_SITES_MAX slots, when they are used up new call sites
+ * print every message.
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happend.
+ * \param[in]     function  Name of function where this call happend.
+ * \param[in]     line      Line where this call happend.
+ * \param[in]     kind      Kind of call site limit.
+ * \param[in]     value     Number of messages, interval in milliseconds or
+ *                          probability scaled to \c UINT32_MAX.
+ * \param[in]     format    \c printf() like format string.
+ *
+ * \return        \c LOGGER_OK if no error occurred, \c LOGGER_ERR_RATE_LIMIT if
+ *                the message is skipped, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_implementation_site(logger_id_t        id,
+                                           logger_level_t     level,
+                                           const char         *file,
+                                           const char         *function,
+                                           uint32_t           line,
+                                           logger_site_kind_t kind,
+                                           uint32_t           value,
+                                           const char         *format,
+                                           ...)
+{
+  logger_return_t ret;
+  va_list         argp;
+  uint64_t        start;
+
+  va_start(argp, format);
+  start = logger_latency_now();
+  ret   = logger_implementation_common(id, level, file, function, line, kind, value, NULL, format, argp);
+  logger_latency_call(start);
+  va_end(argp);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Find message built by the calling thread.
+ *
+ * \return        Message builder, NULL if thread builds no message.
+ ******************************************************************************/
+LOGGER_INLINE logger_builder_t *logger_builder_find(void)
+{
+  (void)pthread_once(&logger_thread_once, logger_thread_key_create);
+
+  return((logger_builder_t *)pthread_getspecific(logger_builder_key));
+}
+
+
+/***************************************************************************//**
+ * \brief  Return the slot of a built message.
+ *
+ * \param[in,out] builder   Message builder.
+ ******************************************************************************/
+LOGGER_INLINE void logger_builder_release(logger_builder_t *builder)
+{
+  (void)pthread_mutex_lock(&logger_builder_mutex);
+  builder->used = logger_false;
+  (void)pthread_mutex_unlock(&logger_builder_mutex);
+}
+
+
+/***************************************************************************//**
+ * \brief  Drop the message of an exiting thread.
+ *
+ * Destructor of logger_builder_key.
+ *
+ * \param[in,out] value   Message builder of the thread.
+ ******************************************************************************/
+static void logger_builder_exit(void *value)
+{
+  logger_builder_release((logger_builder_t *)value);
+}
+
+
+/***************************************************************************//**
+ * \brief  Begin a message built from several parts.
+ *
+ * Start a message of the calling thread which is assembled with
+ * logger_msg_appendf() and printed as a single message by logger_msg_commit().
+ * Whether the message is printed is decided here, parts of a message that
+ * isn't printed are not formatted. A message begun before by the same thread
+ * and not committed is dropped. Use the macro logger_msg_begin() instead of
+ * calling this function directly.
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happend.
+ * \param[in]     function  Name of function where this call happend.
+ * \param[in]     line      Line where this call happend.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_msg_begin_implementation(logger_id_t    id,
+                                                logger_level_t level,
+                                                const char     *file,
+                                                const char     *function,
+                                                uint32_t       line)
+{
+  logger_builder_t    *builder;
+  const logger_plan_t *plan;
+  size_t              index;
+
+  /* GUARD: check for valid ID */
+  if ((id < 0) ||
+      (id == logger_system_id) ||
+      (id >= LOGGER_ELEMENTS(logger_control)) ||
+      (logger_control[id].used == logger_false)) {
+    return(LOGGER_ERR_ID_UNKNOWN);
+  }
+
+  /* GUARD: check for valid level */
+  if ((level & ~LOGGER_ALL) != 0) {
+    return(LOGGER_ERR_LEVEL_UNKNOWN);
+  }
+
+  /* GUARD: check for valid file */
+  if (file == NULL) {
+    return(LOGGER_ERR_FILE_INVALID);
+  }
+
+  /* GUARD: check for valid function */
+  if (function == NULL) {
+    return(LOGGER_ERR_FUNCTION_INVALID);
+  }
+
+  builder = logger_builder_find();
+
+  /* search free slot, the thread keeps it until the message is committed */
+  if (builder == NULL) {
+    (void)pthread_mutex_lock(&logger_builder_mutex);
+
+    for (index = 0 ; (builder == NULL) && (index < LOGGER_ELEMENTS(logger_builders)) ; index++) {
+      if (logger_builders[index].used == logger_false) {
+        builder       = &logger_builders[index];
+        builder->used = logger_true;
+      }
+    }
+
+    (void)pthread_mutex_unlock(&logger_builder_mutex);
+
+    /* GUARD: check for free slot */
+    if (builder == NULL) {
+      return(LOGGER_ERR_OUT_OF_MEMORY);
+    }
+
+    /* drop the message if the thread exits before committing it */
+    (void)pthread_setspecific(logger_builder_key, builder);
+  }
+
+  builder->truncated  = logger_false;
+  builder->id         = id;
+  builder->level      = level;
+  builder->file       = file;
+  builder->function   = function;
+  builder->line       = line;
+  builder->length     = 0;
+  builder->message[0] = '\0';
+
+  /* message is needed if printed, recorded or kept */
+  builder->active = logger_id_generates_output(id, level);
+
+  logger_plan_read_lock();
+  plan  = LOGGER_ATOMIC_LOAD(&logger_control[id].plan);
+
+  if ((plan->enabled == logger_true) &&
+      (((logger_recorder.level & level) != 0) ||
+       (logger_control[id].lazy_count > 0))) {
+    builder->active = logger_true;
+  }
+
+  logger_plan_read_unlock();
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Append to message begun by logger_msg_begin().
+ *
+ * \param[in]     format    \c printf() like format string.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_msg_appendf(const char *format,
+                                   ...)
+{
+  logger_builder_t *builder;
+  va_list          argp;
+  int              characters;
+
+  /* GUARD: check for valid format */
+  if (format == NULL) {
+    return(LOGGER_ERR_FORMAT_INVALID);
+  }
+
+  builder = logger_builder_find();
+
+  /* GUARD: check for begun message */
+  if (builder == NULL) {
+    return(LOGGER_ERR_NOT_STARTED);
+  }
+
+  /* nothing to do for messages not printed */
+  if ((builder->active == logger_false) ||
+      (builder->truncated == logger_true)) {
+    return(LOGGER_OK);
+  }
+
+  /* leave room for the '\n' added by logger_msg_commit() */
+  va_start(argp, format);
+  characters = vsnprintf(builder->message + builder->length, sizeof(builder->message) - 1 - builder->length, format, argp);
+  va_end(argp);
+
+  if ((characters < 0) ||
+      ((size_t)characters >= sizeof(builder->message) - 1 - builder->length)) {
+    /* mark truncated message */
+    builder->truncated = logger_true;
+    builder->length    = sizeof(builder->message) - 2;
+    (void)memcpy(&builder->message[builder->length - 3], "...", 3);
+    builder->message[builder->length] = '\0';
+  }
+  else {
+    builder->length += (size_t)characters;
+  }
+
+  return(LOGGER_OK);
+}
+
+
+/***************************************************************************//**
+ * \brief  Print message begun by logger_msg_begin().
+ *
+ * The message is printed like a single logger() call at the position of
+ * logger_msg_begin(). A trailing '\n' is added if missing.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_msg_commit(void)
+{
+  logger_builder_t *builder;
+  logger_return_t  ret = LOGGER_OK;
+
+  builder = logger_builder_find();
+
+  /* GUARD: check for begun message */
+  if (builder == NULL) {
+    return(LOGGER_ERR_NOT_STARTED);
+  }
+
+  if (builder->active == logger_true) {
+    if ((builder->length > 0) &&
+        (builder->message[builder->length - 1] == '\n')) {
+      ret = logger_implementation(builder->id, builder->level, builder->file, builder->function, builder->line, "%s", builder->message);
+    }
+    else {
+      ret = logger_implementation(builder->id, builder->level, builder->file, builder->function, builder->line, "%s\n", builder->message);
+    }
+  }
+
+  (void)pthread_setspecific(logger_builder_key, NULL);
+  logger_builder_release(builder);
+
+  return(ret);
+}
+
+
+/***************************************************************************//**
+ * \brief  Print structured message.
+ *
+ * Passes the structured message to logger_implementation_common(), which needs
+ * a valid argument list even if it isn't used.
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happend.
+ * \param[in]     function  Name of function where this call happend.
+ * \param[in]     line      Line where this call happend.
+ * \param[in,out] kv        Structured message.
+ * \param[in]     format    Unused format string.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+static logger_return_t logger_kv_common(logger_id_t      id,
+                                        logger_level_t   level,
+                                        const char       *file,
+                                        const char       *function,
+                                        uint32_t         line,
+                                        logger_kv_list_t *kv,
+                                        const char       *format,
+                                        ...)
+{
+  logger_return_t ret;
+  va_list         argp;
+  uint64_t        start;
 
-  ret = logger_implementation_common(id, level, file, function, line, format, argp);
+  va_start(argp, format);
+  start = logger_latency_now();
+  ret   = logger_implementation_common(id, level, file, function, line, LOGGER_SITE_NONE, 0, kv, format, argp);
+  logger_latency_call(start);
+  va_end(argp);
 
   return(ret);
 }
 
 
+/***************************************************************************//**
+ * \brief  Print log message with structured fields.
+ *
+ * The fields are typed values which are converted directly without parsing a
+ * format string. Depending on the setting of each output the message is
+ * rendered as text (`message key=value`), logfmt (`msg=message key=value`) or
+ * JSON (`{"msg":"message","key":value}`). Each rendering is done at most once
+ * per message. Flight recorder, lazy output and repeat detection use the text
+ * rendering. Use the macro logger_kv() instead of calling this function
+ * directly.
+ *
+ * \param[in]     id        ID outputting this message.
+ * \param[in]     level     Level of this message.
+ * \param[in]     file      Name of file where this call happend.
+ * \param[in]     function  Name of function where this call happend.
+ * \param[in]     line      Line where this call happend.
+ * \param[in]     message   Message without fields.
+ * \param[in]     fields    Fields of message.
+ * \param[in]     count     Number of fields.
+ *
+ * \return        \c LOGGER_OK if no error occurred, error code otherwise.
+ ******************************************************************************/
+logger_return_t logger_kv_implementation(logger_id_t       id,
+                                         logger_level_t    level,
+                                         const char        *file,
+                                         const char        *function,
+                                         uint32_t          line,
+                                         const char        *message,
+                                         const logger_kv_t *fields,
+                                         size_t            count)
+{
+  logger_kv_list_t kv;
+  size_t           index;
+
+  /* GUARD: check for valid message */
+  if (message == NULL) {
+    return(LOGGER_ERR_STRING_INVALID);
+  }
+
+  /* GUARD: check for valid fields */
+  if ((fields == NULL) &&
+      (count > 0)) {
+    return(LOGGER_ERR_DATA_INVALID);
+  }
+
+  for (index = 0 ; index < count ; index++) {
+    /* GUARD: check for valid key and type */
+    if ((fields[index].key == NULL) ||
+        (fields[index].type < LOGGER_KV_TYPE_U64) ||
+        (fields[index].type > LOGGER_KV_TYPE_STR)) {
+      return(LOGGER_ERR_DATA_INVALID);
+    }
+  }
+
+  kv.message = message;
+  kv.fields  = fields;
+  kv.count   = count;
+  memset(kv.rendered, 0, sizeof(kv.rendered));
+
+  return(logger_kv_common(id, level, file, function, line, &kv, "%s", message));
+}
+
+
 /* helper functions */
 
 
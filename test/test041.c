@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "logger.h"
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  FILE        *logger_stream;
+  char        path[32];
+  int         index;
+
+  /* rotated files of earlier runs would continue their numbering */
+  for (index = 0 ; index < 10 ; index++) {
+    (void)snprintf(path, sizeof(path), "test041.out.%d", index);
+    (void)remove(path);
+  }
+
+  assert(LOGGER_OK == logger_init());
+
+  /* rotate after 200 bytes, keep two rotated files */
+  logger_stream = logger_output_file_open("test041.out", 200, 0, 2);
+  assert(NULL != logger_stream);
+  assert(logger_true == logger_output_file_is_open(logger_stream));
+  assert(logger_false == logger_output_file_is_open(stdout));
+  assert(logger_true == logger_output_is_registered(logger_stream));
+  assert(LOGGER_OK == logger_output_level_set(logger_stream, LOGGER_DEBUG));
+
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_file_rotate(stdout));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_file_close(stdout));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  /* wait for the background rotation after every line */
+  for (index = 0 ; index < 10 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d\n", index));
+    assert(LOGGER_OK == logger_output_flush());
+  }
+
+  assert(LOGGER_OK == logger_output_file_close(logger_stream));
+  assert(logger_false == logger_output_file_is_open(logger_stream));
+  assert(logger_false == logger_output_is_registered(logger_stream));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
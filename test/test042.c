@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include "logger.h"
+
+static void decompress(const char *source_name, const char *destination_name)
+{
+  FILE *source;
+  FILE *destination;
+
+  source      = fopen(source_name, "rb");
+  destination = fopen(destination_name, "wb");
+  assert(NULL != source);
+  assert(NULL != destination);
+  assert(LOGGER_OK == logger_decompress(source, destination));
+  fclose(source);
+  fclose(destination);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t               id = logger_id_unknown;
+  logger_file_queue_stats_t queue;
+  FILE                      *logger_stream;
+  FILE                      *reference_stream;
+  FILE                      *reference;
+  FILE                      *result;
+  FILE                      *garbage;
+  int                       index;
+  int                       character;
+
+  assert(LOGGER_OK == logger_init());
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  /* rotate after 200 bytes and compress rotated files */
+  logger_stream = logger_output_file_open("test042.out", 200, 0, 0);
+  assert(NULL != logger_stream);
+  assert(logger_false == logger_output_file_compression_is_enabled(logger_stream));
+  assert(LOGGER_OK == logger_output_file_compression_enable(logger_stream));
+  assert(logger_true == logger_output_file_compression_is_enabled(logger_stream));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_file_compression_enable(stdout));
+  assert(LOGGER_OK == logger_output_level_set(logger_stream, LOGGER_DEBUG));
+
+  /* wait for the background rotation after every line */
+  for (index = 0 ; index < 7 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d\n", index));
+    assert(LOGGER_OK == logger_output_flush());
+  }
+
+  assert(LOGGER_OK == logger_output_file_close(logger_stream));
+
+  /* every rotation and compression was queued and is done */
+  assert(LOGGER_ERR_OUTPUT_INVALID == logger_output_file_queue_stats_get(NULL));
+  assert(LOGGER_OK == logger_output_file_queue_stats_get(&queue));
+  assert(0 == queue.queued);
+  assert(1 <= queue.peak);
+  assert(0 == queue.dropped);
+
+  /* rotated files are only available compressed */
+  assert(NULL == fopen("test042.out.1", "r"));
+  assert(NULL == fopen("test042.out.2", "r"));
+  decompress("test042.out.1.lz", "test042.out.1");
+  decompress("test042.out.2.lz", "test042.out.2");
+
+  /* several blocks survive compression unchanged */
+  logger_stream    = logger_output_file_open("test042.big", 0, 0, 0);
+  reference_stream = fopen("test042.ref", "w");
+  assert(NULL != logger_stream);
+  assert(NULL != reference_stream);
+  assert(LOGGER_OK == logger_output_file_compression_enable(logger_stream));
+  assert(LOGGER_OK == logger_output_level_set(logger_stream, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_register(reference_stream));
+  assert(LOGGER_OK == logger_output_level_set(reference_stream, LOGGER_DEBUG));
+
+  for (index = 0 ; index < 5000 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d with value %x\n", index, index * 2654435761U));
+  }
+
+  assert(LOGGER_OK == logger_output_file_rotate(logger_stream));
+  assert(LOGGER_OK == logger_output_file_close(logger_stream));
+  assert(LOGGER_OK == logger_output_deregister(reference_stream));
+  fclose(reference_stream);
+
+  decompress("test042.big.1.lz", "test042.big.1");
+
+  reference = fopen("test042.ref", "r");
+  result    = fopen("test042.big.1", "r");
+  assert(NULL != reference);
+  assert(NULL != result);
+
+  do {
+    character = fgetc(reference);
+    assert(character == fgetc(result));
+  } while (character != EOF);
+
+  fclose(reference);
+  fclose(result);
+
+  /* corrupted data is detected */
+  garbage = fopen("test042.bad", "w+b");
+  assert(NULL != garbage);
+  fputs("this is not compressed data", garbage);
+  rewind(garbage);
+  assert(LOGGER_ERR_DATA_INVALID == logger_decompress(garbage, stdout));
+  fclose(garbage);
+
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,50 @@
+#!/usr/bin/env ruby
+
+require "pathname"
+require_relative "testframework/testhelper"
+require_relative "testframework/testenvironment"
+require_relative "testframework/testdefinition"
+require_relative "testframework/testoperator"
+
+environment = TestEnvironment.new()
+definition = TestDefinition.new()
+
+pathname = Pathname.new(__FILE__).expand_path
+
+definition.name                = pathname.basename.sub_ext("")
+definition.description         = "rotated files of \"test042.out\" are compressed in background and decompress unchanged"
+definition.compiler_flags      = [ "-DLOGGER_ENABLE" ]
+definition.library_directories = [ ]
+definition.libraries           = [ ]
+definition.source_files        = [ "./#{definition.name}.c" ]
+definition.executable          = "./#{definition.name}"
+definition.arguments           = [ ]
+definition.stdin               = ""
+definition.stdout              = ""
+definition.stderr              = ""
+definition.files               = [ [ "#{definition.name}.out",   "#{definition.name}.template_out"],
+                                   [ "#{definition.name}.out.2", "#{definition.name}.template_out.2"],
+                                   [ "#{definition.name}.out.1", "#{definition.name}.template_out.1"] ]
+definition.status              = 0
+definition.temporary_files     = [ "#{definition.executable}", "#{definition.name}.out", "#{definition.name}.out.2", "#{definition.name}.out.2.lz", "#{definition.name}.out.1", "#{definition.name}.out.1.lz", "#{definition.name}.big", "#{definition.name}.big.1", "#{definition.name}.big.1.lz", "#{definition.name}.ref", "#{definition.name}.bad" ]
+
+operator = TestOperator.new(environment, definition)
+
+operator.setup()
+
+if operator.buildTest()
+  puts "#{definition.name} ... #{fail()} (build)"
+  return_value = 1
+else
+  if operator.runTest()
+    puts "#{definition.name} ... #{fail()} (behavior)"
+    return_value = 1
+  else
+    puts "#{definition.name} ... #{pass()}"
+    return_value = 0
+  end
+end
+
+operator.cleanup()
+
+exit return_value
@@ -0,0 +1,119 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  FILE        *dump;
+  char        line[512];
+  unsigned    sequence;
+  unsigned    previous = 0;
+  unsigned    lines    = 0;
+  int         index;
+  int         status;
+  pid_t       child;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(logger_false == logger_output_recorder_is_registered());
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_recorder_level_set(LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_recorder_register());
+  assert(logger_true == logger_output_recorder_is_registered());
+  assert(LOGGER_UNKNOWN == logger_output_recorder_level_mask_get());
+  assert(LOGGER_OK == logger_output_recorder_level_set(LOGGER_DEBUG));
+  assert(LOGGER_DEBUG == logger_output_recorder_level_get());
+  assert(LOGGER_ALL == logger_output_recorder_level_mask_get());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  /* only errors are printed, everything is recorded */
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_ERR));
+
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG,   "id %d - LOGGER_DEBUG   in line %d\n", id, __LINE__));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO,    "id %d - LOGGER_INFO    in line %d\n", id, __LINE__));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "id %d - LOGGER_WARNING in line %d\n", id, __LINE__));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR,     "id %d - LOGGER_ERR     in line %d\n", id, __LINE__));
+
+  /* disabled IDs are not recorded */
+  assert(LOGGER_OK == logger_id_disable(id));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR,     "id %d - LOGGER_ERR     in line %d\n", id, __LINE__));
+  assert(LOGGER_OK == logger_id_enable(id));
+
+  assert(LOGGER_OK == logger_output_recorder_dump(stdout));
+
+  /* ring keeps only the latest messages */
+  for (index = 0 ; index < 5000 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d\n", index));
+  }
+
+  dump = fopen("test043.dump", "w+");
+  assert(NULL != dump);
+  assert(LOGGER_OK == logger_output_recorder_dump(dump));
+  rewind(dump);
+
+  while (fgets(line, sizeof(line), dump) != NULL) {
+    assert(1 == sscanf(line, "%u ", &sequence));
+    assert(previous == 0 || sequence == previous + 1);
+    previous = sequence;
+    lines++;
+  }
+
+  fclose(dump);
+  assert(lines > 100);
+  assert(lines < 5000);
+  assert(previous == 5004);
+  assert(NULL != strstr(line, ": message 4999\n"));
+
+  /* crash dump */
+  assert(LOGGER_OK == logger_output_recorder_deregister());
+  assert(LOGGER_OK == logger_output_recorder_register());
+  assert(LOGGER_OK == logger_output_recorder_level_set(LOGGER_WARNING));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_EMERG));
+  fflush(stdout);
+
+  child = fork();
+  assert(child >= 0);
+
+  if (child == 0) {
+    assert(LOGGER_OK == logger_output_recorder_crash_dump_enable("test043.crash"));
+    (void)logger(id, LOGGER_NOTICE,  "id %d - LOGGER_NOTICE  in line %d\n", id, __LINE__);
+    (void)logger(id, LOGGER_WARNING, "id %d - LOGGER_WARNING in line %d\n", id, __LINE__);
+    (void)logger(id, LOGGER_CRIT,    "id %d - LOGGER_CRIT    in line %d\n", id, __LINE__);
+
+    /* messages dropped by a limit are recorded */
+    assert(LOGGER_OK == logger_rate_limit_set(1));
+    for (index = 0 ; index < 2 ; index++) {
+      (void)logger(id, LOGGER_EMERG, "id %d - LOGGER_EMERG  in line %d\n", id, __LINE__);
+    }
+    abort();
+  }
+
+  assert(child == waitpid(child, &status, 0));
+  assert(WIFSIGNALED(status));
+  assert(SIGABRT == WTERMSIG(status));
+
+  assert(LOGGER_OK == logger_output_recorder_deregister());
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_recorder_deregister());
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
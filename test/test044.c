@@ -0,0 +1,125 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static void corrupt(const char *name, const char *text)
+{
+  static char buffer[128 * 1024];
+  FILE        *file;
+  size_t      size;
+  char        *found;
+
+  file = fopen(name, "r+b");
+  assert(NULL != file);
+  size = fread(buffer, 1, sizeof(buffer), file);
+  found = memchr(buffer, text[0], size);
+  while (found != NULL && memcmp(found, text, strlen(text)) != 0) {
+    found = memchr(found + 1, text[0], size - (size_t)(found + 1 - buffer));
+  }
+  assert(NULL != found);
+  assert(0 == fseek(file, (long)(found - buffer), SEEK_SET));
+  fputc('X', file);
+  fclose(file);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  FILE        *dump;
+  char        line[512];
+  unsigned    sequence;
+  unsigned    previous = 0;
+  int         index;
+  int         status;
+  pid_t       child;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_recorder_file_close());
+  assert(LOGGER_ERR_STREAM_INVALID == logger_output_recorder_recover("test044.missing", stdout));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_EMERG));
+
+  /* messages survive SIGKILL */
+  fflush(stdout);
+  child = fork();
+  assert(child >= 0);
+
+  if (child == 0) {
+    assert(LOGGER_OK == logger_output_recorder_register());
+    assert(LOGGER_OK == logger_output_recorder_level_set(LOGGER_DEBUG));
+    assert(LOGGER_OK == logger_output_recorder_file_open("test044.rec"));
+
+    for (index = 0 ; index < 4 ; index++) {
+      (void)logger(id, LOGGER_DEBUG, "message %d\n", index);
+    }
+
+    raise(SIGKILL);
+  }
+
+  assert(child == waitpid(child, &status, 0));
+  assert(WIFSIGNALED(status));
+  assert(SIGKILL == WTERMSIG(status));
+
+  assert(LOGGER_OK == logger_output_recorder_recover("test044.rec", stdout));
+
+  /* damaged records are skipped */
+  corrupt("test044.rec", "message 2");
+  assert(LOGGER_OK == logger_output_recorder_recover("test044.rec", stdout));
+
+  /* file is continued by the next process */
+  assert(LOGGER_OK == logger_output_recorder_register());
+  assert(LOGGER_OK == logger_output_recorder_level_set(LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_recorder_file_open("test044.rec"));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "message %d\n", 4));
+  assert(LOGGER_OK == logger_output_recorder_dump(stdout));
+  assert(LOGGER_OK == logger_output_recorder_file_close());
+  assert(LOGGER_OK == logger_output_recorder_recover("test044.rec", stdout));
+
+  /* recovered messages of a wrapped ring are ordered */
+  assert(LOGGER_OK == logger_output_recorder_file_open("test044.rec"));
+
+  for (index = 0 ; index < 5000 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d\n", index));
+  }
+
+  assert(LOGGER_OK == logger_output_recorder_file_close());
+
+  dump = fopen("test044.dump", "w+");
+  assert(NULL != dump);
+  assert(LOGGER_OK == logger_output_recorder_recover("test044.rec", dump));
+  rewind(dump);
+
+  while (fgets(line, sizeof(line), dump) != NULL) {
+    assert(1 == sscanf(line, "%u ", &sequence));
+    assert(previous == 0 || sequence == previous + 1);
+    previous = sequence;
+  }
+
+  fclose(dump);
+  assert(previous == 5005);
+  assert(NULL != strstr(line, ": message 4999\n"));
+
+  /* other files are rejected */
+  assert(LOGGER_ERR_DATA_INVALID == logger_output_recorder_recover("test044.c", stdout));
+
+  assert(LOGGER_OK == logger_output_recorder_deregister());
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
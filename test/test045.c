@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include "logger.h"
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  int         index;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_WARNING));
+
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_id_lazy_enable(logger_id_unknown, 3, LOGGER_ERR));
+  assert(LOGGER_ERR_SIZE_INVALID == logger_id_lazy_enable(id, 0, LOGGER_ERR));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_id_lazy_enable(id, 3, LOGGER_ERR | LOGGER_CRIT));
+  assert(logger_false == logger_id_lazy_is_enabled(id));
+  assert(LOGGER_OK == logger_id_lazy_enable(id, 3, LOGGER_ERR));
+  assert(logger_true == logger_id_lazy_is_enabled(id));
+
+  /* only the latest messages are kept */
+  for (index = 0 ; index < 5 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "debug message %d\n", index));
+  }
+
+  /* printed messages below trigger level don't print kept messages */
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "warning message\n"));
+
+  /* kept messages are printed before the error */
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "error message\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "error message\n"));
+
+  /* kept messages interrupt repeated messages */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "info message\nwith two lines\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR,  "error message\n"));
+
+  /* kept messages are dropped on disable */
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "debug message dropped\n"));
+  assert(LOGGER_OK == logger_id_lazy_disable(id));
+  assert(logger_false == logger_id_lazy_is_enabled(id));
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "debug message lost\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "error message without context\n"));
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,86 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+#include "logger.h"
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t     id       = logger_id_unknown;
+  logger_id_t     id_other = logger_id_unknown;
+  struct timespec delay    = { 1, 100000000 };
+  int             i;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  id       = logger_id_request("logger_test_id");
+  id_other = logger_id_request("logger_other");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+  assert(LOGGER_OK == logger_id_enable(id_other));
+  assert(LOGGER_OK == logger_id_level_set(id_other, LOGGER_DEBUG));
+
+  assert(0 == logger_id_rate_limit_get(id));
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_id_rate_limit_set(logger_id_unknown, 1, 3));
+  assert(LOGGER_ERR_SIZE_INVALID == logger_id_rate_limit_set(id, 1, 0));
+  assert(LOGGER_OK == logger_id_rate_limit_set(id, 1, 3));
+  assert(1 == logger_id_rate_limit_get(id));
+
+  assert(LOGGER_UNKNOWN == logger_rate_limit_exempt_get());
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_rate_limit_exempt_set(LOGGER_ERR | LOGGER_CRIT));
+  assert(LOGGER_OK == logger_rate_limit_exempt_set(LOGGER_ERR));
+  assert(LOGGER_ERR == logger_rate_limit_exempt_get());
+
+  /* filtered messages don't use up the budget */
+  for (i = 0; i < 20; i++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "debug message %d\n", i));
+  }
+
+  /* burst of the ID bucket */
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger(id, LOGGER_INFO, "info message %d\n", i));
+  }
+  for (i = 3; i < 5; i++) {
+    assert(LOGGER_ERR_RATE_LIMIT == logger(id, LOGGER_INFO, "info message %d\n", i));
+  }
+
+  /* other IDs are not affected */
+  assert(LOGGER_OK == logger(id_other, LOGGER_INFO, "other info message\n"));
+
+  /* exempt levels are never skipped */
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger(id, LOGGER_ERR, "error message %d\n", i));
+  }
+
+  /* level bucket applies to all IDs */
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_level_rate_limit_set(LOGGER_UNKNOWN, 1, 2));
+  assert(LOGGER_OK == logger_level_rate_limit_set(LOGGER_DEBUG, 1, 2));
+  assert(1 == logger_level_rate_limit_get(LOGGER_DEBUG));
+  assert(0 == logger_level_rate_limit_get(LOGGER_INFO));
+
+  assert(LOGGER_OK == logger(id_other, LOGGER_DEBUG, "other debug message 0\n"));
+
+  /* suppressed repeats don't use up the budget */
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger(id_other, LOGGER_DEBUG, "other debug message 0\n"));
+  }
+  assert(LOGGER_OK == logger(id_other, LOGGER_DEBUG, "other debug message 1\n"));
+  for (i = 2; i < 4; i++) {
+    assert(LOGGER_ERR_RATE_LIMIT == logger(id_other, LOGGER_DEBUG, "other debug message %d\n", i));
+  }
+
+  /* buckets refill over time */
+  nanosleep(&delay, NULL);
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "info message after delay\n"));
+  assert(LOGGER_OK == logger(id_other, LOGGER_DEBUG, "other debug message after delay\n"));
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_id_release(id));
+  assert(LOGGER_OK == logger_id_release(id_other));
+
+  return(0);
+}
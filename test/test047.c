@@ -0,0 +1,65 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+#include "logger.h"
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t     id      = logger_id_unknown;
+  struct timespec delay   = { 0, 300000000 };
+  int             printed = 0;
+  int             i;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  /* every n-th message, filtered messages don't count */
+  for (i = 0; i < 7; i++) {
+    (void)logger_every_n(3, id, LOGGER_INFO, "every third message %d\n", i);
+    (void)logger_every_n(3, id, LOGGER_DEBUG, "filtered message %d\n", i);
+  }
+
+  /* other call sites are not affected */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "plain message\n"));
+
+  /* at most one message per interval */
+  for (i = 0; i < 5; i++) {
+    (void)logger_every_ms(200, id, LOGGER_INFO, "interval message %d\n", i);
+  }
+  nanosleep(&delay, NULL);
+  assert(LOGGER_OK == logger_every_ms(200, id, LOGGER_INFO, "interval message after delay\n"));
+
+  /* sampling */
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger_sample(1.0, id, LOGGER_INFO, "sampled message %d\n", i));
+    assert(LOGGER_ERR_RATE_LIMIT == logger_sample(0.0, id, LOGGER_INFO, "never printed\n"));
+  }
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+
+  /* probabilities out of range are clamped */
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger_sample(2.0, id, LOGGER_INFO, "always printed\n"));
+    assert(LOGGER_ERR_RATE_LIMIT == logger_sample(-1.0, id, LOGGER_INFO, "never printed\n"));
+  }
+
+  for (i = 0; i < 10000; i++) {
+    if (LOGGER_OK == logger_sample(0.25, id, LOGGER_INFO, "sampled message %d\n", i)) {
+      printed++;
+    }
+  }
+  assert(printed > 2000);
+  assert(printed < 3000);
+
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,62 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+#include "logger.h"
+
+static void message(logger_id_t id, const char *text)
+{
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "%s\n", text));
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t     id       = logger_id_unknown;
+  logger_id_t     id_other = logger_id_unknown;
+  struct timespec delay    = { 0, 300000000 };
+  int             i;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  id       = logger_id_request("logger_test_id");
+  id_other = logger_id_request("logger_other");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_id_enable(id_other));
+  assert(LOGGER_OK == logger_id_level_set(id_other, LOGGER_DEBUG));
+
+  assert(0 == logger_repeat_window_get());
+  assert(LOGGER_OK == logger_repeat_window_set(200));
+  assert(200 == logger_repeat_window_get());
+
+  /* interleaved repeats are suppressed */
+  for (i = 0; i < 3; i++) {
+    message(id, "first message");
+    message(id, "second message");
+  }
+
+  /* other IDs and texts are different messages */
+  message(id_other, "first message");
+  message(id, "third message");
+
+  /* consecutive repeats still work */
+  message(id, "third message");
+  message(id, "fourth message");
+
+  /* repeats are printed when the message appears after the window */
+  nanosleep(&delay, NULL);
+  message(id, "first message");
+
+  /* pending repeats are printed on release */
+  message(id, "second message");
+  message(id, "first message");
+  assert(LOGGER_OK == logger_id_release(id));
+  assert(LOGGER_OK == logger_id_release(id_other));
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+
+  return(0);
+}
@@ -0,0 +1,68 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+#include "logger.h"
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t     id    = logger_id_unknown;
+  struct timespec delay = { 0, 150000000 };
+  int             i;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  assert(0 == logger_repeat_flush_interval_get());
+  assert(LOGGER_OK == logger_repeat_flush_interval_set(100));
+  assert(100 == logger_repeat_flush_interval_get());
+
+  /* nothing pending */
+  assert(LOGGER_OK == logger_repeat_flush());
+
+  /* consecutive repeats are printed after the interval */
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger(id, LOGGER_ERR, "repeated message\n"));
+  }
+  assert(LOGGER_OK == logger_repeat_flush());
+  printf("-- repeats noticed\n");
+  nanosleep(&delay, NULL);
+  assert(LOGGER_OK == logger_repeat_flush());
+  printf("-- interval passed\n");
+
+  /* the message is printed again afterwards */
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "repeated message\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "repeated message\n"));
+
+  /* interleaved repeats are printed after the interval, the message stays suppressed */
+  assert(LOGGER_OK == logger_repeat_window_set(10000));
+  for (i = 0; i < 3; i++) {
+    assert(LOGGER_OK == logger(id, LOGGER_ERR, "first message\n"));
+    assert(LOGGER_OK == logger(id, LOGGER_ERR, "second message\n"));
+
+    if (i == 1) {
+      assert(LOGGER_OK == logger_repeat_flush());
+      printf("-- within interval\n");
+      nanosleep(&delay, NULL);
+      assert(LOGGER_OK == logger_repeat_flush());
+      printf("-- interval passed\n");
+    }
+  }
+
+  /* without interval everything pending is printed */
+  assert(LOGGER_OK == logger_repeat_flush_interval_set(0));
+  assert(LOGGER_OK == logger_repeat_flush());
+  printf("-- flushed\n");
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "logger.h"
+
+static logger_id_t id = logger_id_unknown;
+static int         calls;
+
+static void output_function(const char *string)
+{
+  calls++;
+  fputs(string, stdout);
+}
+
+static void *thread_function(void *argument)
+{
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "thread part 1"));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, ", thread part 2"));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, ", thread part 3\n"));
+
+  /* partial lines of exiting threads are dropped */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "never completed"));
+
+  return(NULL);
+}
+
+int main(int  argc, char *argv[])
+{
+  pthread_t      thread;
+  logger_stats_t stats;
+  char           part[200];
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  assert(logger_false == logger_id_line_buffer_is_enabled(id));
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_id_line_buffer_enable(logger_id_unknown));
+  assert(LOGGER_OK == logger_id_line_buffer_enable(id));
+  assert(logger_true == logger_id_line_buffer_is_enabled(id));
+
+  /* the line of the other thread is not mixed into this one */
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "main part 1"));
+  assert(0 == pthread_create(&thread, NULL, thread_function, NULL));
+  assert(0 == pthread_join(thread, NULL));
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, ", main part 2"));
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, ", main part 3\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "complete line\n"));
+
+  /* whole lines are written at once */
+  assert(3 == calls);
+
+  /* parts are printed right away without line buffering */
+  assert(LOGGER_OK == logger_id_line_buffer_disable(id));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "part 1"));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, ", part 2\n"));
+  assert(5 == calls);
+
+  /* a line not fitting is truncated like a single message */
+  memset(part, 'x', sizeof(part) - 1);
+  part[sizeof(part) - 1] = '\0';
+  assert(LOGGER_OK == logger_id_line_buffer_enable(id));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "%s", part));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "%s\n", part));
+  assert(6 == calls);
+  assert(LOGGER_OK == logger_stats_get(id, LOGGER_WARNING, &stats));
+  assert(1 == stats.truncated);
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
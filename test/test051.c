@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include "logger.h"
+
+static int calls;
+
+static void output_function(const char *string)
+{
+  calls++;
+  fputs(string, stdout);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  char        long_string[300];
+  int         index;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  assert(LOGGER_ERR_NOT_STARTED == logger_msg_appendf("nothing"));
+  assert(LOGGER_ERR_NOT_STARTED == logger_msg_commit());
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_msg_begin(logger_id_unknown, LOGGER_INFO));
+
+  /* parts are printed as one message */
+  assert(LOGGER_OK == logger_msg_begin(id, LOGGER_INFO));
+  for (index = 0 ; index < 4 ; index++) {
+    assert(LOGGER_OK == logger_msg_appendf("%s%d", (index == 0) ? "values: " : ", ", index));
+  }
+  assert(LOGGER_OK == logger_msg_commit());
+  assert(1 == calls);
+
+  /* a trailing newline is kept */
+  assert(LOGGER_OK == logger_msg_begin(id, LOGGER_WARNING));
+  assert(LOGGER_OK == logger_msg_appendf("complete line\n"));
+  assert(LOGGER_OK == logger_msg_commit());
+  assert(2 == calls);
+
+  /* filtered messages are not printed */
+  assert(LOGGER_OK == logger_msg_begin(id, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_msg_appendf("filtered"));
+  assert(LOGGER_OK == logger_msg_commit());
+  assert(2 == calls);
+
+  /* long messages are truncated */
+  memset(long_string, 'x', sizeof(long_string) - 1);
+  long_string[sizeof(long_string) - 1] = '\0';
+  assert(LOGGER_OK == logger_msg_begin(id, LOGGER_ERR));
+  assert(LOGGER_OK == logger_msg_appendf("long: "));
+  assert(LOGGER_OK == logger_msg_appendf("%s", long_string));
+  assert(LOGGER_OK == logger_msg_appendf("never seen"));
+  assert(LOGGER_OK == logger_msg_commit());
+  assert(3 == calls);
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
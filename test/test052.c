@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "logger.h"
+
+static void output_logfmt(const char *string)
+{
+  fputs(string, stdout);
+}
+
+static void output_json(const char *string)
+{
+  fputs(string, stdout);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  char        long_string[300];
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_register(output_logfmt));
+  assert(LOGGER_OK == logger_output_function_level_set(output_logfmt, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_register(output_json));
+  assert(LOGGER_OK == logger_output_function_level_set(output_json, LOGGER_DEBUG));
+
+  /* rendering is selected per output */
+  assert(LOGGER_KV_FORMAT_TEXT == logger_output_kv_format_get(stdout));
+  assert(LOGGER_OK == logger_output_function_kv_format_set(output_logfmt, LOGGER_KV_FORMAT_LOGFMT));
+  assert(LOGGER_OK == logger_output_function_kv_format_set(output_json, LOGGER_KV_FORMAT_JSON));
+  assert(LOGGER_KV_FORMAT_LOGFMT == logger_output_function_kv_format_get(output_logfmt));
+  assert(LOGGER_KV_FORMAT_JSON == logger_output_function_kv_format_get(output_json));
+  assert(LOGGER_ERR_FORMAT_INVALID == logger_output_kv_format_set(stdout, LOGGER_KV_FORMAT_MAX));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_kv_format_set(stderr, LOGGER_KV_FORMAT_JSON));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  /* typed fields */
+  assert(LOGGER_OK == logger_kv(id, LOGGER_INFO, "transfer done",
+                                LOGGER_KV_U64("bytes", 1234567),
+                                LOGGER_KV_STR("peer", "host.example"),
+                                LOGGER_KV_BOOL("ok", 1)));
+  assert(LOGGER_OK == logger_kv(id, LOGGER_NOTICE, "limits",
+                                LOGGER_KV_U64("u64", UINT64_MAX),
+                                LOGGER_KV_I64("i64", INT64_MIN),
+                                LOGGER_KV_I64("zero", 0),
+                                LOGGER_KV_I64("negative", -42)));
+  assert(LOGGER_OK == logger_kv(id, LOGGER_WARNING, "floats",
+                                LOGGER_KV_F64("a", 1.5),
+                                LOGGER_KV_F64("b", -0.25),
+                                LOGGER_KV_F64("c", 3),
+                                LOGGER_KV_F64("d", 0.1234567),
+                                LOGGER_KV_F64("e", 1e20),
+                                LOGGER_KV_F64("f", NAN),
+                                LOGGER_KV_F64("g", -INFINITY)));
+
+  /* strings are quoted and escaped when needed */
+  assert(LOGGER_OK == logger_kv(id, LOGGER_ERR, "quote \"me\"\nplease",
+                                LOGGER_KV_STR("empty", ""),
+                                LOGGER_KV_STR("space", "a b"),
+                                LOGGER_KV_STR("path", "C:\\tmp"),
+                                LOGGER_KV_STR("none", NULL)));
+
+  /* filtered messages are not rendered */
+  assert(LOGGER_OK == logger_kv(id, LOGGER_DEBUG, "filtered", LOGGER_KV_U64("never", 1)));
+
+  /* long messages are truncated */
+  memset(long_string, 'x', sizeof(long_string) - 1);
+  long_string[sizeof(long_string) - 1] = '\0';
+  assert(LOGGER_OK == logger_kv(id, LOGGER_CRIT, "long", LOGGER_KV_STR("value", long_string)));
+
+  /* truncated JSON stays valid, escapes are not cut */
+  memset(long_string, '"', sizeof(long_string) - 1);
+  assert(LOGGER_OK == logger_kv(id, LOGGER_CRIT, "quotes", LOGGER_KV_STR("value", long_string), LOGGER_KV_U64("dropped", 1)));
+
+  /* messages without fields */
+  assert(LOGGER_OK == logger_kv(id, LOGGER_INFO, "no fields"));
+
+  /* invalid fields */
+  assert(LOGGER_ERR_STRING_INVALID == logger_kv(id, LOGGER_INFO, NULL, LOGGER_KV_U64("bytes", 1)));
+  assert(LOGGER_ERR_DATA_INVALID == logger_kv(id, LOGGER_INFO, "no key", LOGGER_KV_U64(NULL, 1)));
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_kv(logger_id_unknown, LOGGER_INFO, "unknown", LOGGER_KV_U64("bytes", 1)));
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_output_function_deregister(output_logfmt));
+  assert(LOGGER_OK == logger_output_function_deregister(output_json));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static void output_json(const char *string)
+{
+  fputs(string, stdout);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  char        long_string[300];
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_register(output_json));
+  assert(LOGGER_OK == logger_output_function_level_set(output_json, LOGGER_DEBUG));
+
+  assert(LOGGER_OUTPUT_FORMAT_TEXT == logger_output_function_format_get(output_json));
+  assert(LOGGER_OK == logger_output_function_format_set(output_json, LOGGER_OUTPUT_FORMAT_JSON));
+  assert(LOGGER_OUTPUT_FORMAT_JSON == logger_output_function_format_get(output_json));
+  assert(LOGGER_OUTPUT_FORMAT_TEXT == logger_output_format_get(stdout));
+  assert(LOGGER_ERR_FORMAT_INVALID == logger_output_format_set(stdout, LOGGER_OUTPUT_FORMAT_MAX));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_format_set(stderr, LOGGER_OUTPUT_FORMAT_JSON));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  /* same message as text and as JSON object */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "plain message %d\n", 1));
+
+  /* characters needing escapes in short and long runs */
+  assert(LOGGER_OK == logger(id, LOGGER_NOTICE, "quote \" backslash \\ tab \t bell \a end\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "a rather long text without any escapes, followed by \"quotes\" and more text\n"));
+
+  /* fields of structured messages become members */
+  assert(LOGGER_OK == logger_kv(id, LOGGER_ERR, "sent",
+                                LOGGER_KV_U64("bytes", 42),
+                                LOGGER_KV_STR("peer", "host \"a\""),
+                                LOGGER_KV_F64("ratio", 0.5)));
+
+  /* too long messages stay valid JSON */
+  memset(long_string, '"', sizeof(long_string) - 1);
+  long_string[sizeof(long_string) - 1] = '\0';
+  assert(LOGGER_OK == logger(id, LOGGER_CRIT, "%s\n", long_string));
+
+  /* kept messages show where they were logged */
+  assert(LOGGER_OK == logger_id_lazy_enable(id, 2, LOGGER_ALERT));
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "kept message\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_ALERT, "trigger\n"));
+  assert(LOGGER_OK == logger_id_lazy_disable(id));
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_output_function_deregister(output_json));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static const char *text_line_1;
+static const char *text_line_2;
+static const char *json_line;
+static const char *logfmt_line;
+
+static void output_text_1(const char *string)
+{
+  text_line_1 = string;
+  fputs(string, stdout);
+}
+
+static void output_text_2(const char *string)
+{
+  text_line_2 = string;
+}
+
+static void output_json(const char *string)
+{
+  json_line = string;
+  fputs(string, stdout);
+}
+
+static void output_logfmt(const char *string)
+{
+  logfmt_line = string;
+  fputs(string, stdout);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  FILE        *binary;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_OK == logger_output_function_register(output_text_1));
+  assert(LOGGER_OK == logger_output_function_level_set(output_text_1, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_register(output_text_2));
+  assert(LOGGER_OK == logger_output_function_level_set(output_text_2, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_register(output_json));
+  assert(LOGGER_OK == logger_output_function_level_set(output_json, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_format_set(output_json, LOGGER_OUTPUT_FORMAT_JSON));
+  assert(LOGGER_OK == logger_output_function_register(output_logfmt));
+  assert(LOGGER_OK == logger_output_function_level_set(output_logfmt, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_kv_format_set(output_logfmt, LOGGER_KV_FORMAT_LOGFMT));
+
+  /* functions only take strings */
+  assert(LOGGER_ERR_FORMAT_INVALID == logger_output_function_format_set(output_text_2, LOGGER_OUTPUT_FORMAT_BINARY));
+  assert(LOGGER_OUTPUT_FORMAT_TEXT == logger_output_function_format_get(output_text_2));
+
+  binary = fopen("test054.bin", "wb");
+  assert(NULL != binary);
+  assert(LOGGER_OK == logger_output_register(binary));
+  assert(LOGGER_OK == logger_output_level_set(binary, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_format_set(binary, LOGGER_OUTPUT_FORMAT_BINARY));
+  assert(LOGGER_OUTPUT_FORMAT_BINARY == logger_output_format_get(binary));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  /* outputs with the same encoding share one line */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "message %d\n", 1));
+  assert(text_line_1 == text_line_2);
+  assert(text_line_1 != json_line);
+  assert(text_line_1 == logfmt_line);
+
+  /* structured messages are rendered per format */
+  assert(LOGGER_OK == logger_kv(id, LOGGER_NOTICE, "sent", LOGGER_KV_U64("bytes", 42)));
+  assert(text_line_1 == text_line_2);
+  assert(text_line_1 != logfmt_line);
+  assert(text_line_1 != json_line);
+
+  /* colored text is a different encoding */
+  assert(LOGGER_OK == logger_output_function_color_enable(output_text_2));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "message %d\n", 3));
+  assert(text_line_1 != text_line_2);
+
+  assert(LOGGER_OK == logger_output_deregister(binary));
+  fclose(binary);
+
+  /* binary records are read back like the flight recorder */
+  fflush(stdout);
+  assert(LOGGER_OK == logger_output_recorder_recover("test054.bin", stdout));
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_text_1));
+  assert(LOGGER_OK == logger_output_function_deregister(output_text_2));
+  assert(LOGGER_OK == logger_output_function_deregister(output_json));
+  assert(LOGGER_OK == logger_output_function_deregister(output_logfmt));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
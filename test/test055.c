@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+typedef struct sink_s {
+  const char *name;
+  unsigned   lines;
+  unsigned   flushes;
+  unsigned   closes;
+} sink_t;
+
+static void sink_write(void *context, const logger_record_t *record, const char *line, size_t length)
+{
+  sink_t *sink = (sink_t *)context;
+
+  sink->lines++;
+  assert(record->message_length == strlen(record->message));
+  printf("%s write: id %d level %u time %" PRId64 " line %" PRIu32 " message \"%.*s\" length %zu: ",
+         sink->name, record->id, record->level, record->time, record->line, (int)record->message_length, record->message, length);
+  fwrite(line, 1, length, stdout);
+}
+
+static void sink_writev(void *context, const logger_record_t *record, const logger_iovec_t *parts, size_t count)
+{
+  sink_t *sink = (sink_t *)context;
+  size_t index;
+
+  sink->lines++;
+  printf("%s writev: %zu parts:", sink->name, count);
+  for (index = 0 ; index < count ; index++) {
+    printf(" [%.*s]", (int)parts[index].length, parts[index].base);
+  }
+  printf("\n");
+}
+
+static void sink_flush(void *context)
+{
+  ((sink_t *)context)->flushes++;
+}
+
+static void sink_close(void *context)
+{
+  ((sink_t *)context)->closes++;
+}
+
+static const logger_output_driver_t line_driver  = { sink_write, NULL, sink_flush, sink_close };
+static const logger_output_driver_t parts_driver = { sink_write, sink_writev, NULL, NULL };
+static const logger_output_driver_t bad_driver   = { NULL, NULL, NULL, NULL };
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  sink_t      first  = { "first" };
+  sink_t      second = { "second" };
+  sink_t      parts  = { "parts" };
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_ERR_FUNCTION_INVALID == logger_output_driver_register(NULL, &first));
+  assert(LOGGER_ERR_FUNCTION_INVALID == logger_output_driver_register(&bad_driver, &first));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_driver_level_set(&line_driver, &first, LOGGER_DEBUG));
+
+  /* same driver with different contexts are different outputs */
+  assert(logger_false == logger_output_driver_is_registered(&line_driver, &first));
+  assert(LOGGER_OK == logger_output_driver_register(&line_driver, &first));
+  assert(LOGGER_ERR_OUTPUT_REGISTERED == logger_output_driver_register(&line_driver, &first));
+  assert(LOGGER_OK == logger_output_driver_register(&line_driver, &second));
+  assert(LOGGER_OK == logger_output_driver_register(&parts_driver, &parts));
+  assert(logger_true == logger_output_driver_is_registered(&line_driver, &first));
+  assert(LOGGER_OK == logger_output_driver_level_set(&line_driver, &first, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_driver_level_set(&line_driver, &second, LOGGER_WARNING));
+  assert(LOGGER_OK == logger_output_driver_level_set(&parts_driver, &parts, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_driver_format_set(&line_driver, &second, LOGGER_OUTPUT_FORMAT_JSON));
+  assert(LOGGER_ERR_FORMAT_INVALID == logger_output_driver_format_set(&line_driver, &second, LOGGER_OUTPUT_FORMAT_MAX));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "message %d\n", 1));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "message %d\n", 2));
+  assert(first.lines == 2);
+  assert(second.lines == 1);
+  assert(parts.lines == 2);
+
+  /* drivers without writev get text lines through write too */
+  assert(LOGGER_OK == logger_output_driver_format_set(&parts_driver, &parts, LOGGER_OUTPUT_FORMAT_JSON));
+  assert(LOGGER_OK == logger(id, LOGGER_NOTICE, "message %d\n", 3));
+
+  assert(LOGGER_OK == logger_output_flush());
+  assert(first.flushes == 1);
+
+  /* last deregistration flushes and closes */
+  assert(LOGGER_OK == logger_output_driver_deregister(&line_driver, &first));
+  assert(first.closes == 0);
+  assert(LOGGER_OK == logger_output_driver_deregister(&line_driver, &first));
+  assert(first.flushes == 2);
+  assert(first.closes == 1);
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_driver_deregister(&line_driver, &first));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "message %d\n", 4));
+  assert(first.lines == 3);
+  assert(second.lines == 2);
+
+  assert(LOGGER_OK == logger_output_driver_deregister(&line_driver, &second));
+  assert(LOGGER_OK == logger_output_driver_deregister(&parts_driver, &parts));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static unsigned records;
+static unsigned errors;
+
+static void output_record(const logger_record_t *record)
+{
+  records++;
+  printf("record: id %d level %u time %" PRId64 " file %s function %s line %" PRIu32 " message \"%.*s\"\n",
+         record->id, record->level, record->time, strrchr(record->file, '/') != NULL ? strrchr(record->file, '/') + 1 : record->file, record->function, record->line, (int)record->message_length, record->message);
+}
+
+static void count_errors(const logger_record_t *record)
+{
+  errors++;
+}
+
+static void driver_write(void *context, const logger_record_t *record, const char *line, size_t length)
+{
+  assert(0 == length);
+  assert('\0' == line[0]);
+  printf("driver: message \"%.*s\"\n", (int)record->message_length, record->message);
+}
+
+static const logger_output_driver_t driver = { driver_write, NULL, NULL, NULL };
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+
+  assert(LOGGER_OK == logger_init());
+
+  assert(LOGGER_ERR_FUNCTION_INVALID == logger_output_record_register(NULL));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_record_level_set(output_record, LOGGER_DEBUG));
+  assert(logger_false == logger_output_record_is_registered(output_record));
+  assert(LOGGER_OK == logger_output_record_register(output_record));
+  assert(logger_true == logger_output_record_is_registered(output_record));
+  assert(LOGGER_OK == logger_output_record_level_set(output_record, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_record_register(count_errors));
+  assert(LOGGER_OK == logger_output_record_level_set(count_errors, LOGGER_ERR));
+
+  /* drivers may skip formatting too */
+  assert(LOGGER_OK == logger_output_driver_register(&driver, NULL));
+  assert(LOGGER_OK == logger_output_driver_level_set(&driver, NULL, LOGGER_WARNING));
+  assert(LOGGER_OK == logger_output_driver_format_set(&driver, NULL, LOGGER_OUTPUT_FORMAT_RECORD));
+
+  /* streams and functions need lines */
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_ERR));
+  assert(LOGGER_ERR_FORMAT_INVALID == logger_output_format_set(stdout, LOGGER_OUTPUT_FORMAT_RECORD));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  /* only record outputs */
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d\n", 1));
+
+  /* record outputs and driver */
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "message %d\n", 2));
+
+  /* every output, text is printed as always */
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "message %d\n", 3));
+  assert(LOGGER_OK == logger_kv(id, LOGGER_CRIT, "sent", LOGGER_KV_U64("bytes", 42)));
+
+  /* multi line messages are passed per line */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "first line\nsecond line\n"));
+
+  assert(records == 6);
+  assert(errors == 2);
+
+  assert(LOGGER_OK == logger_output_record_deregister(output_record));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_record_deregister(output_record));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR, "message %d\n", 4));
+  assert(records == 6);
+  assert(errors == 3);
+
+  assert(LOGGER_OK == logger_output_record_deregister(count_errors));
+  assert(LOGGER_OK == logger_output_driver_deregister(&driver, NULL));
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static void output_function(const char *line)
+{
+}
+
+static void driver_write(void *context, const logger_record_t *record, const char *line, size_t length)
+{
+}
+
+static const logger_output_driver_t driver = { driver_write, NULL, NULL, NULL };
+
+static void *thread_function(void *argument)
+{
+  logger_id_t id = *(logger_id_t *)argument;
+  int         index;
+
+  for (index = 0 ; index < 1000 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "filtered\n"));
+  }
+
+  return(NULL);
+}
+
+static void print_stats(const char *name, const logger_stats_t *stats)
+{
+  printf("%s: accepted %" PRIu64 " filtered %" PRIu64 " emitted %" PRIu64 " rate_limited %" PRIu64 " repeat_suppressed %" PRIu64 " truncated %" PRIu64 "\n",
+         name, stats->accepted, stats->filtered, stats->emitted, stats->rate_limited, stats->repeat_suppressed, stats->truncated);
+}
+
+static void print_output_stats(const char *name, const logger_output_stats_t *stats)
+{
+  printf("%s: lines %" PRIu64 " bytes %" PRIu64 " errors %" PRIu64 "\n",
+         name, stats->lines, stats->bytes, stats->errors);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t           id    = logger_id_unknown;
+  logger_id_t           other = logger_id_unknown;
+  logger_stats_t        stats;
+  logger_output_stats_t output_stats;
+  FILE                  *read_only;
+  int                   context;
+  char                  text[400];
+  pthread_t             threads[4];
+  int                   index;
+
+  assert(LOGGER_OK == logger_init());
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+  other = logger_id_request("logger_test_other");
+  assert(LOGGER_OK == logger_id_enable(other));
+  assert(LOGGER_OK == logger_id_level_set(other, LOGGER_DEBUG));
+
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_driver_register(&driver, &context));
+  assert(LOGGER_OK == logger_output_driver_level_set(&driver, &context, LOGGER_WARNING));
+
+  /* writes to a read only stream fail */
+  read_only = fopen("test057.c", "r");
+  assert(NULL != read_only);
+  assert(LOGGER_OK == logger_output_register(read_only));
+  assert(LOGGER_OK == logger_output_level_set(read_only, LOGGER_DEBUG));
+
+  /* invalid queries */
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_stats_get(42, LOGGER_ALL, &stats));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_stats_get(id, 0x1000, &stats));
+  assert(LOGGER_ERR_OUTPUT_INVALID == logger_stats_get(id, LOGGER_ALL, NULL));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_stats_get(stdout, &output_stats));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_driver_stats_get(&driver, NULL, &output_stats));
+  assert(LOGGER_ERR_OUTPUT_INVALID == logger_output_function_stats_get(output_function, NULL));
+
+  /* filtered, printed, repeated and truncated messages */
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "filtered\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "printed\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "printed\n"));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "printed\n"));
+
+  memset(text, 'x', sizeof(text) - 1);
+  text[sizeof(text) - 1] = '\0';
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "%s\n", text));
+
+  /* call site limits */
+  for (index = 0 ; index < 4 ; index++) {
+    (void)logger_every_n(2, id, LOGGER_ERR, "every second\n");
+  }
+
+  assert(LOGGER_OK == logger(other, LOGGER_DEBUG, "other\n"));
+
+  assert(LOGGER_OK == logger_stats_get(id, LOGGER_ALL, &stats));
+  print_stats("id", &stats);
+  assert(LOGGER_OK == logger_stats_get(id, LOGGER_INFO, &stats));
+  print_stats("id info", &stats);
+  assert(LOGGER_OK == logger_stats_get(id, LOGGER_WARNING | LOGGER_ERR, &stats));
+  print_stats("id warning and err", &stats);
+  assert(LOGGER_OK == logger_stats_get(logger_id_unknown, LOGGER_DEBUG, &stats));
+  print_stats("all debug", &stats);
+  assert(LOGGER_OK == logger_stats_get(logger_id_unknown, LOGGER_ALL, &stats));
+  print_stats("all", &stats);
+
+  assert(LOGGER_OK == logger_output_function_stats_get(output_function, &output_stats));
+  print_output_stats("function", &output_stats);
+  assert(LOGGER_OK == logger_output_driver_stats_get(&driver, &context, &output_stats));
+  print_output_stats("driver", &output_stats);
+  assert(LOGGER_OK == logger_output_stats_get(read_only, &output_stats));
+  print_output_stats("read only", &output_stats);
+
+  /* ID specific registrations are added up */
+  assert(LOGGER_OK == logger_id_output_function_register(other, output_function));
+  assert(LOGGER_OK == logger_id_output_function_level_set(other, output_function, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger(other, LOGGER_DEBUG, "other again\n"));
+  assert(LOGGER_OK == logger_output_function_stats_get(output_function, &output_stats));
+  print_output_stats("id function", &output_stats);
+
+  /* counters of all threads are added up */
+  for (index = 0 ; index < 4 ; index++) {
+    assert(0 == pthread_create(&threads[index], NULL, thread_function, &id));
+  }
+  for (index = 0 ; index < 4 ; index++) {
+    assert(0 == pthread_join(threads[index], NULL));
+  }
+  assert(LOGGER_OK == logger_stats_get(id, LOGGER_DEBUG, &stats));
+  assert(4001 == stats.filtered);
+
+  /* reset */
+  assert(LOGGER_OK == logger_stats_reset());
+  assert(LOGGER_OK == logger_stats_get(logger_id_unknown, LOGGER_ALL, &stats));
+  print_stats("reset", &stats);
+  assert(LOGGER_OK == logger_output_stats_get(read_only, &output_stats));
+  print_output_stats("reset read only", &output_stats);
+
+  assert(LOGGER_OK == logger_output_deregister(read_only));
+  assert(LOGGER_OK == logger_output_driver_deregister(&driver, &context));
+  assert(LOGGER_OK == logger_id_output_function_deregister(other, output_function));
+  fclose(read_only);
+  assert(LOGGER_OK == logger_id_release(id));
+  assert(LOGGER_OK == logger_id_release(other));
+
+  return(0);
+}
@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static unsigned writes;
+
+/* print lines without the measured times */
+static void output_function(const char *line)
+{
+  char previous = ' ';
+
+  for ( ; *line != '\0' ; previous = *line++) {
+    if ((previous == ' ') && isdigit((unsigned char)*line)) {
+      while (isdigit((unsigned char)line[1])) {
+        line++;
+      }
+      putchar('N');
+    }
+    else {
+      putchar(*line);
+    }
+  }
+}
+
+/* every tenth write is slow */
+static void driver_write(void *context, const logger_record_t *record, const char *line, size_t length)
+{
+  struct timespec delay = { 0, 2000000 };
+
+  if ((++writes % 10) == 0) {
+    (void)nanosleep(&delay, NULL);
+  }
+}
+
+static const logger_output_driver_t driver = { driver_write, NULL, NULL, NULL };
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t      id = logger_id_unknown;
+  logger_latency_t latency;
+  int              context;
+  int              index;
+
+  assert(LOGGER_OK == logger_init());
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  assert(LOGGER_OK == logger_output_driver_register(&driver, &context));
+  assert(LOGGER_OK == logger_output_driver_level_set(&driver, &context, LOGGER_DEBUG));
+
+  /* invalid queries */
+  assert(LOGGER_ERR_OUTPUT_INVALID == logger_latency_get(NULL));
+  assert(LOGGER_ERR_OUTPUT_INVALID == logger_output_driver_latency_get(&driver, &context, NULL));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_latency_get(stdout, &latency));
+  assert(LOGGER_ERR_OUTPUT_NOT_FOUND == logger_output_function_latency_get(output_function, &latency));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_latency_dump(LOGGER_INFO | LOGGER_ERR));
+
+  /* filtered messages are measured, too */
+  for (index = 0 ; index < 100 ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_INFO, "message %d\n", index));
+    assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "message %d\n", index));
+  }
+
+  assert(LOGGER_OK == logger_latency_get(&latency));
+  assert(200 == latency.count);
+  assert(latency.min <= latency.p50);
+  assert(latency.p50 <= latency.p90);
+  assert(latency.p90 <= latency.p99);
+  assert(latency.p99 <= latency.p999);
+  assert(latency.p999 <= latency.max);
+  assert(latency.max >= 2000000);
+
+  /* slow writes show up above the 90th percentile */
+  assert(LOGGER_OK == logger_output_driver_latency_get(&driver, &context, &latency));
+  printf("driver: count %" PRIu64 "\n", latency.count);
+  assert(100 == latency.count);
+  assert(latency.p90 < 2000000);
+  assert(latency.p99 >= 2000000);
+  assert(latency.max >= 2000000);
+  assert(latency.mean >= 200000);
+
+  /* dump through the system ID */
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_INFO));
+  assert(LOGGER_OK == logger_latency_dump(LOGGER_INFO));
+  assert(LOGGER_OK == logger_latency_dump(LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_output_function_latency_get(output_function, &latency));
+  printf("function: count %" PRIu64 "\n", latency.count);
+
+  /* reset keeps measured outputs */
+  assert(LOGGER_OK == logger_latency_reset());
+  assert(LOGGER_OK == logger_latency_get(&latency));
+  assert(0 == latency.count);
+  assert(0 == latency.max);
+  assert(LOGGER_OK == logger_output_driver_latency_get(&driver, &context, &latency));
+  assert(0 == latency.count);
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger_output_driver_deregister(&driver, &context));
+  assert(LOGGER_OK == logger_output_function_latency_get(output_function, &latency));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static logger_bool_t printing = logger_false;
+
+static void output_function(const char *line)
+{
+  if (printing == logger_true) {
+    fputs(line, stdout);
+  }
+}
+
+static void noisy(logger_id_t id, int index)
+{
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "noisy message number %d\nwith a second line\n", index));
+}
+
+static void quiet(logger_id_t id, int index)
+{
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "quiet %d\n", index));
+}
+
+static void filtered(logger_id_t id, int index)
+{
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "filtered %d\n", index));
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id = logger_id_unknown;
+  int         index;
+
+  assert(LOGGER_OK == logger_init());
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  assert(logger_false == logger_profile_is_enabled());
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_profile_dump(LOGGER_UNKNOWN, 0));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_profile_dump(LOGGER_INFO | LOGGER_ERR, 0));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_profile_dump_at_exit(LOGGER_INFO | LOGGER_ERR));
+
+  /* not counted before enabled */
+  quiet(id, -1);
+
+  assert(LOGGER_OK == logger_profile_enable());
+  assert(logger_true == logger_profile_is_enabled());
+
+  for (index = 0 ; index < 20 ; index++) {
+    filtered(id, index);
+  }
+
+  for (index = 0 ; index < 10 ; index++) {
+    quiet(id, index);
+  }
+
+  for (index = 0 ; index < 5 ; index++) {
+    noisy(id, index);
+  }
+
+  /* not counted after disabled */
+  assert(LOGGER_OK == logger_profile_disable());
+  quiet(id, -1);
+
+  printing = logger_true;
+
+  /* sorted by bytes */
+  assert(LOGGER_OK == logger_profile_dump(LOGGER_INFO, 0));
+
+  /* only the noisiest call site */
+  assert(LOGGER_OK == logger_profile_dump(LOGGER_INFO, 1));
+
+  /* outputs not taking the level print nothing */
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_WARNING));
+  assert(LOGGER_OK == logger_profile_dump(LOGGER_INFO, 0));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  /* reset */
+  assert(LOGGER_OK == logger_profile_reset());
+  assert(LOGGER_OK == logger_profile_dump(LOGGER_INFO, 0));
+
+  /* printed again at exit */
+  assert(LOGGER_OK == logger_profile_enable());
+  quiet(id, 1);
+  assert(LOGGER_OK == logger_profile_dump_at_exit(LOGGER_NOTICE));
+  puts("exit");
+
+  return(0);
+}
@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static void print(logger_id_t id)
+{
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG,   "id %d - LOGGER_DEBUG\n", id));
+  assert(LOGGER_OK == logger(id, LOGGER_WARNING, "id %d - LOGGER_WARNING\n", id));
+  assert(LOGGER_OK == logger(id, LOGGER_ERR,     "id %d - LOGGER_ERR\n", id));
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t net;
+  logger_id_t pool;
+  logger_id_t ui;
+  logger_id_t other;
+
+  /* specification is parsed by logger_init() */
+  assert(0 == setenv("LOGGER_LEVELS", " net = DEBUG, db.* =logger_warning,,*=ERR ", 1));
+  assert(LOGGER_OK == logger_init());
+  assert(0 == setenv("LOGGER_LEVELS", "*=EMERG", 1));
+
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  /* applied when IDs are requested, first matching rule wins */
+  net   = logger_id_request("net");
+  pool  = logger_id_request("db.pool");
+  ui    = logger_id_request("ui");
+  other = logger_id_request("network");
+
+  assert(logger_true == logger_id_is_enabled(net));
+  assert(LOGGER_DEBUG == logger_id_level_get(net));
+  assert(LOGGER_WARNING == logger_id_level_get(pool));
+  assert(LOGGER_ERR == logger_id_level_get(ui));
+  assert(LOGGER_ERR == logger_id_level_get(other));
+
+  print(net);
+  print(pool);
+  print(ui);
+
+  /* explicit settings override the specification */
+  assert(LOGGER_OK == logger_id_level_set(ui, LOGGER_WARNING));
+  assert(LOGGER_WARNING == logger_id_level_get(ui));
+
+  /* invalid specifications keep the rules */
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_id_level_spec_set("net=LOUD"));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_id_level_spec_set("net="));
+  assert(LOGGER_ERR_STRING_INVALID == logger_id_level_spec_set("net"));
+  assert(LOGGER_ERR_STRING_INVALID == logger_id_level_spec_set(" =DEBUG"));
+  assert(LOGGER_DEBUG == logger_id_level_get(net));
+
+  /* new specification is applied to requested IDs */
+  assert(LOGGER_OK == logger_id_level_spec_set("n?t=CRIT,*work=INFO"));
+  assert(LOGGER_CRIT == logger_id_level_get(net));
+  assert(LOGGER_INFO == logger_id_level_get(other));
+  assert(LOGGER_WARNING == logger_id_level_get(pool));
+
+  /* requesting an existing ID keeps its level */
+  assert(net == logger_id_request("net"));
+  assert(LOGGER_OK == logger_id_level_set(net, LOGGER_DEBUG));
+  assert(net == logger_id_request("net"));
+  assert(LOGGER_DEBUG == logger_id_level_get(net));
+
+  /* no rules leave new IDs disabled */
+  assert(LOGGER_OK == logger_id_level_spec_set(NULL));
+  ui = logger_id_request("view");
+  assert(logger_false == logger_id_is_enabled(ui));
+  assert(LOGGER_UNKNOWN == logger_id_level_mask_get(ui));
+
+  assert(LOGGER_OK == logger_id_release(ui));
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+
+  return(0);
+}
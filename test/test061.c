@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include "logger.h"
+
+#define MESSAGES (20000)
+
+static logger_id_t   id = logger_id_unknown;
+static int           lines;
+static volatile int  done;
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static void output_function(const char *line)
+{
+  lines++;
+}
+
+static void other_function(const char *line)
+{
+}
+
+static void *thread_function(void *argument)
+{
+  int index;
+
+  for (index = 0 ; index < MESSAGES ; index++) {
+    assert(LOGGER_OK == logger(id, LOGGER_INFO, "message %d\n", index));
+  }
+
+  done = 1;
+
+  return(NULL);
+}
+
+int main(int  argc, char *argv[])
+{
+  pthread_t thread;
+  int       changes = 0;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  /* outputs change while messages are printed */
+  assert(0 == pthread_create(&thread, NULL, thread_function, NULL));
+
+  while (done == 0 || changes == 0) {
+    assert(LOGGER_OK == logger_output_function_register(other_function));
+    assert(LOGGER_OK == logger_output_function_level_set(other_function, LOGGER_DEBUG));
+    assert(LOGGER_OK == logger_id_output_function_register(id, other_function));
+    assert(LOGGER_OK == logger_id_output_function_deregister(id, other_function));
+    assert(LOGGER_OK == logger_output_function_deregister(other_function));
+    changes++;
+  }
+
+  assert(0 == pthread_join(thread, NULL));
+
+  /* no message missed the output which stayed registered */
+  printf("%d lines of %d messages\n", lines, MESSAGES);
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
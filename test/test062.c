@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t db;
+  logger_id_t pool;
+  logger_id_t conn;
+  logger_id_t other;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  conn  = logger_id_request("db.pool.conn");
+  pool  = logger_id_request("db.pool");
+  db    = logger_id_request("db");
+  other = logger_id_request("dbx");
+  assert(LOGGER_OK == logger_id_enable(db));
+  assert(LOGGER_OK == logger_id_enable(pool));
+  assert(LOGGER_OK == logger_id_enable(conn));
+  assert(LOGGER_OK == logger_id_enable(other));
+
+  /* level of parent applies to all descendants */
+  assert(LOGGER_OK == logger_id_level_set(db, LOGGER_WARNING));
+  assert(LOGGER_WARNING == logger_id_level_get(pool));
+  assert(LOGGER_WARNING == logger_id_level_get(conn));
+  assert(LOGGER_UNKNOWN == logger_id_level_mask_get(other));
+
+  assert(LOGGER_OK == logger(conn, LOGGER_INFO,    "conn info\n"));
+  assert(LOGGER_OK == logger(conn, LOGGER_WARNING, "conn warning\n"));
+
+  /* descendants with own level are not changed */
+  assert(LOGGER_OK == logger_id_level_set(pool, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_id_level_set(db, LOGGER_ERR));
+  assert(LOGGER_ERR == logger_id_level_get(db));
+  assert(LOGGER_DEBUG == logger_id_level_get(pool));
+  assert(LOGGER_DEBUG == logger_id_level_get(conn));
+
+  assert(LOGGER_OK == logger(conn, LOGGER_INFO,    "conn info\n"));
+  assert(LOGGER_OK == logger(db,   LOGGER_WARNING, "db warning\n"));
+
+  /* inherit again */
+  assert(LOGGER_OK == logger_id_level_inherit(pool));
+  assert(LOGGER_ERR == logger_id_level_get(pool));
+  assert(LOGGER_ERR == logger_id_level_get(conn));
+
+  /* masks are inherited as well */
+  assert(LOGGER_OK == logger_id_level_mask_set(db, LOGGER_DEBUG | LOGGER_ERR));
+  assert((LOGGER_DEBUG | LOGGER_ERR) == logger_id_level_mask_get(conn));
+
+  /* released parent passes on the level of its own ancestor */
+  assert(LOGGER_OK == logger_id_release(pool));
+  assert((LOGGER_DEBUG | LOGGER_ERR) == logger_id_level_mask_get(conn));
+  assert(LOGGER_OK == logger_id_release(db));
+  assert(LOGGER_UNKNOWN == logger_id_level_mask_get(conn));
+
+  /* new IDs inherit when requested */
+  db = logger_id_request("db");
+  assert(LOGGER_OK == logger_id_level_set(db, LOGGER_NOTICE));
+  pool = logger_id_request("db.pool");
+  assert(LOGGER_NOTICE == logger_id_level_get(pool));
+  assert(LOGGER_NOTICE == logger_id_level_get(conn));
+
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_id_level_inherit(logger_id_unknown));
+
+  assert(LOGGER_OK == logger_id_release(conn));
+  assert(LOGGER_OK == logger_id_release(pool));
+  assert(LOGGER_OK == logger_id_release(db));
+  assert(LOGGER_OK == logger_id_release(other));
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+
+  return(0);
+}
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "logger.h"
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t db;
+  logger_id_t pool;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_ERR_NOT_STARTED == logger_config_commit());
+
+  /* changes are applied at commit */
+  assert(LOGGER_OK == logger_config_begin());
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  db   = logger_id_request("db");
+  pool = logger_id_request("db.pool");
+  assert(LOGGER_OK == logger_id_enable(db));
+  assert(LOGGER_OK == logger_id_enable(pool));
+  assert(LOGGER_OK == logger_id_level_set(db, LOGGER_INFO));
+
+  /* own levels apply immediately, inherited levels and outputs at commit */
+  assert(LOGGER_INFO == logger_id_level_get(db));
+  assert(LOGGER_UNKNOWN == logger_id_level_mask_get(pool));
+  assert(logger_false == logger_id_generates_output(db, LOGGER_INFO));
+  assert(LOGGER_OK == logger(db, LOGGER_INFO, "before commit\n"));
+
+  /* nested batches are applied by the outermost commit */
+  assert(LOGGER_OK == logger_config_begin());
+  assert(LOGGER_OK == logger_id_prefix_set(pool, LOGGER_PFX_NAME | LOGGER_PFX_LEVEL));
+  assert(LOGGER_OK == logger_config_commit());
+  assert(logger_false == logger_id_generates_output(pool, LOGGER_INFO));
+
+  assert(LOGGER_OK == logger_config_commit());
+  assert(LOGGER_ERR_NOT_STARTED == logger_config_commit());
+
+  assert(LOGGER_INFO == logger_id_level_get(pool));
+  assert(logger_true == logger_id_generates_output(db, LOGGER_INFO));
+  assert(LOGGER_OK == logger(db,   LOGGER_INFO, "after commit\n"));
+  assert(LOGGER_OK == logger(pool, LOGGER_INFO, "after commit\n"));
+
+  /* repeats are printed with the outputs before the batch */
+  assert(LOGGER_OK == logger(pool, LOGGER_INFO, "repeated\n"));
+  assert(LOGGER_OK == logger(pool, LOGGER_INFO, "repeated\n"));
+  assert(LOGGER_OK == logger_config_begin());
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger(pool, LOGGER_INFO, "deregistered\n"));
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_config_commit());
+  assert(LOGGER_OK == logger(pool, LOGGER_INFO, "registered again\n"));
+
+  assert(LOGGER_OK == logger_id_release(pool));
+  assert(LOGGER_OK == logger_id_release(db));
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+
+  return(0);
+}
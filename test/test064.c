@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include "logger.h"
+
+static logger_id_t id    = logger_id_unknown;
+static logger_id_t other = logger_id_unknown;
+
+time_t time(time_t *t)
+{
+  return(1234567890);
+}
+
+static void print(const char *who)
+{
+  assert(LOGGER_OK == logger(id,    LOGGER_DEBUG, "%s id LOGGER_DEBUG\n", who));
+  assert(LOGGER_OK == logger(id,    LOGGER_INFO,  "%s id LOGGER_INFO\n", who));
+  assert(LOGGER_OK == logger(other, LOGGER_DEBUG, "%s other LOGGER_DEBUG\n", who));
+  assert(LOGGER_OK == logger(other, LOGGER_INFO,  "%s other LOGGER_INFO\n", who));
+}
+
+static void *request_thread(void *argument)
+{
+  /* debug this request only */
+  assert(LOGGER_OK == logger_thread_level_override(id, LOGGER_DEBUG));
+  assert(logger_true == logger_id_generates_output(id, LOGGER_DEBUG));
+  assert(logger_false == logger_id_generates_output(other, LOGGER_DEBUG));
+  print("request");
+  assert(LOGGER_OK == logger_thread_level_override_clear());
+  print("request done");
+
+  /* all IDs, kept until the thread exits */
+  assert(LOGGER_OK == logger_thread_level_override(logger_id_unknown, LOGGER_DEBUG));
+  print("all");
+
+  return(NULL);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t ids[20];
+  pthread_t   thread;
+  char        name[16];
+  int         index;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_thread_level_override_clear());
+
+  id    = logger_id_request("logger_test_id");
+  other = logger_id_request("logger_other_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_enable(other));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+  assert(LOGGER_OK == logger_id_level_set(other, LOGGER_INFO));
+
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_thread_level_override(id, LOGGER_UNKNOWN));
+  assert(LOGGER_ERR_LEVEL_UNKNOWN == logger_thread_level_override(id, LOGGER_DEBUG | LOGGER_INFO));
+  assert(LOGGER_ERR_ID_UNKNOWN == logger_thread_level_override(42, LOGGER_DEBUG));
+
+  /* override of one thread doesn't affect others */
+  assert(0 == pthread_create(&thread, NULL, request_thread, NULL));
+  assert(0 == pthread_join(thread, NULL));
+  print("main");
+
+  /* every ID may be overridden */
+  for (index = 0 ; index < 20 ; index++) {
+    (void)snprintf(name, sizeof(name), "id%d", index);
+    ids[index] = logger_id_request(name);
+    assert(LOGGER_OK == logger_id_enable(ids[index]));
+    assert(LOGGER_OK == logger_id_level_set(ids[index], LOGGER_INFO));
+    assert(LOGGER_OK == logger_thread_level_override(ids[index], LOGGER_DEBUG));
+  }
+
+  assert(logger_true == logger_id_generates_output(ids[19], LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_thread_level_override(ids[19], LOGGER_ERR));
+  assert(logger_false == logger_id_generates_output(ids[19], LOGGER_DEBUG));
+  assert(logger_true == logger_id_generates_output(ids[0], LOGGER_DEBUG));
+  assert(LOGGER_OK == logger_thread_level_override_clear());
+  assert(logger_false == logger_id_generates_output(ids[0], LOGGER_DEBUG));
+
+  for (index = 0 ; index < 20 ; index++) {
+    assert(LOGGER_OK == logger_id_release(ids[index]));
+  }
+
+  assert(LOGGER_OK == logger_id_release(id));
+  assert(LOGGER_OK == logger_id_release(other));
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+
+  return(0);
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <assert.h>
+#include "logger.h"
+
+static logger_id_t     id = logger_id_unknown;
+static logger_return_t nested;
+
+static void output_function(const char *string)
+{
+  /* logging from an output would wait for its own thread */
+  nested = logger(id, LOGGER_INFO, "nested message\n");
+  fputs(string, stdout);
+}
+
+int main(int  argc, char *argv[])
+{
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "outer message\n"));
+  assert(LOGGER_ERR_REENTRANT == nested);
+
+  /* logging works again after the output returned */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "next message\n"));
+  assert(LOGGER_ERR_REENTRANT == nested);
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
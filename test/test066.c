@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <assert.h>
+#include "logger.h"
+
+void test_probe(const char *provider, const char *name, int arguments)
+{
+  printf("probe %s:%s with %d arguments\n", provider, name, arguments);
+}
+
+int main(int  argc, char *argv[])
+{
+  logger_id_t id;
+  int         index;
+
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_register(stdout));
+  assert(LOGGER_OK == logger_output_level_set(stdout, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_INFO));
+
+  /* accepted and emitted */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "printed\n"));
+
+  /* filtered */
+  assert(LOGGER_OK == logger(id, LOGGER_DEBUG, "filtered\n"));
+
+  /* suppressed repeat */
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "printed\n"));
+
+  /* skipped by call site limit */
+  for (index = 0 ; index < 2 ; index++) {
+    (void)logger_every_n(2, id, LOGGER_WARNING, "every second\n");
+  }
+
+  assert(LOGGER_OK == logger_output_deregister(stdout));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
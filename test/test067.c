@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <assert.h>
+#include "logger.h"
+
+static logger_id_t     id = logger_id_unknown;
+static logger_return_t deregistered;
+static logger_return_t level_set;
+static logger_return_t released;
+
+static void output_function(const char *string)
+{
+  /* changing the configuration from an output would wait for its own thread */
+  deregistered = logger_output_function_deregister(output_function);
+  level_set    = logger_id_level_set(id, LOGGER_ERR);
+  released     = logger_id_release(id);
+  fputs(string, stdout);
+}
+
+int main(int  argc, char *argv[])
+{
+  assert(LOGGER_OK == logger_init());
+  assert(LOGGER_OK == logger_output_function_register(output_function));
+  assert(LOGGER_OK == logger_output_function_level_set(output_function, LOGGER_DEBUG));
+
+  id = logger_id_request("logger_test_id");
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "refused changes\n"));
+  assert(LOGGER_ERR_REENTRANT == deregistered);
+  assert(LOGGER_ERR_REENTRANT == level_set);
+  assert(LOGGER_ERR_REENTRANT == released);
+
+  /* nothing has been changed */
+  assert(LOGGER_DEBUG == logger_id_level_get(id));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "unchanged configuration\n"));
+
+  /* changes outside of outputs apply to the next message */
+  assert(LOGGER_OK == logger_id_prefix_set(id, LOGGER_PFX_NAME));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "changed prefix\n"));
+  assert(LOGGER_OK == logger_id_disable(id));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "disabled\n"));
+  assert(logger_false == logger_id_generates_output(id, LOGGER_INFO));
+
+  /* a released ID is reused with defaults */
+  assert(LOGGER_OK == logger_id_release(id));
+  id = logger_id_request("logger_test_id");
+  assert(logger_false == logger_id_generates_output(id, LOGGER_INFO));
+  assert(LOGGER_OK == logger_id_enable(id));
+  assert(LOGGER_OK == logger_id_level_set(id, LOGGER_DEBUG));
+  assert(LOGGER_OK == logger(id, LOGGER_INFO, "requested again\n"));
+
+  assert(LOGGER_OK == logger_output_function_deregister(output_function));
+  assert(LOGGER_OK == logger_id_release(id));
+
+  return(0);
+}
@@ -19,7 +19,7 @@ class TestEnvironment
     @include_directories = [ "../include" ]
     @sources             = [ "../src/logger.c" ]
     @library_directories = Array.new(0, String.new())
-    @libraries           = Array.new(0, String.new())
+    @libraries           = [ "pthread" ]
     @verbose             = false
   end
 end
@@ -0,0 +1,19 @@
+/* Stub of sys/sdt.h for tests, probes call test_probe() of a test defining TEST_SDT_PROBES and do nothing otherwise */
+#ifndef TEST_SYS_SDT_H
+#define TEST_SYS_SDT_H
+
+#ifdef TEST_SDT_PROBES
+void test_probe(const char *provider, const char *name, int arguments);
+
+#define TEST_SDT_PROBE(__provider, __name, __arguments) test_probe(#__provider, #__name, (__arguments))
+#else /* TEST_SDT_PROBES */
+#define TEST_SDT_PROBE(__provider, __name, __arguments) ((void)0)
+#endif /* TEST_SDT_PROBES */
+
+#define DTRACE_PROBE3(__provider, __name, __arg1, __arg2, __arg3) \
+  ((void)(__arg1), (void)(__arg2), (void)(__arg3), TEST_SDT_PROBE(__provider, __name, 3))
+
+#define DTRACE_PROBE5(__provider, __name, __arg1, __arg2, __arg3, __arg4, __arg5) \
+  ((void)(__arg1), (void)(__arg2), (void)(__arg3), (void)(__arg4), (void)(__arg5), TEST_SDT_PROBE(__provider, __name, 5))
+
+#endif /* TEST_SYS_SDT_H */
@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ *     __
+ *    / /___  ____ _____ ____  _____
+ *   / / __ \/ __ `/ __ `/ _ \/ ___/
+ *  / / /_/ / /_/ / /_/ /  __/ /
+ * /_/\____/\__, /\__, /\___/_/
+ *         /____//____/
+ *
+ * \file   logger_bench.c
+ *
+ * \brief  Measure startup configuration of logger.
+ * \author Markus Braun
+ ******************************************************************************/
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif /* _POSIX_C_SOURCE */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "logger.h"
+
+/** Number of IDs configured at startup. */
+#define BENCH_IDS         (80)
+
+/** Number of outputs configured at startup. */
+#define BENCH_OUTPUTS     (6)
+
+/** Number of measured startups. */
+#define BENCH_ROUNDS      (20)
+
+static void bench_output_0(const char *line) { (void)line; }
+static void bench_output_1(const char *line) { (void)line; }
+static void bench_output_2(const char *line) { (void)line; }
+static void bench_output_3(const char *line) { (void)line; }
+static void bench_output_4(const char *line) { (void)line; }
+static void bench_output_5(const char *line) { (void)line; }
+
+static const logger_output_function_t bench_outputs[BENCH_OUTPUTS] = {
+  bench_output_0, bench_output_1, bench_output_2, bench_output_3, bench_output_4, bench_output_5
+};
+
+
+/***************************************************************************//**
+ * \brief  Get monotonic time in nanoseconds.
+ ******************************************************************************/
+static uint64_t bench_now(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return((uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec);
+}
+
+
+/***************************************************************************//**
+ * \brief  Configure IDs and outputs like a service at startup.
+ *
+ * \param[in]     batch   Use logger_config_begin() and logger_config_commit().
+ *
+ * \return        Time of configuration in nanoseconds.
+ ******************************************************************************/
+static uint64_t bench_startup(logger_bool_t batch)
+{
+  logger_id_t ids[BENCH_IDS];
+  char        name[32];
+  uint64_t    start;
+  uint64_t    stop;
+  int         index;
+
+  start = bench_now();
+
+  if (batch == logger_true) {
+    (void)logger_config_begin();
+  }
+
+  for (index = 0 ; index < BENCH_OUTPUTS ; index++) {
+    (void)logger_output_function_register(bench_outputs[index]);
+    (void)logger_output_function_level_set(bench_outputs[index], LOGGER_INFO);
+    (void)logger_output_function_color_enable(bench_outputs[index]);
+  }
+
+  for (index = 0 ; index < BENCH_IDS ; index++) {
+    (void)snprintf(name, sizeof(name), "service.module%d", index);
+    ids[index] = logger_id_request(name);
+    (void)logger_id_enable(ids[index]);
+    (void)logger_id_level_set(ids[index], LOGGER_NOTICE);
+    (void)logger_id_output_function_register(ids[index], bench_outputs[index % BENCH_OUTPUTS]);
+    (void)logger_id_output_function_level_set(ids[index], bench_outputs[index % BENCH_OUTPUTS], LOGGER_DEBUG);
+  }
+
+  if (batch == logger_true) {
+    (void)logger_config_commit();
+  }
+
+  stop = bench_now();
+
+  /* tear down for the next round */
+  (void)logger_config_begin();
+
+  for (index = 0 ; index < BENCH_IDS ; index++) {
+    (void)logger_id_release(ids[index]);
+  }
+
+  for (index = 0 ; index < BENCH_OUTPUTS ; index++) {
+    (void)logger_output_function_deregister(bench_outputs[index]);
+  }
+
+  (void)logger_config_commit();
+
+  return(stop - start);
+}
+
+
+/***************************************************************************//**
+ * \brief  Print startup time with and without batched configuration.
+ ******************************************************************************/
+int main(int  argc, char *argv[])
+{
+  uint64_t single  = 0;
+  uint64_t batched = 0;
+  int      round;
+
+  (void)logger_init();
+
+  for (round = 0 ; round < BENCH_ROUNDS ; round++) {
+    single  += bench_startup(logger_false);
+    batched += bench_startup(logger_true);
+  }
+
+  printf("startup of %d IDs and %d outputs\n", BENCH_IDS, BENCH_OUTPUTS);
+  printf("  single changes:  %10.1f us\n", (double)single  / BENCH_ROUNDS / 1000.0);
+  printf("  batched changes: %10.1f us\n", (double)batched / BENCH_ROUNDS / 1000.0);
+
+  return(0);
+}
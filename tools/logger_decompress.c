@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ *     __
+ *    / /___  ____ _____ ____  _____
+ *   / / __ \/ __ `/ __ `/ _ \/ ___/
+ *  / / /_/ / /_/ / /_/ /  __/ /
+ * /_/\____/\__, /\__, /\___/_/
+ *         /____//____/
+ *
+ * \file   logger_decompress.c
+ *
+ * \brief  Decompress log files written by logger background compression.
+ * \author Markus Braun
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "logger.h"
+
+
+/***************************************************************************//**
+ * \brief  Decompress one stream and report errors.
+ *
+ * \param[in]     name    Name of stream for error messages.
+ * \param[in]     source  Stream of compressed data.
+ *
+ * \return        0 if no error occurred, 1 otherwise.
+ ******************************************************************************/
+static int decompress(const char *name,
+                      FILE       *source)
+{
+  logger_return_t ret = logger_decompress(source, stdout);
+
+  if (ret == LOGGER_ERR_DATA_INVALID) {
+    fprintf(stderr, "logger-decompress: %s: invalid or corrupted data\n", name);
+  }
+  else if (ret != LOGGER_OK) {
+    fprintf(stderr, "logger-decompress: %s: read or write error\n", name);
+  }
+
+  return((ret == LOGGER_OK) ? 0 : 1);
+}
+
+
+/***************************************************************************//**
+ * \brief  Decompress all given files to stdout.
+ *
+ * Without arguments or with "-" the compressed data is read from stdin.
+ ******************************************************************************/
+int main(int  argc, char *argv[])
+{
+  FILE *source;
+  int  ret = 0;
+  int  index;
+
+  if (argc < 2) {
+    return(decompress("-", stdin));
+  }
+
+  for (index = 1 ; index < argc ; index++) {
+    if (strcmp(argv[index], "-") == 0) {
+      ret |= decompress("-", stdin);
+      continue;
+    }
+
+    source = fopen(argv[index], "rb");
+
+    if (source == NULL) {
+      fprintf(stderr, "logger-decompress: %s: cannot open file\n", argv[index]);
+      ret = 1;
+      continue;
+    }
+
+    ret |= decompress(argv[index], source);
+    (void)fclose(source);
+  }
+
+  if (fflush(stdout) != 0) {
+    ret = 1;
+  }
+
+  return(ret);
+}
@@ -0,0 +1,50 @@
+/***************************************************************************//**
+ *     __
+ *    / /___  ____ _____ ____  _____
+ *   / / __ \/ __ `/ __ `/ _ \/ ___/
+ *  / / /_/ / /_/ / /_/ /  __/ /
+ * /_/\____/\__, /\__, /\___/_/
+ *         /____//____/
+ *
+ * \file   logger_recover.c
+ *
+ * \brief  Recover messages from a logger flight recorder file.
+ * \author Markus Braun
+ ******************************************************************************/
+#include <stdio.h>
+#include "logger.h"
+
+
+/***************************************************************************//**
+ * \brief  Write the recorded messages of all given files to stdout.
+ ******************************************************************************/
+int main(int  argc, char *argv[])
+{
+  logger_return_t ret;
+  int             status = 0;
+  int             index;
+
+  if (argc < 2) {
+    fprintf(stderr, "usage: logger-recover FILE...\n");
+    return(1);
+  }
+
+  for (index = 1 ; index < argc ; index++) {
+    ret = logger_output_recorder_recover(argv[index], stdout);
+
+    if (ret == LOGGER_ERR_DATA_INVALID) {
+      fprintf(stderr, "logger-recover: %s: not a flight recorder file\n", argv[index]);
+      status = 1;
+    }
+    else if (ret != LOGGER_OK) {
+      fprintf(stderr, "logger-recover: %s: cannot read file\n", argv[index]);
+      status = 1;
+    }
+  }
+
+  if (fflush(stdout) != 0) {
+    status = 1;
+  }
+
+  return(status);
+}